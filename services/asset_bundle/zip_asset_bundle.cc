@@ -0,0 +1,335 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/asset_bundle/zip_asset_bundle.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
+#include "base/bind.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/trace_event/trace_event.h"
+#include "third_party/zlib/zlib.h"
+
+namespace mojo {
+namespace asset_bundle {
+namespace {
+
+const uint32_t kEndOfCentralDirectorySignature = 0x06054b50;
+const uint32_t kCentralDirectoryHeaderSignature = 0x02014b50;
+const uint32_t kLocalFileHeaderSignature = 0x04034b50;
+
+const size_t kEndOfCentralDirectorySize = 22;
+const size_t kCentralDirectoryHeaderSize = 46;
+const size_t kLocalFileHeaderSize = 30;
+const size_t kMaxCommentSize = 0xFFFF;
+
+const uint16_t kMethodStored = 0;
+const uint16_t kMethodDeflated = 8;
+const uint16_t kFlagEncrypted = 1 << 0;
+
+// How long a worker waits for the consumer to make room in the pipe before
+// giving up on it, so that a reader that stalls can't hold a worker forever.
+const MojoDeadline kWriteDeadline = 30 * 1000 * 1000;
+
+uint16_t ReadUInt16(const uint8_t* p) {
+  return p[0] | (p[1] << 8);
+}
+
+uint32_t ReadUInt32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+
+}  // namespace
+
+// The worker tasks hold a reference so that the archive stays mapped until
+// they finish.
+class ZipAssetBundle::Archive : public base::RefCountedThreadSafe<Archive> {
+ public:
+  struct Entry {
+    uint16_t method;
+    uint32_t compressed_size;
+    uint32_t uncompressed_size;
+    uint32_t local_header_offset;
+  };
+
+  Archive() {}
+
+  bool Open(const base::FilePath& path) {
+    TRACE_EVENT0("asset_bundle", "ZipAssetBundle::Archive::Open");
+    if (!file_.Initialize(path))
+      return false;
+    return ReadCentralDirectory();
+  }
+
+  const Entry* Find(const std::string& name) const {
+    auto it = entries_.find(name);
+    return it == entries_.end() ? nullptr : &it->second;
+  }
+
+  // Returns the start of |entry|'s data, or null if its local header is
+  // malformed.
+  const uint8_t* DataFor(const Entry& entry) const {
+    const uint8_t* base = file_.data();
+    size_t length = file_.length();
+    size_t offset = entry.local_header_offset;
+    if (offset + kLocalFileHeaderSize > length)
+      return nullptr;
+    const uint8_t* header = base + offset;
+    if (ReadUInt32(header) != kLocalFileHeaderSignature)
+      return nullptr;
+    // The local header's name and extra field lengths can differ from the
+    // central directory's, so they have to be read from here.
+    size_t data_offset = offset + kLocalFileHeaderSize +
+                         ReadUInt16(header + 26) + ReadUInt16(header + 28);
+    if (data_offset > length || length - data_offset < entry.compressed_size)
+      return nullptr;
+    return base + data_offset;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Archive>;
+  ~Archive() {}
+
+  bool ReadCentralDirectory() {
+    const uint8_t* base = file_.data();
+    size_t length = file_.length();
+    if (length < kEndOfCentralDirectorySize)
+      return false;
+
+    // The end of central directory record is followed only by a comment of
+    // at most 64K, so search backwards for its signature from there.
+    size_t min_offset = length > kEndOfCentralDirectorySize + kMaxCommentSize
+                            ? length - kEndOfCentralDirectorySize -
+                                  kMaxCommentSize
+                            : 0;
+    size_t eocd = length - kEndOfCentralDirectorySize;
+    while (ReadUInt32(base + eocd) != kEndOfCentralDirectorySignature) {
+      if (eocd == min_offset)
+        return false;
+      --eocd;
+    }
+
+    uint16_t entry_count = ReadUInt16(base + eocd + 10);
+    size_t directory_size = ReadUInt32(base + eocd + 12);
+    size_t offset = ReadUInt32(base + eocd + 16);
+    if (offset + directory_size > eocd)
+      return false;
+
+    size_t end = offset + directory_size;
+    for (uint16_t i = 0; i < entry_count; ++i) {
+      if (offset + kCentralDirectoryHeaderSize > end)
+        return false;
+      const uint8_t* header = base + offset;
+      if (ReadUInt32(header) != kCentralDirectoryHeaderSignature)
+        return false;
+      uint16_t flags = ReadUInt16(header + 8);
+      size_t name_length = ReadUInt16(header + 28);
+      size_t next = offset + kCentralDirectoryHeaderSize + name_length +
+                    ReadUInt16(header + 30) + ReadUInt16(header + 32);
+      if (next > end)
+        return false;
+
+      Entry entry;
+      entry.method = ReadUInt16(header + 10);
+      entry.compressed_size = ReadUInt32(header + 20);
+      entry.uncompressed_size = ReadUInt32(header + 24);
+      entry.local_header_offset = ReadUInt32(header + 42);
+      std::string name(
+          reinterpret_cast<const char*>(header + kCentralDirectoryHeaderSize),
+          name_length);
+
+      // Skip directories and anything we can't serve. Zip64 archives mark
+      // their sizes and offsets with 0xFFFFFFFF.
+      bool supported =
+          !(flags & kFlagEncrypted) &&
+          (entry.method == kMethodStored || entry.method == kMethodDeflated) &&
+          entry.compressed_size != 0xFFFFFFFF &&
+          entry.uncompressed_size != 0xFFFFFFFF &&
+          entry.local_header_offset != 0xFFFFFFFF &&
+          (entry.method != kMethodStored ||
+           entry.compressed_size == entry.uncompressed_size);
+      if (supported && !name.empty() && name[name.size() - 1] != '/')
+        entries_[name] = entry;
+
+      offset = next;
+    }
+    return true;
+  }
+
+  base::MemoryMappedFile file_;
+  std::unordered_map<std::string, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(Archive);
+};
+
+namespace {
+
+// Waits until |producer| can take more data. Returns false if the consumer
+// went away, stopped reading for longer than kWriteDeadline or the pipe
+// failed.
+bool BeginWrite(const ScopedDataPipeProducerHandle& producer,
+                void** buffer,
+                uint32_t* buffer_num_bytes) {
+  for (;;) {
+    MojoResult result = BeginWriteDataRaw(producer.get(), buffer,
+                                          buffer_num_bytes,
+                                          MOJO_WRITE_DATA_FLAG_NONE);
+    if (result == MOJO_RESULT_OK)
+      return true;
+    if (result != MOJO_RESULT_SHOULD_WAIT) {
+      LOG(ERROR) << "Failed to write asset: " << result;
+      return false;
+    }
+    result = Wait(producer.get(), MOJO_HANDLE_SIGNAL_WRITABLE, kWriteDeadline,
+                  nullptr);
+    if (result == MOJO_RESULT_DEADLINE_EXCEEDED) {
+      LOG(ERROR) << "Gave up writing asset after the reader stalled";
+      return false;
+    }
+    if (result != MOJO_RESULT_OK) {
+      LOG(ERROR) << "Failed to write asset: " << result;
+      return false;
+    }
+  }
+}
+
+bool EndWrite(const ScopedDataPipeProducerHandle& producer,
+              uint32_t num_bytes_written) {
+  MojoResult result = EndWriteDataRaw(producer.get(), num_bytes_written);
+  if (result != MOJO_RESULT_OK) {
+    LOG(ERROR) << "Failed to write asset: " << result;
+    return false;
+  }
+  return true;
+}
+
+// Copies a stored entry from the mapping straight into the pipe's buffer.
+void WriteStored(scoped_refptr<ZipAssetBundle::Archive> archive,
+                 const uint8_t* data,
+                 size_t size,
+                 ScopedDataPipeProducerHandle producer) {
+  TRACE_EVENT1("asset_bundle", "ZipAssetBundle::WriteStored", "bytes", size);
+  while (size) {
+    void* buffer = nullptr;
+    uint32_t buffer_num_bytes = 0;
+    if (!BeginWrite(producer, &buffer, &buffer_num_bytes))
+      return;
+    uint32_t num_bytes =
+        static_cast<uint32_t>(std::min<size_t>(buffer_num_bytes, size));
+    memcpy(buffer, data, num_bytes);
+    if (!EndWrite(producer, num_bytes))
+      return;
+    data += num_bytes;
+    size -= num_bytes;
+  }
+}
+
+// Inflates a deflated entry from the mapping straight into the pipe's
+// buffer. The output is bounded by the size the central directory claims,
+// so a corrupt or hostile archive can't stream more than that.
+void WriteDeflated(scoped_refptr<ZipAssetBundle::Archive> archive,
+                   const uint8_t* data,
+                   size_t size,
+                   size_t uncompressed_size,
+                   ScopedDataPipeProducerHandle producer) {
+  TRACE_EVENT1("asset_bundle", "ZipAssetBundle::WriteDeflated", "bytes", size);
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  // Zip entries are raw deflate streams, without a zlib header.
+  if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+    return;
+  stream.next_in = const_cast<Bytef*>(data);
+  stream.avail_in = static_cast<uInt>(size);
+
+  size_t remaining = uncompressed_size;
+  for (;;) {
+    void* buffer = nullptr;
+    uint32_t buffer_num_bytes = 0;
+    if (!BeginWrite(producer, &buffer, &buffer_num_bytes))
+      break;
+    // Ask for one byte more than the entry should have left so that output
+    // past its end shows up as a short count rather than being missed.
+    uint32_t num_bytes = static_cast<uint32_t>(
+        std::min<size_t>(buffer_num_bytes, remaining + 1));
+    stream.next_out = static_cast<Bytef*>(buffer);
+    stream.avail_out = num_bytes;
+    int result = inflate(&stream, Z_NO_FLUSH);
+    uint32_t num_bytes_written = num_bytes - stream.avail_out;
+    if (num_bytes_written > remaining) {
+      EndWrite(producer, 0);
+      LOG(ERROR) << "Asset inflates to more than its declared "
+                 << uncompressed_size << " bytes";
+      break;
+    }
+    remaining -= num_bytes_written;
+    if (!EndWrite(producer, num_bytes_written))
+      break;
+    if (result == Z_STREAM_END) {
+      if (remaining) {
+        LOG(ERROR) << "Asset inflates to " << uncompressed_size - remaining
+                   << " bytes instead of its declared " << uncompressed_size;
+      }
+      break;
+    }
+    if (result != Z_OK) {
+      LOG(ERROR) << "Failed to inflate asset: " << result;
+      break;
+    }
+  }
+  inflateEnd(&stream);
+}
+
+}  // namespace
+
+ZipAssetBundle::ZipAssetBundle(InterfaceRequest<AssetBundle> request,
+                               const base::FilePath& zip_path,
+                               scoped_refptr<base::TaskRunner> worker_runner)
+    : binding_(this, request.Pass()),
+      archive_(new Archive()),
+      worker_runner_(worker_runner.Pass()) {
+  if (!archive_->Open(zip_path)) {
+    LOG(ERROR) << "Failed to open asset bundle " << zip_path.value();
+    archive_ = nullptr;
+  }
+}
+
+ZipAssetBundle::~ZipAssetBundle() {
+}
+
+void ZipAssetBundle::GetAsStream(
+    const String& asset_name,
+    const Callback<void(ScopedDataPipeConsumerHandle)>& callback) {
+  DataPipe pipe;
+  callback.Run(pipe.consumer_handle.Pass());
+
+  std::string asset_string = asset_name.To<std::string>();
+  const Archive::Entry* entry =
+      archive_ ? archive_->Find(asset_string) : nullptr;
+  const uint8_t* data = entry ? archive_->DataFor(*entry) : nullptr;
+  if (!data) {
+    LOG(WARNING) << "Requested asset '" << asset_string << "' does not exist.";
+    return;
+  }
+
+  if (entry->method == kMethodStored) {
+    worker_runner_->PostTask(
+        FROM_HERE, base::Bind(&WriteStored, archive_, data,
+                              entry->compressed_size,
+                              base::Passed(pipe.producer_handle.Pass())));
+  } else {
+    worker_runner_->PostTask(
+        FROM_HERE, base::Bind(&WriteDeflated, archive_, data,
+                              entry->compressed_size, entry->uncompressed_size,
+                              base::Passed(pipe.producer_handle.Pass())));
+  }
+}
+
+}  // namespace asset_bundle
+}  // namespace mojo
@@ -0,0 +1,51 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SERVICES_ASSET_BUNDLE_ZIP_ASSET_BUNDLE_H_
+#define SERVICES_ASSET_BUNDLE_ZIP_ASSET_BUNDLE_H_
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/task_runner.h"
+#include "mojo/public/cpp/bindings/interface_request.h"
+#include "mojo/public/cpp/bindings/strong_binding.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/services/asset_bundle/public/interfaces/asset_bundle.mojom.h"
+
+namespace mojo {
+namespace asset_bundle {
+
+// Serves assets directly out of a zip archive on disk. Unlike
+// AssetUnpackerJob, nothing is extracted up front: the archive is mapped
+// into memory, its central directory is indexed once, and each asset is
+// read out of the mapping when it is requested. Deflated assets are inflated
+// on |worker_runner| as they are streamed.
+class ZipAssetBundle : public AssetBundle {
+ public:
+  ZipAssetBundle(InterfaceRequest<AssetBundle> request,
+                 const base::FilePath& zip_path,
+                 scoped_refptr<base::TaskRunner> worker_runner);
+  ~ZipAssetBundle() override;
+
+  // The mapped archive, shared with the tasks that stream assets out of it.
+  class Archive;
+
+  // AssetBundle implementation
+  void GetAsStream(
+      const String& asset_name,
+      const Callback<void(ScopedDataPipeConsumerHandle)>& callback) override;
+
+ private:
+  StrongBinding<AssetBundle> binding_;
+  scoped_refptr<Archive> archive_;
+  scoped_refptr<base::TaskRunner> worker_runner_;
+
+  DISALLOW_COPY_AND_ASSIGN(ZipAssetBundle);
+};
+
+}  // namespace asset_bundle
+}  // namespace mojo
+
+#endif  // SERVICES_ASSET_BUNDLE_ZIP_ASSET_BUNDLE_H_
@@ -0,0 +1,238 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/asset_bundle/zip_asset_bundle.h"
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/thread.h"
+#include "mojo/common/data_pipe_utils.h"
+#include "mojo/public/cpp/application/application_test_base.h"
+#include "mojo/public/cpp/utility/run_loop.h"
+#include "third_party/zlib/zlib.h"
+
+namespace asset_bundle {
+namespace {
+
+struct ZipEntry {
+  std::string name;
+  uint16_t method;
+  std::string data;
+  // The size to record in the central directory.
+  uint32_t uncompressed_size;
+};
+
+void AppendUInt16(std::string* out, uint16_t value) {
+  out->push_back(static_cast<char>(value & 0xFF));
+  out->push_back(static_cast<char>(value >> 8));
+}
+
+void AppendUInt32(std::string* out, uint32_t value) {
+  AppendUInt16(out, static_cast<uint16_t>(value & 0xFFFF));
+  AppendUInt16(out, static_cast<uint16_t>(value >> 16));
+}
+
+// Returns |data| as a raw deflate stream, the way zip stores it.
+std::string Deflate(const std::string& data) {
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  EXPECT_EQ(Z_OK, deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED,
+                               -MAX_WBITS, 8, Z_DEFAULT_STRATEGY));
+  std::string out(deflateBound(&stream, data.size()), '\0');
+  stream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = data.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+  stream.avail_out = out.size();
+  EXPECT_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+  return out;
+}
+
+ZipEntry Stored(const std::string& name, const std::string& data) {
+  ZipEntry entry = {name, 0, data, static_cast<uint32_t>(data.size())};
+  return entry;
+}
+
+ZipEntry Deflated(const std::string& name, const std::string& data) {
+  ZipEntry entry = {name, 8, Deflate(data),
+                    static_cast<uint32_t>(data.size())};
+  return entry;
+}
+
+// Builds a zip archive by hand so that tests control exactly what the
+// central directory says about each entry.
+std::string MakeZip(const std::vector<ZipEntry>& entries) {
+  std::string zip;
+  std::string directory;
+  for (const ZipEntry& entry : entries) {
+    uint32_t offset = zip.size();
+    uint32_t crc = crc32(0, reinterpret_cast<const Bytef*>(entry.data.data()),
+                         entry.data.size());
+
+    AppendUInt32(&zip, 0x04034b50);
+    AppendUInt16(&zip, 20);  // Version needed.
+    AppendUInt16(&zip, 0);   // Flags.
+    AppendUInt16(&zip, entry.method);
+    AppendUInt32(&zip, 0);  // Modification time and date.
+    AppendUInt32(&zip, crc);
+    AppendUInt32(&zip, entry.data.size());
+    AppendUInt32(&zip, entry.uncompressed_size);
+    AppendUInt16(&zip, entry.name.size());
+    AppendUInt16(&zip, 0);  // Extra field length.
+    zip += entry.name;
+    zip += entry.data;
+
+    AppendUInt32(&directory, 0x02014b50);
+    AppendUInt16(&directory, 20);  // Version made by.
+    AppendUInt16(&directory, 20);  // Version needed.
+    AppendUInt16(&directory, 0);   // Flags.
+    AppendUInt16(&directory, entry.method);
+    AppendUInt32(&directory, 0);  // Modification time and date.
+    AppendUInt32(&directory, crc);
+    AppendUInt32(&directory, entry.data.size());
+    AppendUInt32(&directory, entry.uncompressed_size);
+    AppendUInt16(&directory, entry.name.size());
+    AppendUInt16(&directory, 0);  // Extra field length.
+    AppendUInt16(&directory, 0);  // Comment length.
+    AppendUInt16(&directory, 0);  // Disk number.
+    AppendUInt16(&directory, 0);  // Internal attributes.
+    AppendUInt32(&directory, 0);  // External attributes.
+    AppendUInt32(&directory, offset);
+    directory += entry.name;
+  }
+
+  uint32_t directory_offset = zip.size();
+  zip += directory;
+  AppendUInt32(&zip, 0x06054b50);
+  AppendUInt16(&zip, 0);  // Disk number.
+  AppendUInt16(&zip, 0);  // Disk with the central directory.
+  AppendUInt16(&zip, entries.size());
+  AppendUInt16(&zip, entries.size());
+  AppendUInt32(&zip, directory.size());
+  AppendUInt32(&zip, directory_offset);
+  AppendUInt16(&zip, 0);  // Comment length.
+  return zip;
+}
+
+// Text that compresses well but is still larger than a data pipe's default
+// capacity, so the worker has to wait for the reader.
+std::string LargeText() {
+  std::string text;
+  for (int i = 0; text.size() < 3 * 1024 * 1024; ++i)
+    text += "line " + base::IntToString(i) + "\n";
+  return text;
+}
+
+class ZipAssetBundleAppTest : public mojo::test::ApplicationTestBase {
+ public:
+  ZipAssetBundleAppTest() : worker_("zip_asset_bundle_worker") {}
+  ~ZipAssetBundleAppTest() override {}
+
+  void SetUp() override {
+    mojo::test::ApplicationTestBase::SetUp();
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    ASSERT_TRUE(worker_.Start());
+  }
+
+  void TearDown() override {
+    // Closing the pipe deletes the bundle once its binding notices.
+    bundle_ptr_.reset();
+    mojo::RunLoop::current()->RunUntilIdle();
+    worker_.Stop();
+    mojo::test::ApplicationTestBase::TearDown();
+  }
+
+ protected:
+  void OpenBundle(const std::vector<ZipEntry>& entries) {
+    std::string zip = MakeZip(entries);
+    base::FilePath path = temp_dir_.path().Append("bundle.zip");
+    ASSERT_EQ(static_cast<int>(zip.size()),
+              base::WriteFile(path, zip.data(), zip.size()));
+    // Owned by its binding to |bundle_ptr_|.
+    bundle_ = new mojo::asset_bundle::ZipAssetBundle(
+        mojo::GetProxy(&bundle_ptr_), path, worker_.task_runner());
+  }
+
+  // Calls the bundle directly, since it runs on this thread and so can't
+  // answer a message while the test waits for the reply.
+  std::string ReadAsset(const std::string& name) {
+    mojo::ScopedDataPipeConsumerHandle pipe;
+    bundle_->GetAsStream(name, [&pipe](mojo::ScopedDataPipeConsumerHandle p) {
+      pipe = p.Pass();
+    });
+    std::string content;
+    EXPECT_TRUE(pipe.is_valid());
+    mojo::common::BlockingCopyToString(pipe.Pass(), &content);
+    return content;
+  }
+
+ private:
+  base::ScopedTempDir temp_dir_;
+  base::Thread worker_;
+  mojo::asset_bundle::AssetBundlePtr bundle_ptr_;
+  mojo::asset_bundle::ZipAssetBundle* bundle_;
+
+  DISALLOW_COPY_AND_ASSIGN(ZipAssetBundleAppTest);
+};
+
+TEST_F(ZipAssetBundleAppTest, ReadsStoredAndDeflatedEntries) {
+  std::vector<ZipEntry> entries;
+  entries.push_back(Stored("stored.txt", "Some stored data"));
+  entries.push_back(Deflated("deflated.txt", "Some deflated data"));
+  entries.push_back(Stored("empty.txt", ""));
+  OpenBundle(entries);
+
+  EXPECT_EQ("Some stored data", ReadAsset("stored.txt"));
+  EXPECT_EQ("Some deflated data", ReadAsset("deflated.txt"));
+  EXPECT_EQ("", ReadAsset("empty.txt"));
+  EXPECT_EQ("", ReadAsset("missing.txt"));
+}
+
+TEST_F(ZipAssetBundleAppTest, StreamsEntriesLargerThanThePipe) {
+  std::string text = LargeText();
+  std::vector<ZipEntry> entries;
+  entries.push_back(Stored("stored.txt", text));
+  entries.push_back(Deflated("deflated.txt", text));
+  OpenBundle(entries);
+
+  EXPECT_TRUE(text == ReadAsset("stored.txt"));
+  EXPECT_TRUE(text == ReadAsset("deflated.txt"));
+}
+
+TEST_F(ZipAssetBundleAppTest, StopsInflatingAtTheDeclaredSize) {
+  std::string text = LargeText();
+  std::vector<ZipEntry> entries;
+  ZipEntry small = Deflated("small.txt", "This inflates to more than 8 bytes");
+  small.uncompressed_size = 8;
+  entries.push_back(small);
+  ZipEntry large = Deflated("large.txt", text);
+  large.uncompressed_size = 1024;
+  entries.push_back(large);
+  OpenBundle(entries);
+
+  EXPECT_GE(8u, ReadAsset("small.txt").size());
+  EXPECT_GE(1024u, ReadAsset("large.txt").size());
+}
+
+TEST_F(ZipAssetBundleAppTest, SkipsStoredEntriesWithMismatchedSizes) {
+  std::vector<ZipEntry> entries;
+  ZipEntry entry = Stored("stored.txt", "Some stored data");
+  entry.uncompressed_size = 1024 * 1024;
+  entries.push_back(entry);
+  OpenBundle(entries);
+
+  EXPECT_EQ("", ReadAsset("stored.txt"));
+}
+
+}  // namespace
+}  // namespace asset_bundle
@@ -0,0 +1,34 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/compositor/clip_rect_layer.h"
+
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace sky {
+namespace compositor {
+
+ClipRectLayer::ClipRectLayer() : clip_rect_(SkRect::MakeEmpty()) {
+}
+
+ClipRectLayer::~ClipRectLayer() {
+}
+
+void ClipRectLayer::Preroll(PaintContext::ScopedFrame& frame,
+                            const SkMatrix& matrix) {
+  SkRect child_paint_bounds = PrerollChildren(frame, matrix);
+  if (!child_paint_bounds.intersect(clip_rect_))
+    child_paint_bounds.setEmpty();
+  set_paint_bounds(child_paint_bounds);
+}
+
+void ClipRectLayer::Paint(PaintContext::ScopedFrame& frame) {
+  SkCanvas& canvas = frame.canvas();
+  SkAutoCanvasRestore save(&canvas, true);
+  canvas.clipRect(clip_rect_);
+  PaintChildren(frame);
+}
+
+}  // namespace compositor
+}  // namespace sky
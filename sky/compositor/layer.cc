@@ -0,0 +1,20 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/compositor/layer.h"
+
+namespace sky {
+namespace compositor {
+
+Layer::Layer() : parent_(nullptr), paint_bounds_(SkRect::MakeEmpty()) {
+}
+
+Layer::~Layer() {
+}
+
+void Layer::Preroll(PaintContext::ScopedFrame& frame, const SkMatrix& matrix) {
+}
+
+}  // namespace compositor
+}  // namespace sky
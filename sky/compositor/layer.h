@@ -0,0 +1,56 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_COMPOSITOR_LAYER_H_
+#define SKY_COMPOSITOR_LAYER_H_
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "sky/compositor/paint_context.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace sky {
+namespace compositor {
+class ContainerLayer;
+
+// A node in the retained layer tree that the UI thread hands to the GPU
+// thread each frame. Layers are immutable once the tree has been built, apart
+// from the state Preroll computes for the following Paint on the GPU thread,
+// and the same tree can be drawn in many frames.
+class Layer {
+ public:
+  Layer();
+  virtual ~Layer();
+
+  // Called once per frame before Paint. |matrix| is the transform from this
+  // layer's coordinate space to the surface. Containers use this pass to
+  // compute their paint bounds and picture layers to look up cached rasters.
+  virtual void Preroll(PaintContext::ScopedFrame& frame,
+                       const SkMatrix& matrix);
+
+  virtual void Paint(PaintContext::ScopedFrame& frame) = 0;
+
+  ContainerLayer* parent() const { return parent_; }
+  void set_parent(ContainerLayer* parent) { parent_ = parent; }
+
+  // The bounds of everything this layer draws, in its parent's coordinates.
+  const SkRect& paint_bounds() const { return paint_bounds_; }
+  void set_paint_bounds(const SkRect& paint_bounds) {
+    paint_bounds_ = paint_bounds;
+  }
+
+ private:
+  ContainerLayer* parent_;
+  SkRect paint_bounds_;
+
+  DISALLOW_COPY_AND_ASSIGN(Layer);
+};
+
+}  // namespace compositor
+}  // namespace sky
+
+#endif  // SKY_COMPOSITOR_LAYER_H_
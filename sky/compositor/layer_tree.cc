@@ -0,0 +1,39 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/compositor/layer_tree.h"
+
+#include "base/trace_event/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace sky {
+namespace compositor {
+
+LayerTree::LayerTree() : frame_size_(SkISize::Make(0, 0)) {
+  root_transform_.reset();
+}
+
+LayerTree::~LayerTree() {
+}
+
+void LayerTree::Raster(PaintContext::ScopedFrame& frame) {
+  if (!root_layer_)
+    return;
+
+  {
+    TRACE_EVENT0("sky", "LayerTree::Preroll");
+    root_layer_->Preroll(frame, root_transform_);
+  }
+
+  {
+    TRACE_EVENT0("sky", "LayerTree::Paint");
+    SkCanvas& canvas = frame.canvas();
+    SkAutoCanvasRestore save(&canvas, true);
+    canvas.concat(root_transform_);
+    root_layer_->Paint(frame);
+  }
+}
+
+}  // namespace compositor
+}  // namespace sky
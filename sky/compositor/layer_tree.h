@@ -0,0 +1,55 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_COMPOSITOR_LAYER_TREE_H_
+#define SKY_COMPOSITOR_LAYER_TREE_H_
+
+#include <memory>
+
+#include "base/macros.h"
+#include "sky/compositor/layer.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace sky {
+namespace compositor {
+
+// A frame's worth of layers, built on the UI thread and rasterized on the GPU
+// thread.
+class LayerTree {
+ public:
+  LayerTree();
+  ~LayerTree();
+
+  // A scene can be drawn in any number of frames, so its layers are shared
+  // between the trees of those frames.
+  Layer* root_layer() const { return root_layer_.get(); }
+  void set_root_layer(std::shared_ptr<Layer> root_layer) {
+    root_layer_ = std::move(root_layer);
+  }
+
+  // Maps the root layer's coordinates to physical pixels.
+  const SkMatrix& root_transform() const { return root_transform_; }
+  void set_root_transform(const SkMatrix& root_transform) {
+    root_transform_ = root_transform;
+  }
+
+  // The size of the frame in physical pixels.
+  const SkISize& frame_size() const { return frame_size_; }
+  void set_frame_size(const SkISize& frame_size) { frame_size_ = frame_size; }
+
+  void Raster(PaintContext::ScopedFrame& frame);
+
+ private:
+  std::shared_ptr<Layer> root_layer_;
+  SkMatrix root_transform_;
+  SkISize frame_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(LayerTree);
+};
+
+}  // namespace compositor
+}  // namespace sky
+
+#endif  // SKY_COMPOSITOR_LAYER_TREE_H_
@@ -0,0 +1,102 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/compositor/layer_tree.h"
+
+#include "sky/compositor/container_layer.h"
+#include "sky/compositor/picture_layer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace sky {
+namespace compositor {
+namespace {
+
+const int kFrameSize = 200;
+
+// A picture that is expensive enough to cache, with a red square in its top
+// left quarter.
+skia::RefPtr<SkPicture> RecordPicture() {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  for (int i = 0; i < 20; ++i)
+    canvas->drawRect(SkRect::MakeWH(50, 50), paint);
+  return skia::AdoptRef(recorder.endRecording());
+}
+
+std::shared_ptr<Layer> BuildScene() {
+  std::unique_ptr<PictureLayer> picture_layer(new PictureLayer());
+  picture_layer->set_offset(SkPoint::Make(10, 10));
+  picture_layer->set_picture(RecordPicture());
+  std::unique_ptr<ContainerLayer> root(new ContainerLayer());
+  root->Add(std::move(picture_layer));
+  return std::move(root);
+}
+
+class LayerTreeTest : public testing::Test {
+ protected:
+  LayerTreeTest() { bitmap_.allocN32Pixels(kFrameSize, kFrameSize); }
+
+  // Draws |root| as one frame at a device pixel ratio of 2.
+  PaintContext::FrameStats DrawFrame(std::shared_ptr<Layer> root) {
+    bitmap_.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(bitmap_);
+    LayerTree layer_tree;
+    layer_tree.set_frame_size(SkISize::Make(kFrameSize, kFrameSize));
+    layer_tree.set_root_transform(SkMatrix::MakeScale(2, 2));
+    layer_tree.set_root_layer(std::move(root));
+    PaintContext::ScopedFrame frame(context_, nullptr, canvas);
+    layer_tree.Raster(frame);
+    return frame.stats();
+  }
+
+  void ExpectPictureDrawn() {
+    // The square covers (10, 10) to (60, 60), scaled by 2.
+    EXPECT_EQ(SK_ColorRED, bitmap_.getColor(21, 21));
+    EXPECT_EQ(SK_ColorRED, bitmap_.getColor(118, 118));
+    EXPECT_EQ(SK_ColorTRANSPARENT, bitmap_.getColor(19, 19));
+    EXPECT_EQ(SK_ColorTRANSPARENT, bitmap_.getColor(121, 121));
+  }
+
+  PaintContext context_;
+  SkBitmap bitmap_;
+};
+
+TEST_F(LayerTreeTest, RetainedSceneHitsRasterCache) {
+  std::shared_ptr<Layer> scene = BuildScene();
+
+  for (int i = 0; i < 2; ++i) {
+    PaintContext::FrameStats stats = DrawFrame(scene);
+    EXPECT_EQ(1, stats.picture_count);
+    EXPECT_EQ(0, stats.cached_picture_count);
+    EXPECT_LT(0, stats.picture_op_count);
+    ExpectPictureDrawn();
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    PaintContext::FrameStats stats = DrawFrame(scene);
+    EXPECT_EQ(1, stats.picture_count);
+    EXPECT_EQ(1, stats.cached_picture_count);
+    EXPECT_EQ(0, stats.picture_op_count);
+    ExpectPictureDrawn();
+  }
+  EXPECT_LT(0u, context_.raster_cache().image_bytes());
+}
+
+TEST_F(LayerTreeTest, RerecordedSceneMissesRasterCache) {
+  for (int i = 0; i < 5; ++i) {
+    PaintContext::FrameStats stats = DrawFrame(BuildScene());
+    EXPECT_EQ(0, stats.cached_picture_count);
+    ExpectPictureDrawn();
+  }
+}
+
+}  // namespace
+}  // namespace compositor
+}  // namespace sky
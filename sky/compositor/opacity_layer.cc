@@ -0,0 +1,33 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/compositor/opacity_layer.h"
+
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace sky {
+namespace compositor {
+
+OpacityLayer::OpacityLayer() : alpha_(0xFF) {
+}
+
+OpacityLayer::~OpacityLayer() {
+}
+
+void OpacityLayer::Paint(PaintContext::ScopedFrame& frame) {
+  if (!alpha_)
+    return;
+  if (alpha_ == 0xFF) {
+    PaintChildren(frame);
+    return;
+  }
+
+  SkCanvas& canvas = frame.canvas();
+  canvas.saveLayerAlpha(&paint_bounds(), alpha_);
+  PaintChildren(frame);
+  canvas.restore();
+}
+
+}  // namespace compositor
+}  // namespace sky
@@ -0,0 +1,32 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_COMPOSITOR_OPACITY_LAYER_H_
+#define SKY_COMPOSITOR_OPACITY_LAYER_H_
+
+#include "sky/compositor/container_layer.h"
+#include "third_party/skia/include/core/SkColor.h"
+
+namespace sky {
+namespace compositor {
+
+class OpacityLayer : public ContainerLayer {
+ public:
+  OpacityLayer();
+  ~OpacityLayer() override;
+
+  void set_alpha(U8CPU alpha) { alpha_ = alpha; }
+
+  void Paint(PaintContext::ScopedFrame& frame) override;
+
+ private:
+  U8CPU alpha_;
+
+  DISALLOW_COPY_AND_ASSIGN(OpacityLayer);
+};
+
+}  // namespace compositor
+}  // namespace sky
+
+#endif  // SKY_COMPOSITOR_OPACITY_LAYER_H_
@@ -0,0 +1,43 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/compositor/paint_context.h"
+
+#include "base/trace_event/trace_event.h"
+
+namespace sky {
+namespace compositor {
+
+PaintContext::FrameStats::FrameStats()
+    : picture_count(0), cached_picture_count(0), picture_op_count(0) {
+}
+
+PaintContext::ScopedFrame::ScopedFrame(PaintContext& context,
+                                       GrContext* gr_context,
+                                       SkCanvas& canvas)
+    : context_(context), gr_context_(gr_context), canvas_(canvas) {
+  context_.BeginFrame();
+}
+
+PaintContext::ScopedFrame::~ScopedFrame() {
+  context_.EndFrame();
+}
+
+PaintContext::PaintContext() {
+}
+
+PaintContext::~PaintContext() {
+}
+
+void PaintContext::BeginFrame() {
+  TRACE_EVENT0("sky", "PaintContext::BeginFrame");
+}
+
+void PaintContext::EndFrame() {
+  TRACE_EVENT0("sky", "PaintContext::EndFrame");
+  raster_cache_.SweepAfterFrame();
+}
+
+}  // namespace compositor
+}  // namespace sky
@@ -0,0 +1,69 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_COMPOSITOR_PAINT_CONTEXT_H_
+#define SKY_COMPOSITOR_PAINT_CONTEXT_H_
+
+#include "base/macros.h"
+#include "sky/compositor/raster_cache.h"
+
+class GrContext;
+class SkCanvas;
+
+namespace sky {
+namespace compositor {
+
+// State that outlives individual frames on the GPU thread.
+class PaintContext {
+ public:
+  // What a frame drew.
+  struct FrameStats {
+    FrameStats();
+
+    int picture_count;
+    // Pictures drawn from the raster cache instead of being replayed.
+    int cached_picture_count;
+    // The approximate number of operations in the replayed pictures.
+    int picture_op_count;
+  };
+
+  // State for painting one frame. Ends the frame on the paint context when
+  // it goes out of scope.
+  class ScopedFrame {
+   public:
+    ScopedFrame(PaintContext& context, GrContext* gr_context, SkCanvas& canvas);
+    ~ScopedFrame();
+
+    PaintContext& context() const { return context_; }
+    GrContext* gr_context() const { return gr_context_; }
+    SkCanvas& canvas() const { return canvas_; }
+    FrameStats& stats() { return stats_; }
+
+   private:
+    PaintContext& context_;
+    GrContext* gr_context_;
+    SkCanvas& canvas_;
+    FrameStats stats_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedFrame);
+  };
+
+  PaintContext();
+  ~PaintContext();
+
+  RasterCache& raster_cache() { return raster_cache_; }
+
+ private:
+  void BeginFrame();
+  void EndFrame();
+
+  RasterCache raster_cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(PaintContext);
+};
+
+}  // namespace compositor
+}  // namespace sky
+
+#endif  // SKY_COMPOSITOR_PAINT_CONTEXT_H_
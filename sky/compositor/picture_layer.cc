@@ -0,0 +1,65 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/compositor/picture_layer.h"
+
+#include "base/logging.h"
+#include "base/trace_event/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace sky {
+namespace compositor {
+
+PictureLayer::PictureLayer() : offset_(SkPoint::Make(0, 0)) {
+  image_scale_.setEmpty();
+}
+
+PictureLayer::~PictureLayer() {
+}
+
+void PictureLayer::set_picture(skia::RefPtr<SkPicture> picture) {
+  picture_ = picture;
+}
+
+void PictureLayer::Preroll(PaintContext::ScopedFrame& frame,
+                           const SkMatrix& matrix) {
+  DCHECK(picture_);
+  set_paint_bounds(picture_->cullRect().makeOffset(offset_.x(), offset_.y()));
+
+  SkMatrix ctm = matrix;
+  ctm.preTranslate(offset_.x(), offset_.y());
+  image_ = frame.context().raster_cache().GetPrerolledImage(
+      frame.gr_context(), picture_.get(), ctm);
+  image_scale_ = SkSize::Make(ctm.getScaleX(), ctm.getScaleY());
+}
+
+void PictureLayer::Paint(PaintContext::ScopedFrame& frame) {
+  DCHECK(picture_);
+  SkCanvas& canvas = frame.canvas();
+  SkAutoCanvasRestore save(&canvas, true);
+  canvas.translate(offset_.x(), offset_.y());
+
+  PaintContext::FrameStats& stats = frame.stats();
+  ++stats.picture_count;
+  if (!image_) {
+    stats.picture_op_count += picture_->approximateOpCount();
+    canvas.drawPicture(picture_.get());
+    return;
+  }
+  ++stats.cached_picture_count;
+
+  // The cached raster is in device pixels, so undo the scale when drawing it.
+  TRACE_EVENT0("sky", "PictureLayer::Paint cached");
+  const SkRect& cull_rect = picture_->cullRect();
+  canvas.translate(cull_rect.left(), cull_rect.top());
+  canvas.scale(SkScalarInvert(image_scale_.width()),
+               SkScalarInvert(image_scale_.height()));
+  canvas.drawImage(image_.get(), 0, 0);
+  // The texture belongs to the raster cache. Don't keep it alive from a layer
+  // that the UI thread might release.
+  image_.clear();
+}
+
+}  // namespace compositor
+}  // namespace sky
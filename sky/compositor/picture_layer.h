@@ -0,0 +1,44 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_COMPOSITOR_PICTURE_LAYER_H_
+#define SKY_COMPOSITOR_PICTURE_LAYER_H_
+
+#include "skia/ext/refptr.h"
+#include "sky/compositor/layer.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPicture.h"
+
+namespace sky {
+namespace compositor {
+
+class PictureLayer : public Layer {
+ public:
+  PictureLayer();
+  ~PictureLayer() override;
+
+  void set_offset(const SkPoint& offset) { offset_ = offset; }
+  void set_picture(skia::RefPtr<SkPicture> picture);
+
+  SkPicture* picture() const { return picture_.get(); }
+
+  void Preroll(PaintContext::ScopedFrame& frame,
+               const SkMatrix& matrix) override;
+  void Paint(PaintContext::ScopedFrame& frame) override;
+
+ private:
+  SkPoint offset_;
+  skia::RefPtr<SkPicture> picture_;
+
+  // The raster of |picture_| from the raster cache for this frame, if any.
+  skia::RefPtr<SkImage> image_;
+  SkSize image_scale_;
+
+  DISALLOW_COPY_AND_ASSIGN(PictureLayer);
+};
+
+}  // namespace compositor
+}  // namespace sky
+
+#endif  // SKY_COMPOSITOR_PICTURE_LAYER_H_
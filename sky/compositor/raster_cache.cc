@@ -0,0 +1,209 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/compositor/raster_cache.h"
+
+#include "base/logging.h"
+#include "base/trace_event/trace_event.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+namespace sky {
+namespace compositor {
+namespace {
+
+// A picture has to be drawn unchanged in this many frames before we spend the
+// time and memory to rasterize it.
+const int kRasterThreshold = 3;
+
+// Pictures with fewer operations than this are about as cheap to replay as a
+// texture is to draw, unless they contain a saveLayer.
+const int kMinOpCount = 10;
+
+// Don't cache pictures that would need textures larger than this in either
+// dimension.
+const int kMaxRasterDimension = 2048;
+
+// The most memory the cached rasters may use between them.
+const size_t kMaxRasterBytes = 32 * 1024 * 1024;
+
+bool CanRasterizeWithMatrix(const SkMatrix& ctm) {
+  // Rotations, skews and perspective would need the raster to be resampled.
+  return !(ctm.getType() &
+           ~(SkMatrix::kScale_Mask | SkMatrix::kTranslate_Mask));
+}
+
+// Plays a picture back without drawing anything to find out whether it
+// contains a saveLayer, which makes every replay allocate an offscreen.
+class SaveLayerDetector : public SkCanvas {
+ public:
+  explicit SaveLayerDetector(const SkRect& bounds)
+      : SkCanvas(SkScalarCeilToInt(bounds.right()),
+                 SkScalarCeilToInt(bounds.bottom())),
+        found_(false) {}
+
+  bool found() const { return found_; }
+
+ protected:
+  SaveLayerStrategy willSaveLayer(const SkRect* bounds,
+                                  const SkPaint* paint,
+                                  SaveFlags flags) override {
+    found_ = true;
+    return kNoLayer_SaveLayerStrategy;
+  }
+
+ private:
+  bool found_;
+
+  DISALLOW_COPY_AND_ASSIGN(SaveLayerDetector);
+};
+
+bool IsWorthRasterizing(SkPicture* picture) {
+  TRACE_EVENT0("sky", "RasterCache::IsWorthRasterizing");
+  if (picture->approximateOpCount() >= kMinOpCount)
+    return true;
+  SaveLayerDetector detector(picture->cullRect());
+  picture->playback(&detector);
+  return detector.found();
+}
+
+SkISize PhysicalSize(SkPicture* picture, const SkSize& scale) {
+  const SkRect& cull_rect = picture->cullRect();
+  return SkISize::Make(SkScalarCeilToInt(cull_rect.width() * scale.width()),
+                       SkScalarCeilToInt(cull_rect.height() * scale.height()));
+}
+
+size_t ImageBytes(const SkISize& size) {
+  return static_cast<size_t>(size.width()) * size.height() * 4;
+}
+
+skia::RefPtr<SkImage> RasterizePicture(GrContext* context,
+                                       SkPicture* picture,
+                                       const SkSize& scale,
+                                       const SkISize& physical_size) {
+  TRACE_EVENT0("sky", "RasterCache::RasterizePicture");
+
+  SkImageInfo info = SkImageInfo::MakeN32Premul(physical_size);
+  skia::RefPtr<SkSurface> surface = skia::AdoptRef(
+      context ? SkSurface::NewRenderTarget(context, SkSurface::kYes_Budgeted,
+                                           info, 0)
+              : SkSurface::NewRaster(info));
+  if (!surface)
+    return skia::RefPtr<SkImage>();
+
+  const SkRect& cull_rect = picture->cullRect();
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->clear(SK_ColorTRANSPARENT);
+  canvas->scale(scale.width(), scale.height());
+  canvas->translate(-cull_rect.left(), -cull_rect.top());
+  canvas->drawPicture(picture);
+
+  return skia::AdoptRef(surface->newImageSnapshot());
+}
+
+}  // namespace
+
+RasterCache::Entry::Entry()
+    : used_this_frame(false),
+      access_count(0),
+      analyzed(false),
+      worth_rasterizing(false),
+      raster_failed(false),
+      image_bytes(0) {
+  scale.setEmpty();
+}
+
+RasterCache::Entry::~Entry() {
+}
+
+RasterCache::RasterCache() : image_bytes_(0) {
+}
+
+RasterCache::~RasterCache() {
+}
+
+skia::RefPtr<SkImage> RasterCache::GetPrerolledImage(GrContext* context,
+                                                     SkPicture* picture,
+                                                     const SkMatrix& ctm) {
+  if (!CanRasterizeWithMatrix(ctm))
+    return skia::RefPtr<SkImage>();
+
+  SkSize scale = SkSize::Make(ctm.getScaleX(), ctm.getScaleY());
+
+  Entry& entry = cache_[picture->uniqueID()];
+  entry.used_this_frame = true;
+  if (entry.scale != scale) {
+    entry.access_count = 0;
+    entry.scale = scale;
+    entry.raster_failed = false;
+    DropImage(entry);
+  }
+
+  if (entry.access_count < kRasterThreshold) {
+    ++entry.access_count;
+    if (entry.access_count < kRasterThreshold)
+      return skia::RefPtr<SkImage>();
+  }
+
+  if (entry.image)
+    return entry.image;
+
+  if (!entry.analyzed) {
+    entry.analyzed = true;
+    entry.worth_rasterizing = IsWorthRasterizing(picture);
+  }
+  if (!entry.worth_rasterizing || entry.raster_failed)
+    return skia::RefPtr<SkImage>();
+
+  SkISize physical_size = PhysicalSize(picture, scale);
+  if (physical_size.isEmpty() ||
+      physical_size.width() > kMaxRasterDimension ||
+      physical_size.height() > kMaxRasterDimension)
+    return skia::RefPtr<SkImage>();
+
+  // Over budget, keep replaying the picture until the textures of pictures
+  // that are no longer drawn have been swept.
+  size_t bytes = ImageBytes(physical_size);
+  if (image_bytes_ + bytes > kMaxRasterBytes)
+    return skia::RefPtr<SkImage>();
+
+  entry.image = RasterizePicture(context, picture, scale, physical_size);
+  if (!entry.image) {
+    entry.raster_failed = true;
+    return skia::RefPtr<SkImage>();
+  }
+  entry.image_bytes = bytes;
+  image_bytes_ += bytes;
+  return entry.image;
+}
+
+void RasterCache::SweepAfterFrame() {
+  for (auto it = cache_.begin(); it != cache_.end();) {
+    Entry& entry = it->second;
+    if (!entry.used_this_frame) {
+      DropImage(entry);
+      it = cache_.erase(it);
+    } else {
+      entry.used_this_frame = false;
+      ++it;
+    }
+  }
+  TRACE_COUNTER1("sky", "RasterCache::image_bytes", image_bytes_);
+}
+
+void RasterCache::Clear() {
+  cache_.clear();
+  image_bytes_ = 0;
+}
+
+void RasterCache::DropImage(Entry& entry) {
+  DCHECK_GE(image_bytes_, entry.image_bytes);
+  image_bytes_ -= entry.image_bytes;
+  entry.image_bytes = 0;
+  entry.image.clear();
+}
+
+}  // namespace compositor
+}  // namespace sky
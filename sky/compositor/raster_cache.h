@@ -0,0 +1,77 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_COMPOSITOR_RASTER_CACHE_H_
+#define SKY_COMPOSITOR_RASTER_CACHE_H_
+
+#include <unordered_map>
+
+#include "base/macros.h"
+#include "skia/ext/refptr.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+class GrContext;
+class SkMatrix;
+class SkPicture;
+
+namespace sky {
+namespace compositor {
+
+// Caches GPU rasterizations of pictures that stay the same across frames, so
+// that static content is drawn as a texture instead of being replayed. Only
+// pictures that are expensive to replay are cached, and the cached textures
+// are kept within a memory budget. Entries that are not used in a frame are
+// evicted at the end of that frame.
+class RasterCache {
+ public:
+  RasterCache();
+  ~RasterCache();
+
+  // Returns the cached raster of |picture| as drawn with |ctm|, rasterizing it
+  // first if the picture has been seen in enough consecutive frames and is
+  // worth caching. Returns null if the picture should be drawn directly.
+  // Without a |context| the rasters are kept in main memory, for drawing in
+  // software.
+  skia::RefPtr<SkImage> GetPrerolledImage(GrContext* context,
+                                          SkPicture* picture,
+                                          const SkMatrix& ctm);
+  void SweepAfterFrame();
+  void Clear();
+
+  // The memory used by the cached rasters, in bytes.
+  size_t image_bytes() const { return image_bytes_; }
+
+ private:
+  struct Entry {
+    Entry();
+    ~Entry();
+
+    bool used_this_frame;
+    int access_count;
+    // Whether the picture is complex enough to be worth a texture. Only
+    // decided once the picture has been seen in enough frames.
+    bool analyzed;
+    bool worth_rasterizing;
+    // Set when rasterizing at |scale| failed, so that it isn't retried every
+    // frame.
+    bool raster_failed;
+    SkSize scale;
+    skia::RefPtr<SkImage> image;
+    size_t image_bytes;
+  };
+
+  void DropImage(Entry& entry);
+
+  // Keyed by SkPicture::uniqueID.
+  std::unordered_map<uint32_t, Entry> cache_;
+  size_t image_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(RasterCache);
+};
+
+}  // namespace compositor
+}  // namespace sky
+
+#endif  // SKY_COMPOSITOR_RASTER_CACHE_H_
@@ -0,0 +1,103 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/compositor/raster_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "third_party/skia/include/core/SkPaint.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+
+namespace sky {
+namespace compositor {
+namespace {
+
+// Matches the number of frames RasterCache waits for before rasterizing.
+const int kRasterThreshold = 3;
+
+skia::RefPtr<SkPicture> RecordPicture(int rect_count) {
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(100, 100));
+  SkPaint paint;
+  for (int i = 0; i < rect_count; ++i) {
+    paint.setColor(i % 2 ? SK_ColorRED : SK_ColorBLUE);
+    canvas->drawRect(SkRect::MakeXYWH(i, i, 10, 10), paint);
+  }
+  return skia::AdoptRef(recorder.endRecording());
+}
+
+// Looks |picture| up as one frame would, without a GrContext.
+skia::RefPtr<SkImage> DrawFrame(RasterCache& cache,
+                                SkPicture* picture,
+                                const SkMatrix& ctm = SkMatrix::I()) {
+  skia::RefPtr<SkImage> image = cache.GetPrerolledImage(nullptr, picture, ctm);
+  cache.SweepAfterFrame();
+  return image;
+}
+
+TEST(RasterCacheTest, CachesPictureDrawnInConsecutiveFrames) {
+  RasterCache cache;
+  skia::RefPtr<SkPicture> picture = RecordPicture(20);
+
+  for (int i = 1; i < kRasterThreshold; ++i)
+    EXPECT_FALSE(DrawFrame(cache, picture.get())) << "frame " << i;
+  skia::RefPtr<SkImage> image = DrawFrame(cache, picture.get());
+  ASSERT_TRUE(image);
+  EXPECT_EQ(100, image->width());
+  EXPECT_EQ(100, image->height());
+  EXPECT_EQ(100u * 100u * 4u, cache.image_bytes());
+
+  // Later frames reuse the raster.
+  EXPECT_EQ(image.get(), DrawFrame(cache, picture.get()).get());
+}
+
+TEST(RasterCacheTest, SkipsCheapPictures) {
+  RasterCache cache;
+  skia::RefPtr<SkPicture> picture = RecordPicture(1);
+  for (int i = 0; i < 2 * kRasterThreshold; ++i)
+    EXPECT_FALSE(DrawFrame(cache, picture.get())) << "frame " << i;
+  EXPECT_EQ(0u, cache.image_bytes());
+}
+
+TEST(RasterCacheTest, DropsPicturesMissingFromAFrame) {
+  RasterCache cache;
+  skia::RefPtr<SkPicture> picture = RecordPicture(20);
+  for (int i = 0; i < kRasterThreshold; ++i)
+    DrawFrame(cache, picture.get());
+  ASSERT_LT(0u, cache.image_bytes());
+
+  cache.SweepAfterFrame();
+  EXPECT_EQ(0u, cache.image_bytes());
+  EXPECT_FALSE(DrawFrame(cache, picture.get()));
+}
+
+TEST(RasterCacheTest, RerastersWhenScaleChanges) {
+  RasterCache cache;
+  skia::RefPtr<SkPicture> picture = RecordPicture(20);
+  for (int i = 0; i < kRasterThreshold; ++i)
+    DrawFrame(cache, picture.get());
+
+  SkMatrix scale = SkMatrix::MakeScale(2, 2);
+  for (int i = 1; i < kRasterThreshold; ++i)
+    EXPECT_FALSE(DrawFrame(cache, picture.get(), scale)) << "frame " << i;
+  skia::RefPtr<SkImage> image = DrawFrame(cache, picture.get(), scale);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(200, image->width());
+  EXPECT_EQ(200u * 200u * 4u, cache.image_bytes());
+}
+
+TEST(RasterCacheTest, SkipsRotatedPictures) {
+  RasterCache cache;
+  skia::RefPtr<SkPicture> picture = RecordPicture(20);
+  SkMatrix rotation;
+  rotation.setRotate(45);
+  for (int i = 0; i < 2 * kRasterThreshold; ++i)
+    EXPECT_FALSE(DrawFrame(cache, picture.get(), rotation)) << "frame " << i;
+}
+
+}  // namespace
+}  // namespace compositor
+}  // namespace sky
@@ -0,0 +1,37 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/compositor/transform_layer.h"
+
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace sky {
+namespace compositor {
+
+TransformLayer::TransformLayer() {
+  transform_.reset();
+}
+
+TransformLayer::~TransformLayer() {
+}
+
+void TransformLayer::Preroll(PaintContext::ScopedFrame& frame,
+                             const SkMatrix& matrix) {
+  SkMatrix child_matrix;
+  child_matrix.setConcat(matrix, transform_);
+
+  SkRect child_paint_bounds = PrerollChildren(frame, child_matrix);
+  transform_.mapRect(&child_paint_bounds);
+  set_paint_bounds(child_paint_bounds);
+}
+
+void TransformLayer::Paint(PaintContext::ScopedFrame& frame) {
+  SkCanvas& canvas = frame.canvas();
+  SkAutoCanvasRestore save(&canvas, true);
+  canvas.concat(transform_);
+  PaintChildren(frame);
+}
+
+}  // namespace compositor
+}  // namespace sky
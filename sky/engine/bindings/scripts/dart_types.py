@@ -118,6 +118,7 @@ CPP_SPECIAL_CONVERSION_RULES = {
     # dart_value_to_cpp_value using CPP_SPECIAL_CONVERSION_RULES directly
     # instead of calling cpp_type.
     'Float32List': 'Float32List',
+    'Int32List': 'Int32List',
     'Offset': 'Offset',
     'Point': 'Point',
     'Rect': 'Rect',
@@ -127,6 +128,8 @@ CPP_SPECIAL_CONVERSION_RULES = {
     'TransferMode': 'SkXfermode::Mode',
     'FilterQuality': 'SkFilterQuality',
     'PaintingStyle': 'SkPaint::Style',
+    'PointMode': 'SkCanvas::PointMode',
+    'LengthUnit': 'LengthUnitType',
 }
 
 
@@ -370,6 +373,7 @@ DART_TO_CPP_VALUE = {
     # Pass-by-value types.
     'Color': pass_by_value_format('CanvasColor'),
     'Float32List': pass_by_value_format('Float32List'),
+    'Int32List': pass_by_value_format('Int32List'),
     'Offset': pass_by_value_format('Offset'),
     'Point': pass_by_value_format('Point'),
     'RSTransform': pass_by_value_format('RSTransform'),
@@ -379,6 +383,8 @@ DART_TO_CPP_VALUE = {
     'TransferMode': pass_by_value_format('TransferMode', ''),
     'FilterQuality': pass_by_value_format('FilterQuality', ''),
     'PaintingStyle': pass_by_value_format('PaintingStyle', ''),
+    'PointMode': pass_by_value_format('PointMode', ''),
+    'LengthUnit': pass_by_value_format('LengthUnit', ''),
     'MojoDataPipeConsumer': pass_by_value_format('mojo::ScopedDataPipeConsumerHandle'),
 }
 
@@ -647,6 +653,7 @@ DART_SET_RETURN_VALUE = {
     'TypedList': 'Dart_SetReturnValue(args, DartUtilities::arrayBufferViewToDart({cpp_value}))',
     'Color': 'DartConverter<CanvasColor>::SetReturnValue(args, {cpp_value})',
     'Float32List': 'DartConverter<Float32List>::SetReturnValue(args, {cpp_value})',
+    'Int32List': 'DartConverter<Int32List>::SetReturnValue(args, {cpp_value})',
 }
 
 
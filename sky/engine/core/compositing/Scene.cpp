@@ -0,0 +1,24 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/compositing/Scene.h"
+
+namespace blink {
+
+PassRefPtr<Scene> Scene::create(std::unique_ptr<sky::compositor::Layer> rootLayer)
+{
+    ASSERT(rootLayer);
+    return adoptRef(new Scene(std::move(rootLayer)));
+}
+
+Scene::Scene(std::unique_ptr<sky::compositor::Layer> rootLayer)
+    : m_rootLayer(std::move(rootLayer))
+{
+}
+
+Scene::~Scene()
+{
+}
+
+} // namespace blink
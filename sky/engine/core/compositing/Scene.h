@@ -0,0 +1,34 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_COMPOSITING_SCENE_H_
+#define SKY_ENGINE_CORE_COMPOSITING_SCENE_H_
+
+#include <memory>
+
+#include "sky/compositor/layer.h"
+#include "sky/engine/tonic/dart_wrappable.h"
+#include "sky/engine/wtf/PassRefPtr.h"
+#include "sky/engine/wtf/RefCounted.h"
+
+namespace blink {
+
+class Scene : public RefCounted<Scene>, public DartWrappable {
+    DEFINE_WRAPPERTYPEINFO();
+public:
+    ~Scene() override;
+    static PassRefPtr<Scene> create(std::unique_ptr<sky::compositor::Layer> rootLayer);
+
+    // Shared with the layer trees of the frames that draw this scene.
+    std::shared_ptr<sky::compositor::Layer> rootLayer() const { return m_rootLayer; }
+
+private:
+    explicit Scene(std::unique_ptr<sky::compositor::Layer> rootLayer);
+
+    std::shared_ptr<sky::compositor::Layer> m_rootLayer;
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_CORE_COMPOSITING_SCENE_H_
@@ -0,0 +1,94 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/compositing/SceneBuilder.h"
+
+#include <algorithm>
+
+#include "sky/compositor/clip_rect_layer.h"
+#include "sky/compositor/opacity_layer.h"
+#include "sky/compositor/picture_layer.h"
+#include "sky/compositor/transform_layer.h"
+#include "sky/engine/core/painting/Matrix.h"
+
+namespace blink {
+
+SceneBuilder::SceneBuilder()
+    : m_currentLayer(nullptr)
+{
+}
+
+SceneBuilder::~SceneBuilder()
+{
+}
+
+void SceneBuilder::pushTransform(const Float32List& matrix4, ExceptionState& es)
+{
+    SkMatrix sk_matrix = toSkMatrix(matrix4, es);
+    if (es.had_exception())
+        return;
+    std::unique_ptr<sky::compositor::TransformLayer> layer(new sky::compositor::TransformLayer());
+    layer->set_transform(sk_matrix);
+    pushLayer(std::move(layer));
+}
+
+void SceneBuilder::pushClipRect(const Rect& rect)
+{
+    std::unique_ptr<sky::compositor::ClipRectLayer> layer(new sky::compositor::ClipRectLayer());
+    layer->set_clip_rect(rect.sk_rect);
+    pushLayer(std::move(layer));
+}
+
+void SceneBuilder::pushOpacity(int alpha)
+{
+    std::unique_ptr<sky::compositor::OpacityLayer> layer(new sky::compositor::OpacityLayer());
+    layer->set_alpha(std::max(0, std::min(alpha, 0xFF)));
+    pushLayer(std::move(layer));
+}
+
+void SceneBuilder::pop()
+{
+    if (!m_currentLayer || m_currentLayer == m_rootLayer.get())
+        return;
+    m_currentLayer = m_currentLayer->parent();
+}
+
+void SceneBuilder::addPicture(const Offset& offset, Picture* picture)
+{
+    if (!picture)
+        return;
+    std::unique_ptr<sky::compositor::PictureLayer> layer(new sky::compositor::PictureLayer());
+    layer->set_offset(SkPoint::Make(offset.sk_size.width(), offset.sk_size.height()));
+    layer->set_picture(skia::SharePtr(picture->toSkia()));
+    addLayer(std::move(layer));
+}
+
+bool SceneBuilder::addLayer(std::unique_ptr<sky::compositor::Layer> layer)
+{
+    if (!m_rootLayer) {
+        m_rootLayer.reset(new sky::compositor::ContainerLayer());
+        m_currentLayer = m_rootLayer.get();
+    }
+    if (!m_currentLayer)
+        return false;
+    m_currentLayer->Add(std::move(layer));
+    return true;
+}
+
+void SceneBuilder::pushLayer(std::unique_ptr<sky::compositor::ContainerLayer> layer)
+{
+    sky::compositor::ContainerLayer* newLayer = layer.get();
+    if (addLayer(std::move(layer)))
+        m_currentLayer = newLayer;
+}
+
+PassRefPtr<Scene> SceneBuilder::build()
+{
+    if (!m_rootLayer)
+        m_rootLayer.reset(new sky::compositor::ContainerLayer());
+    m_currentLayer = nullptr;
+    return Scene::create(std::move(m_rootLayer));
+}
+
+} // namespace blink
@@ -0,0 +1,54 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_COMPOSITING_SCENEBUILDER_H_
+#define SKY_ENGINE_CORE_COMPOSITING_SCENEBUILDER_H_
+
+#include <memory>
+
+#include "sky/compositor/container_layer.h"
+#include "sky/engine/bindings/exception_state.h"
+#include "sky/engine/core/compositing/Scene.h"
+#include "sky/engine/core/painting/Offset.h"
+#include "sky/engine/core/painting/Picture.h"
+#include "sky/engine/core/painting/Rect.h"
+#include "sky/engine/tonic/dart_wrappable.h"
+#include "sky/engine/tonic/float32_list.h"
+#include "sky/engine/wtf/PassRefPtr.h"
+#include "sky/engine/wtf/RefCounted.h"
+
+namespace blink {
+
+class SceneBuilder : public RefCounted<SceneBuilder>, public DartWrappable {
+    DEFINE_WRAPPERTYPEINFO();
+public:
+    static PassRefPtr<SceneBuilder> create()
+    {
+        return adoptRef(new SceneBuilder());
+    }
+
+    ~SceneBuilder() override;
+
+    void pushTransform(const Float32List& matrix4, ExceptionState&);
+    void pushClipRect(const Rect& rect);
+    void pushOpacity(int alpha);
+    void pop();
+
+    void addPicture(const Offset& offset, Picture* picture);
+
+    PassRefPtr<Scene> build();
+
+private:
+    SceneBuilder();
+
+    bool addLayer(std::unique_ptr<sky::compositor::Layer> layer);
+    void pushLayer(std::unique_ptr<sky::compositor::ContainerLayer> layer);
+
+    std::unique_ptr<sky::compositor::ContainerLayer> m_rootLayer;
+    sky::compositor::ContainerLayer* m_currentLayer;
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_CORE_COMPOSITING_SCENEBUILDER_H_
@@ -1686,6 +1686,26 @@ void CSSComputedStyleDeclaration::setProperty(const String& name, const String&,
     exceptionState.ThrowDOMException(NoModificationAllowedError, "These styles are computed, and therefore the '" + name + "' property is read-only.");
 }
 
+void CSSComputedStyleDeclaration::setLength(const String& name, double, LengthUnitType, ExceptionState& exceptionState)
+{
+    setProperty(name, String(), exceptionState);
+}
+
+void CSSComputedStyleDeclaration::setNumber(const String& name, double, ExceptionState& exceptionState)
+{
+    setProperty(name, String(), exceptionState);
+}
+
+void CSSComputedStyleDeclaration::setColor(const String& name, SkColor, ExceptionState& exceptionState)
+{
+    setProperty(name, String(), exceptionState);
+}
+
+void CSSComputedStyleDeclaration::setKeyword(const String& name, const String&, ExceptionState& exceptionState)
+{
+    setProperty(name, String(), exceptionState);
+}
+
 String CSSComputedStyleDeclaration::removeProperty(const String& name, ExceptionState& exceptionState)
 {
     exceptionState.ThrowDOMException(NoModificationAllowedError, "These styles are computed, and therefore the '" + name + "' property is read-only.");
@@ -83,6 +83,10 @@ private:
     virtual bool isPropertyImplicit(const String& propertyName) override;
     virtual void setProperty(const String& propertyName, const String& value, ExceptionState&) override;
     virtual String removeProperty(const String& propertyName, ExceptionState&) override;
+    virtual void setLength(const String& propertyName, double value, LengthUnitType, ExceptionState&) override;
+    virtual void setNumber(const String& propertyName, double value, ExceptionState&) override;
+    virtual void setColor(const String& propertyName, SkColor, ExceptionState&) override;
+    virtual void setKeyword(const String& propertyName, const String& keyword, ExceptionState&) override;
     virtual String cssText() const override;
     virtual void setCSSText(const String&, ExceptionState&) override;
     virtual PassRefPtr<CSSValue> getPropertyCSSValueInternal(CSSPropertyID) override;
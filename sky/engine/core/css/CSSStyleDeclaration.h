@@ -22,6 +22,8 @@
 #define SKY_ENGINE_CORE_CSS_CSSSTYLEDECLARATION_H_
 
 #include "gen/sky/core/CSSPropertyNames.h"
+#include "sky/engine/core/css/LengthUnit.h"
+#include "sky/engine/core/painting/CanvasColor.h"
 #include "sky/engine/tonic/dart_wrappable.h"
 #include "sky/engine/wtf/Forward.h"
 #include "sky/engine/wtf/Noncopyable.h"
@@ -56,6 +58,13 @@ public:
     virtual void setProperty(const String& propertyName, const String& value, ExceptionState&) = 0;
     virtual String removeProperty(const String& propertyName, ExceptionState&) = 0;
 
+    // Typed versions of setProperty that hand the value to the property
+    // parser directly instead of formatting and tokenizing a string.
+    virtual void setLength(const String& propertyName, double value, LengthUnitType, ExceptionState&) = 0;
+    virtual void setNumber(const String& propertyName, double value, ExceptionState&) = 0;
+    virtual void setColor(const String& propertyName, SkColor, ExceptionState&) = 0;
+    virtual void setKeyword(const String& propertyName, const String& keyword, ExceptionState&) = 0;
+
     // CSSPropertyID versions of the CSSOM functions to support bindings and editing.
     // Use the non-virtual methods in the concrete subclasses when possible.
     // The CSSValue returned by this function should not be exposed to the web as it may be used by multiple documents at the same time.
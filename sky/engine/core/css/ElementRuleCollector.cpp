@@ -41,6 +41,7 @@ ElementRuleCollector::ElementRuleCollector(const ElementResolveContext& context,
     RenderStyle* style)
     : m_context(context)
     , m_style(style)
+    , m_identifierFilterIsValid(false)
 { }
 
 ElementRuleCollector::~ElementRuleCollector()
@@ -116,6 +117,34 @@ void ElementRuleCollector::sortAndTransferMatchedRules()
     }
 }
 
+// Most rules are filed under their only identifier, which the element is
+// known to have, so the filter is only built for the compound selectors that
+// need more than one.
+inline bool ElementRuleCollector::identifiersMayMatch(const RuleData& ruleData, const RuleSet& ruleSet)
+{
+    if (!ruleData.hasIdentifierHashes())
+        return true;
+
+    if (!m_identifierFilterIsValid) {
+        Element& element = *m_context.element();
+        m_identifierFilter.add(element.localName());
+        if (element.hasID())
+            m_identifierFilter.add(element.idForStyleResolution());
+        if (element.isStyledElement() && element.hasClass()) {
+            for (size_t i = 0; i < element.classNames().size(); ++i)
+                m_identifierFilter.add(element.classNames()[i]);
+        }
+        m_identifierFilterIsValid = true;
+    }
+
+    const unsigned* hashes = ruleSet.identifierHashes(ruleData);
+    for (unsigned i = 0; i < RuleSet::maximumIdentifierCount && hashes[i]; ++i) {
+        if (!m_identifierFilter.mayContain(hashes[i]))
+            return false;
+    }
+    return true;
+}
+
 inline bool ElementRuleCollector::ruleMatches(const RuleData& ruleData)
 {
     SelectorChecker checker(*m_context.element());
@@ -136,7 +165,7 @@ inline bool ElementRuleCollector::ruleMatches(const RuleData& ruleData)
 void ElementRuleCollector::collectRuleIfMatches(const RuleData& ruleData, CascadeOrder cascadeOrder, const MatchRequest& matchRequest)
 {
     StyleRule* rule = ruleData.rule();
-    if (ruleMatches(ruleData)) {
+    if (identifiersMayMatch(ruleData, *matchRequest.ruleSet) && ruleMatches(ruleData)) {
         // If the rule has no properties to apply, then ignore it in the non-debug mode.
         const StylePropertySet& properties = rule->properties();
         if (properties.isEmpty())
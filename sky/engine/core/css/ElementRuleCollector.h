@@ -27,6 +27,7 @@
 #include "sky/engine/core/css/resolver/ElementResolveContext.h"
 #include "sky/engine/core/css/resolver/MatchRequest.h"
 #include "sky/engine/core/css/resolver/MatchResult.h"
+#include "sky/engine/wtf/BloomFilter.h"
 #include "sky/engine/wtf/RefPtr.h"
 #include "sky/engine/wtf/Vector.h"
 
@@ -111,6 +112,7 @@ private:
             collectRuleIfMatches(*it, cascadeOrder, matchRequest);
     }
 
+    bool identifiersMayMatch(const RuleData&, const RuleSet&);
     bool ruleMatches(const RuleData&);
 
     void sortMatchedRules();
@@ -122,6 +124,11 @@ private:
 
     OwnPtr<Vector<MatchedRule, 32> > m_matchedRules;
 
+    // The tag name, id and classes of the element, filled in the first time
+    // a rule needs more than the one identifier it was filed under.
+    BloomFilter<6> m_identifierFilter;
+    bool m_identifierFilterIsValid;
+
     // Output.
     MatchResult m_result;
 };
@@ -0,0 +1,55 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/css/ElementRuleCollector.h"
+
+#include "gen/sky/core/HTMLNames.h"
+#include "sky/engine/bindings/exception_state_placeholder.h"
+#include "sky/engine/core/css/RuleSet.h"
+#include "sky/engine/core/css/StyleSheetContents.h"
+#include "sky/engine/core/css/parser/CSSParserMode.h"
+#include "sky/engine/core/dom/Document.h"
+#include "sky/engine/core/dom/Element.h"
+#include "sky/engine/core/rendering/style/RenderStyle.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+size_t matchedRuleCount(Element& element, RuleSet* ruleSet)
+{
+    ElementResolveContext context(element);
+    ElementRuleCollector collector(context, RenderStyle::create().get());
+    collector.collectMatchingRules(MatchRequest(ruleSet));
+    collector.sortAndTransferMatchedRules();
+    return collector.matchedResult().matchedProperties.size();
+}
+
+TEST(ElementRuleCollectorTest, RejectsCompoundSelectorWithMissingIdentifier)
+{
+    RefPtr<StyleSheetContents> sheet = StyleSheetContents::create(0, strictCSSParserContext());
+    sheet->parseString(".a.b { color: red }");
+    // The RuleSet doesn't keep the sheet's rules alive.
+    OwnPtr<RuleSet> ruleSet = RuleSet::create();
+    ruleSet->addRulesFromSheet(sheet.get());
+
+    RefPtr<Document> document = Document::create();
+
+    // The rule is filed under one of its classes, so check both.
+    RefPtr<Element> onlyA = document->createElement("div", ASSERT_NO_EXCEPTION);
+    onlyA->setAttribute(HTMLNames::classAttr, "a");
+    EXPECT_EQ(0u, matchedRuleCount(*onlyA, ruleSet.get()));
+
+    RefPtr<Element> onlyB = document->createElement("div", ASSERT_NO_EXCEPTION);
+    onlyB->setAttribute(HTMLNames::classAttr, "b");
+    EXPECT_EQ(0u, matchedRuleCount(*onlyB, ruleSet.get()));
+
+    RefPtr<Element> both = document->createElement("div", ASSERT_NO_EXCEPTION);
+    both->setAttribute(HTMLNames::classAttr, "a b");
+    EXPECT_EQ(1u, matchedRuleCount(*both, ruleSet.get()));
+}
+
+} // namespace
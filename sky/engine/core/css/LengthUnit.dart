@@ -0,0 +1,17 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+part of dart.sky;
+
+/// The units CSSStyleDeclaration.setLength accepts. The values (order) should
+/// be kept in sync with LengthUnit.h.
+enum LengthUnit {
+  px,
+  percent,
+  em,
+  vw,
+  vh,
+  vmin,
+  vmax,
+}
@@ -0,0 +1,53 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_CSS_LENGTHUNIT_H_
+#define SKY_ENGINE_CORE_CSS_LENGTHUNIT_H_
+
+#include "sky/engine/core/css/CSSPrimitiveValue.h"
+#include "sky/engine/tonic/dart_converter.h"
+
+namespace blink {
+
+class LengthUnit {};
+
+// The values of the LengthUnit enum in LengthUnit.dart, in the same order.
+enum LengthUnitType {
+    LengthUnitPx,
+    LengthUnitPercent,
+    LengthUnitEm,
+    LengthUnitVw,
+    LengthUnitVh,
+    LengthUnitVmin,
+    LengthUnitVmax,
+};
+
+template <>
+struct DartConverter<LengthUnit> : public DartConverterEnum<LengthUnitType> {
+};
+
+inline CSSPrimitiveValue::UnitType toCSSUnitType(LengthUnitType unit)
+{
+    switch (unit) {
+    case LengthUnitPx:
+        return CSSPrimitiveValue::CSS_PX;
+    case LengthUnitPercent:
+        return CSSPrimitiveValue::CSS_PERCENTAGE;
+    case LengthUnitEm:
+        return CSSPrimitiveValue::CSS_EMS;
+    case LengthUnitVw:
+        return CSSPrimitiveValue::CSS_VW;
+    case LengthUnitVh:
+        return CSSPrimitiveValue::CSS_VH;
+    case LengthUnitVmin:
+        return CSSPrimitiveValue::CSS_VMIN;
+    case LengthUnitVmax:
+        return CSSPrimitiveValue::CSS_VMAX;
+    }
+    return CSSPrimitiveValue::CSS_UNKNOWN;
+}
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_CORE_CSS_LENGTHUNIT_H_
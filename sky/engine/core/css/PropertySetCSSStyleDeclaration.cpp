@@ -30,6 +30,7 @@
 #include "sky/engine/core/dom/Element.h"
 #include "sky/engine/core/dom/MutationObserverInterestGroup.h"
 #include "sky/engine/core/dom/MutationRecord.h"
+#include "sky/engine/wtf/MathExtras.h"
 
 namespace blink {
 
@@ -212,6 +213,61 @@ String AbstractPropertySetCSSStyleDeclaration::removeProperty(const String& prop
     return result;
 }
 
+void AbstractPropertySetCSSStyleDeclaration::setLength(const String& propertyName, double value, LengthUnitType unit, ExceptionState&)
+{
+    // Like an unparsable string, a value CSS can't represent is ignored.
+    if (!std::isfinite(value))
+        return;
+    CSSParserValue parserValue;
+    parserValue.setFromNumber(value, toCSSUnitType(unit));
+    setParserValue(propertyName, parserValue);
+}
+
+void AbstractPropertySetCSSStyleDeclaration::setNumber(const String& propertyName, double value, ExceptionState&)
+{
+    if (!std::isfinite(value))
+        return;
+    CSSParserValue parserValue;
+    parserValue.setFromNumber(value);
+    // Whole numbers count as integers, so that properties like z-index take them.
+    parserValue.isInt = std::floor(parserValue.fValue) == parserValue.fValue;
+    setParserValue(propertyName, parserValue);
+}
+
+void AbstractPropertySetCSSStyleDeclaration::setColor(const String& propertyName, SkColor color, ExceptionState&)
+{
+    CSSParserValue parserValue;
+    parserValue.setFromColor(static_cast<RGBA32>(color));
+    setParserValue(propertyName, parserValue);
+}
+
+void AbstractPropertySetCSSStyleDeclaration::setKeyword(const String& propertyName, const String& keyword, ExceptionState&)
+{
+    CSSParserValue parserValue;
+    parserValue.isInt = false;
+    parserValue.unit = CSSPrimitiveValue::CSS_IDENT;
+    parserValue.string.init(keyword);
+    parserValue.id = cssValueKeywordID(parserValue.string);
+    setParserValue(propertyName, parserValue);
+}
+
+void AbstractPropertySetCSSStyleDeclaration::setParserValue(const String& propertyName, const CSSParserValue& value)
+{
+    CSSPropertyID propertyID = cssPropertyID(propertyName);
+    if (!propertyID)
+        return;
+
+    StyleAttributeMutationScope mutationScope(this);
+    willMutate();
+
+    bool changed = propertySet().setProperty(propertyID, value, contextStyleSheet());
+
+    didMutate(changed ? PropertyChanged : NoChanges);
+
+    if (changed)
+        mutationScope.enqueueMutationRecord();
+}
+
 PassRefPtr<CSSValue> AbstractPropertySetCSSStyleDeclaration::getPropertyCSSValueInternal(CSSPropertyID propertyID)
 {
     return propertySet().getPropertyCSSValue(propertyID);
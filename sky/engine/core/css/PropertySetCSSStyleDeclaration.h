@@ -32,6 +32,7 @@
 
 namespace blink {
 
+struct CSSParserValue;
 class CSSProperty;
 class CSSValue;
 class Element;
@@ -53,6 +54,10 @@ private:
     virtual bool isPropertyImplicit(const String& propertyName) override final;
     virtual void setProperty(const String& propertyName, const String& value, ExceptionState&) override final;
     virtual String removeProperty(const String& propertyName, ExceptionState&) override final;
+    virtual void setLength(const String& propertyName, double value, LengthUnitType, ExceptionState&) override final;
+    virtual void setNumber(const String& propertyName, double value, ExceptionState&) override final;
+    virtual void setColor(const String& propertyName, SkColor, ExceptionState&) override final;
+    virtual void setKeyword(const String& propertyName, const String& keyword, ExceptionState&) override final;
     virtual String cssText() const override final;
     virtual void setCSSText(const String&, ExceptionState&) override final;
     virtual PassRefPtr<CSSValue> getPropertyCSSValueInternal(CSSPropertyID) override final;
@@ -62,6 +67,8 @@ private:
     virtual bool cssPropertyMatches(CSSPropertyID, const CSSValue*) const override final;
     virtual PassRefPtr<MutableStylePropertySet> copyProperties() const override final;
 
+    void setParserValue(const String& propertyName, const CSSParserValue&);
+
     CSSValue* cloneAndCacheForCSSOM(CSSValue*);
 
 protected:
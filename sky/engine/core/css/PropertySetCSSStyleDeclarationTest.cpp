@@ -0,0 +1,48 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/css/PropertySetCSSStyleDeclaration.h"
+
+#include <limits>
+
+#include "sky/engine/bindings/exception_state_placeholder.h"
+#include "sky/engine/core/css/LengthUnit.h"
+#include "sky/engine/core/dom/Document.h"
+#include "sky/engine/core/dom/Element.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+TEST(PropertySetCSSStyleDeclarationTest, IgnoresNonFiniteLengths)
+{
+    RefPtr<Document> document = Document::create();
+    RefPtr<Element> element = document->createElement("div", ASSERT_NO_EXCEPTION);
+    CSSStyleDeclaration* style = element->style();
+
+    style->setLength("width", 10, LengthUnitPx, ASSERT_NO_EXCEPTION);
+    style->setLength("width", std::numeric_limits<double>::quiet_NaN(), LengthUnitPx, ASSERT_NO_EXCEPTION);
+    style->setLength("width", std::numeric_limits<double>::infinity(), LengthUnitPx, ASSERT_NO_EXCEPTION);
+    style->setLength("width", -std::numeric_limits<double>::infinity(), LengthUnitPercent, ASSERT_NO_EXCEPTION);
+    EXPECT_EQ("10px", style->getPropertyValue("width"));
+}
+
+TEST(PropertySetCSSStyleDeclarationTest, IgnoresNonFiniteNumbers)
+{
+    RefPtr<Document> document = Document::create();
+    RefPtr<Element> element = document->createElement("div", ASSERT_NO_EXCEPTION);
+    CSSStyleDeclaration* style = element->style();
+
+    style->setNumber("opacity", 0.5, ASSERT_NO_EXCEPTION);
+    style->setNumber("opacity", std::numeric_limits<double>::quiet_NaN(), ASSERT_NO_EXCEPTION);
+    style->setNumber("opacity", std::numeric_limits<double>::infinity(), ASSERT_NO_EXCEPTION);
+    EXPECT_EQ("0.5", style->getPropertyValue("opacity"));
+
+    style->setNumber("flex-grow", -std::numeric_limits<double>::infinity(), ASSERT_NO_EXCEPTION);
+    EXPECT_EQ("", style->getPropertyValue("flex-grow"));
+}
+
+} // namespace
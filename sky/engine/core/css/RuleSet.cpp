@@ -41,10 +41,33 @@ namespace blink {
 
 // -----------------------------------------------------------------
 
+static unsigned collectIdentifierHashes(const CSSSelector& selector, unsigned* hashes, unsigned maximumCount)
+{
+    unsigned count = 0;
+    for (const CSSSelector* current = &selector; current && count < maximumCount; current = current->tagHistory()) {
+        switch (current->match()) {
+        case CSSSelector::Id:
+        case CSSSelector::Class:
+            hashes[count++] = current->value().impl()->existingHash();
+            break;
+        case CSSSelector::Tag:
+            if (current->tagQName().localName() != starAtom)
+                hashes[count++] = current->tagQName().localName().impl()->existingHash();
+            break;
+        default:
+            break;
+        }
+    }
+    if (count < maximumCount)
+        hashes[count] = 0;
+    return count;
+}
+
 RuleData::RuleData(StyleRule* rule, unsigned selectorIndex, unsigned position)
     : m_rule(rule)
     , m_selectorIndex(selectorIndex)
     , m_isLastInArray(false)
+    , m_hasIdentifierHashes(false)
     , m_position(position)
 {
     ASSERT(m_position == position);
@@ -125,12 +148,27 @@ void RuleSet::addRule(StyleRule* rule, unsigned selectorIndex)
     RuleData ruleData(rule, selectorIndex, m_ruleCount++);
     m_features.collectFeaturesFromSelector(ruleData.selector());
 
+    // The bucket a rule is filed under already guarantees one identifier.
+    IdentifierHashes identifierHashes;
+    if (collectIdentifierHashes(ruleData.selector(), identifierHashes.hashes, maximumIdentifierCount) > 1) {
+        m_identifierHashes.add(&ruleData.selector(), identifierHashes);
+        ruleData.setHasIdentifierHashes();
+    }
+
     if (!findBestRuleSetAndAdd(ruleData.selector(), ruleData)) {
         // If we didn't find a specialized map to stick it in, file under universal rules.
         m_universalRules.append(ruleData);
     }
 }
 
+const unsigned* RuleSet::identifierHashes(const RuleData& ruleData) const
+{
+    ASSERT(ruleData.hasIdentifierHashes());
+    IdentifierHashMap::const_iterator it = m_identifierHashes.find(&ruleData.selector());
+    ASSERT(it != m_identifierHashes.end());
+    return it->value.hashes;
+}
+
 void RuleSet::addFontFaceRule(StyleRuleFontFace* rule)
 {
     ensurePendingRules(); // So that m_fontFaceRules.shrinkToFit() gets called.
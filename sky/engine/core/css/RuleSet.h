@@ -48,10 +48,16 @@ public:
     bool isLastInArray() const { return m_isLastInArray; }
     void setLastInArray(bool flag) { m_isLastInArray = flag; }
 
+    // True if the selector needs more than one identifier, in which case the
+    // RuleSet keeps their hashes. See RuleSet::identifierHashes().
+    bool hasIdentifierHashes() const { return m_hasIdentifierHashes; }
+    void setHasIdentifierHashes() { m_hasIdentifierHashes = true; }
+
 private:
     RawPtr<StyleRule> m_rule;
     unsigned m_selectorIndex : 12;
     unsigned m_isLastInArray : 1; // We store an array of RuleData objects in a primitive array.
+    unsigned m_hasIdentifierHashes : 1;
     // This number was picked fairly arbitrarily. We can probably lower it if we need to.
     // Some simple testing showed <100,000 RuleData's on large sites.
     unsigned m_position : 17;
@@ -83,6 +89,14 @@ public:
     const Vector<RuleData>* hostRules() const { ASSERT(!m_pendingRules); return &m_hostRules; }
     const Vector<RawPtr<StyleRuleFontFace> >& fontFaceRules() const { return m_fontFaceRules; }
 
+    // Hashes of the tag name, id and classes a matching element must have,
+    // terminated by a zero if there are fewer than the maximum. Selectors
+    // with more identifiers only have the first few recorded, so an element
+    // that has all of them may still fail to match. Only kept for the few
+    // rules that need more than one identifier, so that RuleData stays small.
+    static const unsigned maximumIdentifierCount = 4;
+    const unsigned* identifierHashes(const RuleData&) const;
+
     void compactRulesIfNeeded()
     {
         if (!m_pendingRules)
@@ -98,6 +112,11 @@ private:
     typedef HashMap<AtomicString, OwnPtr<LinkedStack<RuleData> > > PendingRuleMap;
     typedef HashMap<AtomicString, OwnPtr<TerminatedArray<RuleData> > > CompactRuleMap;
 
+    struct IdentifierHashes {
+        unsigned hashes[maximumIdentifierCount];
+    };
+    typedef HashMap<const CSSSelector*, IdentifierHashes> IdentifierHashMap;
+
     RuleSet()
         : m_ruleCount(0)
     {
@@ -137,6 +156,7 @@ private:
     Vector<RuleData> m_universalRules;
     Vector<RuleData> m_hostRules;
     Vector<RawPtr<StyleRuleFontFace> > m_fontFaceRules;
+    IdentifierHashMap m_identifierHashes;
 
     RuleFeatureSet m_features;
 
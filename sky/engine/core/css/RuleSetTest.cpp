@@ -0,0 +1,73 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/css/RuleSet.h"
+
+#include "sky/engine/core/css/StyleSheetContents.h"
+#include "sky/engine/core/css/parser/CSSParserMode.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+PassRefPtr<StyleSheetContents> parseSheet(const char* text)
+{
+    RefPtr<StyleSheetContents> sheet = StyleSheetContents::create(0, strictCSSParserContext());
+    sheet->parseString(text);
+    return sheet.release();
+}
+
+// The RuleSet doesn't keep the sheet's rules alive.
+PassOwnPtr<RuleSet> createRuleSet(StyleSheetContents* sheet)
+{
+    OwnPtr<RuleSet> ruleSet = RuleSet::create();
+    ruleSet->addRulesFromSheet(sheet);
+    ruleSet->compactRulesIfNeeded();
+    return ruleSet.release();
+}
+
+unsigned identifierCount(const RuleSet& ruleSet, const RuleData& ruleData)
+{
+    if (!ruleData.hasIdentifierHashes())
+        return 0;
+    const unsigned* hashes = ruleSet.identifierHashes(ruleData);
+    unsigned count = 0;
+    while (count < RuleSet::maximumIdentifierCount && hashes[count])
+        ++count;
+    return count;
+}
+
+TEST(RuleSetTest, CollectsIdentifierHashes)
+{
+    RefPtr<StyleSheetContents> sheet = parseSheet(".c { color: red } div.a.b { color: blue } [foo] { color: green }");
+    OwnPtr<RuleSet> ruleSet = createRuleSet(sheet.get());
+
+    const TerminatedArray<RuleData>* classRules = ruleSet->classRules("c");
+    ASSERT_TRUE(classRules);
+    // The bucket already guarantees a single identifier.
+    EXPECT_FALSE(classRules->at(0).hasIdentifierHashes());
+
+    const TerminatedArray<RuleData>* compoundRules = ruleSet->classRules("b");
+    ASSERT_TRUE(compoundRules);
+    const RuleData& compoundRule = compoundRules->at(0);
+    EXPECT_EQ(3u, identifierCount(*ruleSet, compoundRule));
+
+    ASSERT_EQ(1u, ruleSet->universalRules()->size());
+    EXPECT_FALSE(ruleSet->universalRules()->at(0).hasIdentifierHashes());
+}
+
+TEST(RuleSetTest, LimitsIdentifierHashes)
+{
+    RefPtr<StyleSheetContents> sheet = parseSheet("div#x.a.b.c.d { color: red }");
+    OwnPtr<RuleSet> ruleSet = createRuleSet(sheet.get());
+
+    const TerminatedArray<RuleData>* idRules = ruleSet->idRules("x");
+    ASSERT_TRUE(idRules);
+    unsigned maximumCount = RuleSet::maximumIdentifierCount;
+    EXPECT_EQ(maximumCount, identifierCount(*ruleSet, idRules->at(0)));
+}
+
+} // namespace
@@ -29,6 +29,7 @@
 #include "sky/engine/core/css/StylePropertySerializer.h"
 #include "sky/engine/core/css/StyleSheetContents.h"
 #include "sky/engine/core/css/parser/BisonCSSParser.h"
+#include "sky/engine/core/css/parser/CSSParsedValueCache.h"
 #include "sky/engine/wtf/text/StringBuilder.h"
 
 #ifndef NDEBUG
@@ -202,6 +203,21 @@ bool MutableStylePropertySet::setProperty(CSSPropertyID propertyID, const String
     return BisonCSSParser::parseValue(this, propertyID, value, cssParserMode(), contextStyleSheet);
 }
 
+bool MutableStylePropertySet::setProperty(CSSPropertyID propertyID, const CSSParserValue& value, StyleSheetContents* contextStyleSheet)
+{
+    CSSParserContext context;
+    if (contextStyleSheet)
+        context = contextStyleSheet->parserContext();
+
+    CSSParserValueList valueList;
+    valueList.addValue(value);
+    Vector<CSSProperty, 256> properties;
+    if (!CSSPropertyParser::parseValue(propertyID, &valueList, context, false, properties, CSSRuleSourceData::UNKNOWN_RULE))
+        return false;
+    addParsedProperties(properties);
+    return true;
+}
+
 void MutableStylePropertySet::setProperty(CSSPropertyID propertyID, PassRefPtr<CSSValue> prpValue)
 {
     StylePropertyShorthand shorthand = shorthandForProperty(propertyID);
@@ -254,6 +270,14 @@ void MutableStylePropertySet::parseDeclaration(const String& styleDeclaration, S
     if (contextStyleSheet)
         context = contextStyleSheet->parserContext();
 
+    // Reuse what parsing the same style attribute for another element made.
+    if (ImmutableStylePropertySet* parsed = cssParsedValueCache().findDeclaration(styleDeclaration, context)) {
+        m_propertyVector.reserveCapacity(parsed->propertyCount());
+        for (unsigned i = 0; i < parsed->propertyCount(); ++i)
+            m_propertyVector.append(parsed->propertyAt(i).toCSSProperty());
+        return;
+    }
+
     BisonCSSParser parser(context);
     parser.parseDeclaration(this, styleDeclaration, 0, contextStyleSheet);
 }
@@ -32,6 +32,7 @@
 
 namespace blink {
 
+struct CSSParserValue;
 class CSSStyleDeclaration;
 class Element;
 class ImmutableStylePropertySet;
@@ -184,6 +185,9 @@ public:
 
     // These expand shorthand properties into multiple properties.
     bool setProperty(CSSPropertyID, const String& value, StyleSheetContents* contextStyleSheet = 0);
+    // Validates and expands a single value that was built without a string,
+    // skipping the tokenizer and grammar.
+    bool setProperty(CSSPropertyID, const CSSParserValue&, StyleSheetContents* contextStyleSheet = 0);
     void setProperty(CSSPropertyID, PassRefPtr<CSSValue>);
 
     // These do not. FIXME: This is too messy, we can do better.
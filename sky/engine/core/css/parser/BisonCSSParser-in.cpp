@@ -52,6 +52,7 @@
 #include "sky/engine/core/css/StylePropertySet.h"
 #include "sky/engine/core/css/StyleRule.h"
 #include "sky/engine/core/css/StyleSheetContents.h"
+#include "sky/engine/core/css/parser/CSSParsedValueCache.h"
 #include "sky/engine/core/css/parser/CSSParserIdioms.h"
 #include "sky/engine/core/dom/Document.h"
 #include "sky/engine/core/frame/FrameHost.h"
@@ -742,6 +743,13 @@ bool BisonCSSParser::parseValue(MutableStylePropertySet* declaration, CSSPropert
 
 bool BisonCSSParser::parseValue(MutableStylePropertySet* declaration, CSSPropertyID propertyID, const String& string, StyleSheetContents* contextStyleSheet)
 {
+    CSSParsedValueCache& cache = cssParsedValueCache();
+    if (const Vector<CSSProperty>* properties = cache.findValue(propertyID, string, m_context)) {
+        for (const CSSProperty& property : *properties)
+            declaration->addParsedProperty(property);
+        return !properties->isEmpty();
+    }
+
     setStyleSheet(contextStyleSheet);
 
     setupParser("@-internal-value ", string, "");
@@ -753,6 +761,9 @@ bool BisonCSSParser::parseValue(MutableStylePropertySet* declaration, CSSPropert
     m_rule = nullptr;
     m_id = CSSPropertyInvalid;
 
+    // Remember invalid values too, so that writing them again fails fast.
+    cache.addValue(propertyID, string, m_context, m_parsedProperties);
+
     bool ok = false;
     if (!m_parsedProperties.isEmpty()) {
         ok = true;
@@ -836,7 +847,14 @@ PassRefPtr<ImmutableStylePropertySet> BisonCSSParser::parseInlineStyleDeclaratio
 {
     Document& document = element->document();
     CSSParserContext context = CSSParserContext(document.elementSheet().contents()->parserContext());
-    return BisonCSSParser(context).parseDeclaration(string, document.elementSheet().contents());
+
+    CSSParsedValueCache& cache = cssParsedValueCache();
+    if (ImmutableStylePropertySet* style = cache.findDeclaration(string, context))
+        return style;
+
+    RefPtr<ImmutableStylePropertySet> style = BisonCSSParser(context).parseDeclaration(string, document.elementSheet().contents());
+    cache.addDeclaration(string, context, style);
+    return style.release();
 }
 
 PassRefPtr<ImmutableStylePropertySet> BisonCSSParser::parseDeclaration(const String& string, StyleSheetContents* contextStyleSheet)
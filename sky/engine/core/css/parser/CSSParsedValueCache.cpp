@@ -0,0 +1,89 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/css/parser/CSSParsedValueCache.h"
+
+#include "sky/engine/wtf/MainThread.h"
+#include "sky/engine/wtf/OwnPtr.h"
+#include "sky/engine/wtf/PassOwnPtr.h"
+
+namespace blink {
+
+// Enough for the handful of distinct values a page of widgets writes every
+// frame, without keeping every animated value ever written alive.
+static const unsigned maximumValueCacheSize = 1024;
+static const unsigned maximumDeclarationCacheSize = 256;
+
+CSSParsedValueCache& cssParsedValueCache()
+{
+    ASSERT(isMainThread());
+    DEFINE_STATIC_LOCAL(OwnPtr<CSSParsedValueCache>, cache, (adoptPtr(new CSSParsedValueCache())));
+    return *cache;
+}
+
+CSSParsedValueCache::CSSParsedValueCache()
+{
+}
+
+CSSParsedValueCache::ValueKey CSSParsedValueCache::valueKey(CSSPropertyID propertyID, const String& string, const CSSParserContext& context)
+{
+    return std::make_pair(std::make_pair(static_cast<unsigned>(context.mode()), static_cast<unsigned>(propertyID)), string);
+}
+
+CSSParsedValueCache::DeclarationKey CSSParsedValueCache::declarationKey(const String& string, const CSSParserContext& context)
+{
+    return std::make_pair(static_cast<unsigned>(context.mode()), string);
+}
+
+const Vector<CSSProperty>* CSSParsedValueCache::findValue(CSSPropertyID propertyID, const String& string, const CSSParserContext& context)
+{
+    ValueCache::iterator it = m_valueCache.find(valueKey(propertyID, string, context));
+    if (it == m_valueCache.end() || it->value.baseURL != context.baseURL()) {
+        ++m_stats.valueMisses;
+        return 0;
+    }
+    ++m_stats.valueHits;
+    return &it->value.properties;
+}
+
+void CSSParsedValueCache::addValue(CSSPropertyID propertyID, const String& string, const CSSParserContext& context, const Vector<CSSProperty, 256>& properties)
+{
+    // Just wipe out the cache and start rebuilding if it gets too big.
+    if (m_valueCache.size() >= maximumValueCacheSize)
+        m_valueCache.clear();
+
+    CachedValue& entry = m_valueCache.add(valueKey(propertyID, string, context), CachedValue()).storedValue->value;
+    entry.baseURL = context.baseURL();
+    entry.properties.clear();
+    entry.properties.appendVector(properties);
+}
+
+ImmutableStylePropertySet* CSSParsedValueCache::findDeclaration(const String& string, const CSSParserContext& context)
+{
+    DeclarationCache::iterator it = m_declarationCache.find(declarationKey(string, context));
+    if (it == m_declarationCache.end() || it->value.baseURL != context.baseURL()) {
+        ++m_stats.declarationMisses;
+        return 0;
+    }
+    ++m_stats.declarationHits;
+    return it->value.declaration.get();
+}
+
+void CSSParsedValueCache::addDeclaration(const String& string, const CSSParserContext& context, PassRefPtr<ImmutableStylePropertySet> declaration)
+{
+    if (m_declarationCache.size() >= maximumDeclarationCacheSize)
+        m_declarationCache.clear();
+
+    CachedDeclaration& entry = m_declarationCache.add(declarationKey(string, context), CachedDeclaration()).storedValue->value;
+    entry.baseURL = context.baseURL();
+    entry.declaration = declaration;
+}
+
+void CSSParsedValueCache::clear()
+{
+    m_valueCache.clear();
+    m_declarationCache.clear();
+}
+
+} // namespace blink
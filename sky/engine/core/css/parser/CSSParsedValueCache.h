@@ -0,0 +1,91 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_CSS_PARSER_CSSPARSEDVALUECACHE_H_
+#define SKY_ENGINE_CORE_CSS_PARSER_CSSPARSEDVALUECACHE_H_
+
+#include <utility>
+
+#include "gen/sky/core/CSSPropertyNames.h"
+#include "sky/engine/core/css/CSSProperty.h"
+#include "sky/engine/core/css/StylePropertySet.h"
+#include "sky/engine/core/css/parser/CSSParserMode.h"
+#include "sky/engine/platform/weborigin/KURL.h"
+#include "sky/engine/wtf/HashMap.h"
+#include "sky/engine/wtf/Noncopyable.h"
+#include "sky/engine/wtf/RefPtr.h"
+#include "sky/engine/wtf/Vector.h"
+#include "sky/engine/wtf/text/StringHash.h"
+#include "sky/engine/wtf/text/WTFString.h"
+
+namespace blink {
+
+// Remembers what the grammar made of the property values and style
+// attributes that script keeps writing, so that writing the same string
+// again skips the tokenizer and grammar. Results depend on the mode and the
+// base URL of the parser context: the mode is part of the key, and an entry
+// only matches the base URL it was parsed with. Like the CSSValuePool, the
+// cache only lives on the main thread and is wiped whenever it fills up.
+class CSSParsedValueCache {
+    WTF_MAKE_FAST_ALLOCATED;
+    WTF_MAKE_NONCOPYABLE(CSSParsedValueCache);
+public:
+    struct Stats {
+        Stats() : valueHits(0), valueMisses(0), declarationHits(0), declarationMisses(0) { }
+
+        unsigned valueHits;
+        unsigned valueMisses;
+        unsigned declarationHits;
+        unsigned declarationMisses;
+    };
+
+    // Returns the properties that parsing |string| as |propertyID| produced,
+    // which are empty if the value was invalid, or 0 on a miss.
+    const Vector<CSSProperty>* findValue(CSSPropertyID, const String&, const CSSParserContext&);
+    void addValue(CSSPropertyID, const String&, const CSSParserContext&, const Vector<CSSProperty, 256>&);
+
+    // The declarations are shared between every element whose style
+    // attribute matches, so callers must not mutate them.
+    ImmutableStylePropertySet* findDeclaration(const String&, const CSSParserContext&);
+    void addDeclaration(const String&, const CSSParserContext&, PassRefPtr<ImmutableStylePropertySet>);
+
+    void clear();
+
+    const Stats& stats() const { return m_stats; }
+
+private:
+    CSSParsedValueCache();
+
+    struct CachedValue {
+        KURL baseURL;
+        Vector<CSSProperty> properties;
+    };
+
+    struct CachedDeclaration {
+        KURL baseURL;
+        RefPtr<ImmutableStylePropertySet> declaration;
+    };
+
+    // (mode, property) and the string for values, mode and the string for
+    // declarations.
+    typedef std::pair<std::pair<unsigned, unsigned>, String> ValueKey;
+    typedef std::pair<unsigned, String> DeclarationKey;
+    typedef HashMap<ValueKey, CachedValue> ValueCache;
+    typedef HashMap<DeclarationKey, CachedDeclaration> DeclarationCache;
+
+    static ValueKey valueKey(CSSPropertyID, const String&, const CSSParserContext&);
+    static DeclarationKey declarationKey(const String&, const CSSParserContext&);
+
+    ValueCache m_valueCache;
+    DeclarationCache m_declarationCache;
+    Stats m_stats;
+
+    friend CSSParsedValueCache& cssParsedValueCache();
+};
+
+CSSParsedValueCache& cssParsedValueCache();
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_CORE_CSS_PARSER_CSSPARSEDVALUECACHE_H_
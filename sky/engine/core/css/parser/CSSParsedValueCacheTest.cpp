@@ -0,0 +1,83 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/css/parser/CSSParsedValueCache.h"
+
+#include "sky/engine/core/css/StylePropertySet.h"
+#include "sky/engine/core/css/parser/BisonCSSParser.h"
+#include "sky/engine/platform/weborigin/KURL.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+TEST(CSSParsedValueCacheTest, ReusesParsedShorthand)
+{
+    CSSParsedValueCache& cache = cssParsedValueCache();
+    cache.clear();
+    unsigned hits = cache.stats().valueHits;
+
+    RefPtr<MutableStylePropertySet> first = MutableStylePropertySet::create();
+    EXPECT_TRUE(BisonCSSParser::parseValue(first.get(), CSSPropertyFlex, "2 3 auto", HTMLStandardMode, 0));
+    EXPECT_EQ(hits, cache.stats().valueHits);
+
+    RefPtr<MutableStylePropertySet> second = MutableStylePropertySet::create();
+    EXPECT_TRUE(BisonCSSParser::parseValue(second.get(), CSSPropertyFlex, "2 3 auto", HTMLStandardMode, 0));
+    EXPECT_EQ(hits + 1, cache.stats().valueHits);
+
+    EXPECT_EQ(first->propertyCount(), second->propertyCount());
+    EXPECT_EQ(first->getPropertyCSSValue(CSSPropertyFlexGrow).get(), second->getPropertyCSSValue(CSSPropertyFlexGrow).get());
+}
+
+TEST(CSSParsedValueCacheTest, RemembersInvalidValues)
+{
+    CSSParsedValueCache& cache = cssParsedValueCache();
+    cache.clear();
+    unsigned hits = cache.stats().valueHits;
+
+    RefPtr<MutableStylePropertySet> style = MutableStylePropertySet::create();
+    EXPECT_FALSE(BisonCSSParser::parseValue(style.get(), CSSPropertyFlex, "2 3 4 5", HTMLStandardMode, 0));
+    EXPECT_FALSE(BisonCSSParser::parseValue(style.get(), CSSPropertyFlex, "2 3 4 5", HTMLStandardMode, 0));
+    EXPECT_EQ(hits + 1, cache.stats().valueHits);
+    EXPECT_EQ(0u, style->propertyCount());
+}
+
+TEST(CSSParsedValueCacheTest, ValuesOnlyMatchTheirPropertyAndBaseURL)
+{
+    CSSParsedValueCache& cache = cssParsedValueCache();
+    cache.clear();
+
+    CSSParserContext context;
+    context.setBaseURL(KURL(ParsedURLString, "http://example.com/a/"));
+    cache.addValue(CSSPropertyBackgroundImage, "url(image.png)", context, Vector<CSSProperty, 256>());
+    EXPECT_TRUE(cache.findValue(CSSPropertyBackgroundImage, "url(image.png)", context));
+
+    // A relative URL resolves differently against another base.
+    CSSParserContext otherBase(context);
+    otherBase.setBaseURL(KURL(ParsedURLString, "http://example.com/b/"));
+    EXPECT_FALSE(cache.findValue(CSSPropertyBackgroundImage, "url(image.png)", otherBase));
+    EXPECT_FALSE(cache.findValue(CSSPropertyColor, "url(image.png)", context));
+}
+
+TEST(CSSParsedValueCacheTest, DeclarationsOnlyMatchTheirBaseURL)
+{
+    CSSParsedValueCache& cache = cssParsedValueCache();
+    cache.clear();
+
+    CSSParserContext context;
+    context.setBaseURL(KURL(ParsedURLString, "http://example.com/a/"));
+    RefPtr<ImmutableStylePropertySet> declaration = ImmutableStylePropertySet::create(0, 0, context.mode());
+    cache.addDeclaration("background-image: url(image.png)", context, declaration);
+    EXPECT_EQ(declaration.get(), cache.findDeclaration("background-image: url(image.png)", context));
+
+    CSSParserContext otherBase(context);
+    otherBase.setBaseURL(KURL(ParsedURLString, "http://example.com/b/"));
+    unsigned misses = cache.stats().declarationMisses;
+    EXPECT_FALSE(cache.findDeclaration("background-image: url(image.png)", otherBase));
+    EXPECT_EQ(misses + 1, cache.stats().declarationMisses);
+}
+
+} // namespace
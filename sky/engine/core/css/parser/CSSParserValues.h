@@ -156,6 +156,8 @@ struct CSSParserValue {
     int unit;
 
     inline void setFromNumber(double value, int unit = CSSPrimitiveValue::CSS_NUMBER);
+    // Only for values built without the tokenizer, which never produces colors.
+    inline void setFromColor(RGBA32);
     inline void setFromFunction(CSSParserFunction*);
     inline void setFromValueList(PassOwnPtr<CSSParserValueList>);
 };
@@ -252,6 +254,14 @@ inline void CSSParserValue::setFromNumber(double value, int unit)
     this->unit = unit;
 }
 
+inline void CSSParserValue::setFromColor(RGBA32 color)
+{
+    id = CSSValueInvalid;
+    isInt = false;
+    iValue = static_cast<int>(color);
+    unit = CSSPrimitiveValue::CSS_RGBCOLOR;
+}
+
 inline void CSSParserValue::setFromFunction(CSSParserFunction* function)
 {
     id = CSSValueInvalid;
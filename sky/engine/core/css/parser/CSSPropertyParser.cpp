@@ -3187,7 +3187,9 @@ PassRefPtr<CSSPrimitiveValue> CSSPropertyParser::parseColor(CSSParserValue* valu
 
 bool CSSPropertyParser::parseColorFromValue(CSSParserValue* value, RGBA32& c, bool acceptQuirkyColors)
 {
-    if (acceptQuirkyColors && value->unit == CSSPrimitiveValue::CSS_NUMBER
+    if (value->unit == CSSPrimitiveValue::CSS_RGBCOLOR) {
+        c = static_cast<RGBA32>(value->iValue);
+    } else if (acceptQuirkyColors && value->unit == CSSPrimitiveValue::CSS_NUMBER
         && value->fValue >= 0. && value->fValue < 1000000.) {
         String str = String::format("%06d", static_cast<int>((value->fValue+.5)));
         // FIXME: This should be strict parsing for SVG as well.
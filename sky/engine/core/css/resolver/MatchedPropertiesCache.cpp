@@ -29,7 +29,6 @@
 #include "sky/engine/core/css/resolver/MatchedPropertiesCache.h"
 
 #include "sky/engine/core/css/StylePropertySet.h"
-#include "sky/engine/core/css/resolver/StyleResolverState.h"
 #include "sky/engine/core/rendering/style/RenderStyle.h"
 
 namespace blink {
@@ -51,87 +50,183 @@ void CachedMatchedProperties::clear()
     parentRenderStyle = nullptr;
 }
 
-MatchedPropertiesCache::MatchedPropertiesCache()
-    : m_additionsSinceLastSweep(0)
-    , m_sweepTimer(this, &MatchedPropertiesCache::sweep)
+// Sized for the few hundred distinct rule combinations a typical app ends up
+// matching.
+static const unsigned bucketCount = 128;
+static const unsigned waysPerBucket = 4;
+
+// Roughly what all the ways hold when most of them are in use.
+const size_t MatchedPropertiesCache::defaultMaximumByteSize = 512 * 1024;
+
+// Both cached styles are clones, so they share their substructures with the
+// styles they were made from. We charge the substructures anyway: the cache
+// keeps them alive after those styles change or go away.
+static size_t renderStyleByteSize()
 {
+    return sizeof(RenderStyle)
+        + sizeof(StyleBoxData)
+        + sizeof(StyleVisualData)
+        + sizeof(StyleBackgroundData)
+        + sizeof(StyleSurroundData)
+        + sizeof(StyleRareNonInheritedData)
+        + sizeof(StyleRareInheritedData)
+        + sizeof(StyleInheritedData);
 }
 
-const CachedMatchedProperties* MatchedPropertiesCache::find(unsigned hash, const StyleResolverState& styleResolverState, const MatchResult& matchResult)
+static bool holdsLastReference(const CachedMatchedProperties& properties)
 {
-    ASSERT(hash);
+    const Vector<RefPtr<StylePropertySet>>& matchedProperties = properties.matchedProperties;
+    for (size_t i = 0; i < matchedProperties.size(); ++i) {
+        if (matchedProperties[i]->hasOneRef())
+            return true;
+    }
+    return false;
+}
 
-    Cache::iterator it = m_cache.find(hash);
-    if (it == m_cache.end())
-        return 0;
-    CachedMatchedProperties* cacheItem = it->value.get();
-    ASSERT(cacheItem);
+MatchedPropertiesCache::MatchedPropertiesCache(size_t maximumByteSize)
+    : m_useCounter(0)
+    , m_size(0)
+    , m_byteSize(0)
+    , m_maximumByteSize(maximumByteSize)
+{
+}
 
+bool MatchedPropertiesCache::matches(const Entry& entry, unsigned hash, const MatchResult& matchResult)
+{
+    if (entry.hash != hash)
+        return false;
+    const Vector<RefPtr<StylePropertySet>>& cachedProperties = entry.properties.matchedProperties;
     size_t size = matchResult.matchedProperties.size();
-    if (size != cacheItem->matchedProperties.size())
-        return 0;
+    if (size != cachedProperties.size())
+        return false;
     for (size_t i = 0; i < size; ++i) {
-        if (matchResult.matchedProperties[i] != cacheItem->matchedProperties[i])
-            return 0;
+        if (matchResult.matchedProperties[i] != cachedProperties[i])
+            return false;
     }
-    return cacheItem;
+    return true;
+}
+
+size_t MatchedPropertiesCache::byteSizeOf(const MatchResult& matchResult)
+{
+    return sizeof(Entry)
+        + matchResult.matchedProperties.size() * sizeof(RefPtr<StylePropertySet>)
+        + 2 * renderStyleByteSize();
 }
 
-void MatchedPropertiesCache::add(const RenderStyle* style, const RenderStyle* parentStyle, unsigned hash, const MatchResult& matchResult)
+MatchedPropertiesCache::Entry* MatchedPropertiesCache::bucket(unsigned hash)
 {
-    static const unsigned maxAdditionsBetweenSweeps = 100;
-    if (++m_additionsSinceLastSweep >= maxAdditionsBetweenSweeps
-        && !m_sweepTimer.isActive()) {
-        static const unsigned sweepTimeInSeconds = 60;
-        m_sweepTimer.startOneShot(sweepTimeInSeconds, FROM_HERE);
+    if (m_entries.isEmpty())
+        m_entries.grow(bucketCount * waysPerBucket);
+    return &m_entries[(hash % bucketCount) * waysPerBucket];
+}
+
+const CachedMatchedProperties* MatchedPropertiesCache::find(unsigned hash, const MatchResult& matchResult)
+{
+    ASSERT(hash);
+
+    if (!m_size)
+        return 0;
+
+    Entry* ways = bucket(hash);
+    for (unsigned i = 0; i < waysPerBucket; ++i) {
+        Entry& entry = ways[i];
+        if (!matches(entry, hash, matchResult))
+            continue;
+        entry.lastUse = ++m_useCounter;
+        return &entry.properties;
     }
+    return 0;
+}
 
+MatchedPropertiesCache::AddResult MatchedPropertiesCache::add(const RenderStyle* style, const RenderStyle* parentStyle, unsigned hash, const MatchResult& matchResult)
+{
     ASSERT(hash);
-    Cache::AddResult addResult = m_cache.add(hash, nullptr);
-    if (addResult.isNewEntry)
-        addResult.storedValue->value = adoptPtr(new CachedMatchedProperties);
 
-    CachedMatchedProperties* cacheItem = addResult.storedValue->value.get();
-    if (!addResult.isNewEntry)
-        cacheItem->clear();
+    Entry* ways = bucket(hash);
+    Entry* target = 0;
+    AddResult result = AddedEntry;
+    for (unsigned i = 0; i < waysPerBucket; ++i) {
+        if (matches(ways[i], hash, matchResult)) {
+            target = &ways[i];
+            result = ReplacedIdenticalEntry;
+            break;
+        }
+        if (ways[i].hash == hash)
+            result = AddedCollidingEntry;
+    }
+    if (!target) {
+        target = findVictim(ways);
+        if (target->hash)
+            result = ReplacedEvictedEntry;
+    }
+    if (target->hash)
+        remove(*target);
+
+    size_t byteSize = byteSizeOf(matchResult);
+    evictToFitByteBudget(byteSize);
+
+    target->properties.set(style, parentStyle, matchResult);
+    target->hash = hash;
+    target->lastUse = ++m_useCounter;
+    target->byteSize = byteSize;
+    ++m_size;
+    m_byteSize += byteSize;
+    return result;
+}
+
+MatchedPropertiesCache::Entry* MatchedPropertiesCache::findVictim(Entry* ways)
+{
+    Entry* victim = 0;
+    for (unsigned i = 0; i < waysPerBucket; ++i) {
+        Entry& entry = ways[i];
+        if (!entry.hash || holdsLastReference(entry.properties))
+            return &entry;
+        if (!victim || entry.lastUse < victim->lastUse)
+            victim = &entry;
+    }
+    return victim;
+}
+
+void MatchedPropertiesCache::remove(Entry& entry)
+{
+    ASSERT(entry.hash);
+    ASSERT(m_size);
+    ASSERT(m_byteSize >= entry.byteSize);
+    --m_size;
+    m_byteSize -= entry.byteSize;
+    entry.hash = 0;
+    entry.lastUse = 0;
+    entry.byteSize = 0;
+    entry.properties.clear();
+}
 
-    cacheItem->set(style, parentStyle, matchResult);
+void MatchedPropertiesCache::evictToFitByteBudget(size_t byteSize)
+{
+    while (m_size && m_byteSize + byteSize > m_maximumByteSize) {
+        Entry* victim = 0;
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            Entry& entry = m_entries[i];
+            if (entry.hash && (!victim || entry.lastUse < victim->lastUse))
+                victim = &entry;
+        }
+        remove(*victim);
+    }
 }
 
 void MatchedPropertiesCache::clear()
 {
-    m_cache.clear();
+    m_entries.clear();
+    m_size = 0;
+    m_byteSize = 0;
 }
 
 void MatchedPropertiesCache::clearViewportDependent()
 {
-    Vector<unsigned, 16> toRemove;
-    for (Cache::iterator it = m_cache.begin(); it != m_cache.end(); ++it) {
-        CachedMatchedProperties* cacheItem = it->value.get();
-        if (cacheItem->renderStyle->hasViewportUnits())
-            toRemove.append(it->key);
-    }
-    m_cache.removeAll(toRemove);
-}
-
-void MatchedPropertiesCache::sweep(Timer<MatchedPropertiesCache>*)
-{
-    // FIXME(sky): Do we still need this now that we removed PresentationAttributeStyle?
-    Vector<unsigned, 16> toRemove;
-    Cache::iterator it = m_cache.begin();
-    Cache::iterator end = m_cache.end();
-    for (; it != end; ++it) {
-        CachedMatchedProperties* cacheItem = it->value.get();
-        Vector<RefPtr<StylePropertySet>>& matchedProperties = cacheItem->matchedProperties;
-        for (size_t i = 0; i < matchedProperties.size(); ++i) {
-            if (matchedProperties[i]->hasOneRef()) {
-                toRemove.append(it->key);
-                break;
-            }
-        }
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        Entry& entry = m_entries[i];
+        if (entry.hash && entry.properties.renderStyle->hasViewportUnits())
+            remove(entry);
     }
-    m_cache.removeAll(toRemove);
-    m_additionsSinceLastSweep = 0;
 }
 
 bool MatchedPropertiesCache::isCacheable(const Element* element, const RenderStyle* style, const RenderStyle* parentStyle)
@@ -25,16 +25,14 @@
 
 #include "sky/engine/core/css/StylePropertySet.h"
 #include "sky/engine/core/css/resolver/MatchResult.h"
-#include "sky/engine/platform/Timer.h"
 #include "sky/engine/platform/heap/Handle.h"
 #include "sky/engine/wtf/Forward.h"
-#include "sky/engine/wtf/HashMap.h"
 #include "sky/engine/wtf/Noncopyable.h"
+#include "sky/engine/wtf/Vector.h"
 
 namespace blink {
 
 class RenderStyle;
-class StyleResolverState;
 
 class CachedMatchedProperties final {
 public:
@@ -46,30 +44,67 @@ public:
     void clear();
 };
 
+// A set-associative cache: the hash of the matched properties picks a bucket
+// and the entry can live in any of the bucket's ways. When a bucket is full
+// the least recently used way is replaced, preferring entries whose property
+// sets nobody else holds on to, since those can never match again. Entries
+// for different properties can share a hash, each in its own way. On top of
+// that the cache evicts the least recently used entries of any bucket to stay
+// within a byte budget.
 class MatchedPropertiesCache {
     DISALLOW_ALLOCATION();
     WTF_MAKE_NONCOPYABLE(MatchedPropertiesCache);
 public:
-    MatchedPropertiesCache();
+    static const size_t defaultMaximumByteSize;
 
-    const CachedMatchedProperties* find(unsigned hash, const StyleResolverState&, const MatchResult&);
-    void add(const RenderStyle*, const RenderStyle* parentStyle, unsigned hash, const MatchResult&);
+    explicit MatchedPropertiesCache(size_t maximumByteSize = defaultMaximumByteSize);
+
+    enum AddResult {
+        AddedEntry,
+        // Added next to an entry for the same hash but different properties.
+        AddedCollidingEntry,
+        // Replaced an entry for the same properties.
+        ReplacedIdenticalEntry,
+        // Replaced the least recently used entry of a full bucket.
+        ReplacedEvictedEntry,
+    };
+
+    const CachedMatchedProperties* find(unsigned hash, const MatchResult&);
+    AddResult add(const RenderStyle*, const RenderStyle* parentStyle, unsigned hash, const MatchResult&);
 
     void clear();
     void clearViewportDependent();
 
+    unsigned size() const { return m_size; }
+    // What the entries are charged against the budget. See byteSizeOf().
+    size_t byteSize() const { return m_byteSize; }
+
     static bool isCacheable(const Element*, const RenderStyle*, const RenderStyle* parentStyle);
 
 private:
-    // Every N additions to the matched declaration cache trigger a sweep where entries holding
-    // the last reference to a style declaration are garbage collected.
-    void sweep(Timer<MatchedPropertiesCache>*);
+    struct Entry {
+        Entry() : hash(0), lastUse(0), byteSize(0) { }
+
+        // Zero for empty entries, which is why we never cache a zero hash.
+        unsigned hash;
+        uint64_t lastUse;
+        size_t byteSize;
+        CachedMatchedProperties properties;
+    };
+
+    static bool matches(const Entry&, unsigned hash, const MatchResult&);
+    static size_t byteSizeOf(const MatchResult&);
 
-    unsigned m_additionsSinceLastSweep;
+    Entry* bucket(unsigned hash);
+    Entry* findVictim(Entry* bucket);
+    void remove(Entry&);
+    void evictToFitByteBudget(size_t byteSize);
 
-    typedef HashMap<unsigned, OwnPtr<CachedMatchedProperties> > Cache;
-    Timer<MatchedPropertiesCache> m_sweepTimer;
-    Cache m_cache;
+    Vector<Entry> m_entries;
+    uint64_t m_useCounter;
+    unsigned m_size;
+    size_t m_byteSize;
+    size_t m_maximumByteSize;
 };
 
 }
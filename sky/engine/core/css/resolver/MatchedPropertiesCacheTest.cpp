@@ -0,0 +1,160 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/css/resolver/MatchedPropertiesCache.h"
+
+#include "sky/engine/core/css/StylePropertySet.h"
+#include "sky/engine/core/rendering/style/RenderStyle.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+// Hashes that differ by a multiple of this land in the same bucket.
+const unsigned sameBucketStride = 1024;
+
+MatchedPropertiesCache::AddResult add(MatchedPropertiesCache& cache, unsigned hash, StylePropertySet* properties)
+{
+    RefPtr<RenderStyle> style = RenderStyle::create();
+    MatchResult matchResult;
+    matchResult.addMatchedProperties(properties);
+    return cache.add(style.get(), style.get(), hash, matchResult);
+}
+
+bool contains(MatchedPropertiesCache& cache, unsigned hash, StylePropertySet* properties)
+{
+    MatchResult matchResult;
+    matchResult.addMatchedProperties(properties);
+    return cache.find(hash, matchResult);
+}
+
+TEST(MatchedPropertiesCacheTest, FindsMatchingProperties)
+{
+    MatchedPropertiesCache cache;
+    RefPtr<MutableStylePropertySet> first = MutableStylePropertySet::create();
+    RefPtr<MutableStylePropertySet> second = MutableStylePropertySet::create();
+
+    EXPECT_EQ(MatchedPropertiesCache::AddedEntry, add(cache, 1, first.get()));
+    EXPECT_TRUE(contains(cache, 1, first.get()));
+    EXPECT_FALSE(contains(cache, 1, second.get()));
+    EXPECT_FALSE(contains(cache, 2, first.get()));
+    EXPECT_EQ(1u, cache.size());
+    EXPECT_LT(2 * sizeof(RenderStyle), cache.byteSize());
+
+    cache.clear();
+    EXPECT_FALSE(contains(cache, 1, first.get()));
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(0u, cache.byteSize());
+}
+
+TEST(MatchedPropertiesCacheTest, KeepsCollidingEntries)
+{
+    MatchedPropertiesCache cache;
+    RefPtr<MutableStylePropertySet> first = MutableStylePropertySet::create();
+    RefPtr<MutableStylePropertySet> second = MutableStylePropertySet::create();
+
+    EXPECT_EQ(MatchedPropertiesCache::AddedEntry, add(cache, 7, first.get()));
+    EXPECT_EQ(MatchedPropertiesCache::AddedCollidingEntry, add(cache, 7, second.get()));
+    EXPECT_TRUE(contains(cache, 7, first.get()));
+    EXPECT_TRUE(contains(cache, 7, second.get()));
+    EXPECT_EQ(2u, cache.size());
+}
+
+TEST(MatchedPropertiesCacheTest, ReplacesIdenticalEntry)
+{
+    MatchedPropertiesCache cache;
+    RefPtr<MutableStylePropertySet> properties = MutableStylePropertySet::create();
+
+    EXPECT_EQ(MatchedPropertiesCache::AddedEntry, add(cache, 7, properties.get()));
+    EXPECT_EQ(MatchedPropertiesCache::ReplacedIdenticalEntry, add(cache, 7, properties.get()));
+    EXPECT_TRUE(contains(cache, 7, properties.get()));
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST(MatchedPropertiesCacheTest, EvictsLeastRecentlyUsedWay)
+{
+    MatchedPropertiesCache cache;
+    Vector<RefPtr<MutableStylePropertySet>> properties;
+    unsigned added = 0;
+    while (true) {
+        properties.append(MutableStylePropertySet::create());
+        MatchedPropertiesCache::AddResult result = add(cache, 1 + added * sameBucketStride, properties.last().get());
+        if (result == MatchedPropertiesCache::ReplacedEvictedEntry)
+            break;
+        ASSERT_EQ(MatchedPropertiesCache::AddedEntry, result);
+        ++added;
+        // Touch the first entry so that the second one is the oldest.
+        ASSERT_TRUE(contains(cache, 1, properties[0].get()));
+    }
+
+    EXPECT_EQ(added, cache.size());
+    EXPECT_TRUE(contains(cache, 1, properties[0].get()));
+    EXPECT_FALSE(contains(cache, 1 + sameBucketStride, properties[1].get()));
+    EXPECT_TRUE(contains(cache, 1 + added * sameBucketStride, properties.last().get()));
+}
+
+TEST(MatchedPropertiesCacheTest, PrefersEvictingUnreferencedProperties)
+{
+    MatchedPropertiesCache cache;
+    Vector<RefPtr<MutableStylePropertySet>> properties;
+    unsigned ways = 0;
+    while (true) {
+        properties.append(MutableStylePropertySet::create());
+        if (add(cache, 1 + ways * sameBucketStride, properties.last().get()) != MatchedPropertiesCache::AddedEntry)
+            break;
+        ++ways;
+    }
+    ASSERT_LE(3u, ways);
+    cache.clear();
+    properties.clear();
+
+    for (unsigned i = 0; i < ways; ++i) {
+        properties.append(MutableStylePropertySet::create());
+        add(cache, 1 + i * sameBucketStride, properties.last().get());
+    }
+    // Only the cache holds the last way's properties now, so that entry can
+    // never match again and goes first even though the first is older.
+    properties.removeLast();
+
+    properties.append(MutableStylePropertySet::create());
+    EXPECT_EQ(MatchedPropertiesCache::ReplacedEvictedEntry, add(cache, 1 + ways * sameBucketStride, properties.last().get()));
+    EXPECT_EQ(ways, cache.size());
+    for (unsigned i = 0; i + 1 < ways; ++i)
+        EXPECT_TRUE(contains(cache, 1 + i * sameBucketStride, properties[i].get()));
+    EXPECT_TRUE(contains(cache, 1 + ways * sameBucketStride, properties.last().get()));
+}
+
+TEST(MatchedPropertiesCacheTest, EvictsLeastRecentlyUsedEntriesOverBudget)
+{
+    RefPtr<MutableStylePropertySet> first = MutableStylePropertySet::create();
+    RefPtr<MutableStylePropertySet> second = MutableStylePropertySet::create();
+    RefPtr<MutableStylePropertySet> third = MutableStylePropertySet::create();
+
+    size_t entryByteSize;
+    {
+        MatchedPropertiesCache cache;
+        add(cache, 1, first.get());
+        entryByteSize = cache.byteSize();
+    }
+
+    // Room for two entries. The hashes pick different buckets, so only the
+    // budget makes room for the third.
+    MatchedPropertiesCache cache(2 * entryByteSize + entryByteSize / 2);
+    EXPECT_EQ(MatchedPropertiesCache::AddedEntry, add(cache, 1, first.get()));
+    EXPECT_EQ(MatchedPropertiesCache::AddedEntry, add(cache, 2, second.get()));
+    EXPECT_EQ(2 * entryByteSize, cache.byteSize());
+    // Touch the first entry so that the second one is the oldest.
+    ASSERT_TRUE(contains(cache, 1, first.get()));
+
+    EXPECT_EQ(MatchedPropertiesCache::AddedEntry, add(cache, 3, third.get()));
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_EQ(2 * entryByteSize, cache.byteSize());
+    EXPECT_TRUE(contains(cache, 1, first.get()));
+    EXPECT_FALSE(contains(cache, 2, second.get()));
+    EXPECT_TRUE(contains(cache, 3, third.get()));
+}
+
+} // namespace
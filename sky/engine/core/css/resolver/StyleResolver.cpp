@@ -332,7 +332,9 @@ void StyleResolver::applyMatchedProperties(StyleResolverState& state, const Matc
 
     unsigned cacheHash = matchResult.isCacheable ? computeMatchedPropertiesHash(matchResult.matchedProperties.data(), matchResult.matchedProperties.size()) : 0;
     bool applyInheritedOnly = false;
-    const CachedMatchedProperties* cachedMatchedProperties = cacheHash ? m_matchedPropertiesCache.find(cacheHash, state, matchResult) : 0;
+    const CachedMatchedProperties* cachedMatchedProperties = cacheHash ? m_matchedPropertiesCache.find(cacheHash, matchResult) : 0;
+    if (cacheHash && !cachedMatchedProperties)
+        INCREMENT_STYLE_STATS_COUNTER(*this, matchedPropertyCacheMiss);
 
     if (cachedMatchedProperties && MatchedPropertiesCache::isCacheable(element, state.style(), state.parentStyle())) {
         INCREMENT_STYLE_STATS_COUNTER(*this, matchedPropertyCacheHit);
@@ -371,7 +373,11 @@ void StyleResolver::applyMatchedProperties(StyleResolverState& state, const Matc
 
     if (!cachedMatchedProperties && cacheHash && MatchedPropertiesCache::isCacheable(element, state.style(), state.parentStyle())) {
         INCREMENT_STYLE_STATS_COUNTER(*this, matchedPropertyCacheAdded);
-        m_matchedPropertiesCache.add(state.style(), state.parentStyle(), cacheHash, matchResult);
+        MatchedPropertiesCache::AddResult result = m_matchedPropertiesCache.add(state.style(), state.parentStyle(), cacheHash, matchResult);
+        if (result == MatchedPropertiesCache::AddedCollidingEntry)
+            INCREMENT_STYLE_STATS_COUNTER(*this, matchedPropertyCacheCollision);
+        if (result == MatchedPropertiesCache::ReplacedEvictedEntry)
+            INCREMENT_STYLE_STATS_COUNTER(*this, matchedPropertyCacheEviction);
     }
 
     ASSERT(!state.fontBuilder().fontDirty());
@@ -48,6 +48,9 @@ void StyleResolverStats::reset()
     matchedPropertyCacheHit = 0;
     matchedPropertyCacheInheritedHit = 0;
     matchedPropertyCacheAdded = 0;
+    matchedPropertyCacheMiss = 0;
+    matchedPropertyCacheCollision = 0;
+    matchedPropertyCacheEviction = 0;
 }
 
 String StyleResolverStats::report() const
@@ -74,7 +77,10 @@ String StyleResolverStats::report() const
     output.appendLiteral("Matched property cache:\n");
     output.append(String::format("  %u calls to applyMatchedProperties, %u hit the cache (%.2f%%).\n", matchedPropertyApply, matchedPropertyCacheHit, PERCENT(matchedPropertyCacheHit, matchedPropertyApply)));
     output.append(String::format("  %u cache hits also shared the inherited style (%.2f%%).\n", matchedPropertyCacheInheritedHit, PERCENT(matchedPropertyCacheInheritedHit, matchedPropertyCacheHit)));
+    output.append(String::format("  %u cacheable calls to applyMatchedProperties missed the cache (%.2f%%).\n", matchedPropertyCacheMiss, PERCENT(matchedPropertyCacheMiss, matchedPropertyApply)));
     output.append(String::format("  %u styles created in applyMatchedProperties were added to the cache (%.2f%%).\n", matchedPropertyCacheAdded, PERCENT(matchedPropertyCacheAdded, matchedPropertyApply)));
+    output.append(String::format("  %u additions shared their hash with an entry for different properties (%.2f%%).\n", matchedPropertyCacheCollision, PERCENT(matchedPropertyCacheCollision, matchedPropertyCacheAdded)));
+    output.append(String::format("  %u additions evicted the least recently used entry of a full bucket (%.2f%%).\n", matchedPropertyCacheEviction, PERCENT(matchedPropertyCacheEviction, matchedPropertyCacheAdded)));
 
     return output.toString();
 }
@@ -55,6 +55,9 @@ public:
     unsigned matchedPropertyCacheHit;
     unsigned matchedPropertyCacheInheritedHit;
     unsigned matchedPropertyCacheAdded;
+    unsigned matchedPropertyCacheMiss;
+    unsigned matchedPropertyCacheCollision;
+    unsigned matchedPropertyCacheEviction;
 
     // We keep a separate flag for this since crawling the entire document to print
     // the number of missed candidates is very slow.
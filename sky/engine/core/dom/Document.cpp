@@ -209,6 +209,7 @@ Document::Document(const DocumentInit& initializer)
     , m_referrerPolicy(ReferrerPolicyDefault)
     , m_hasViewportUnits(false)
     , m_styleRecalcElementCounter(0)
+    , m_paintGeneration(0)
     , m_frameView(nullptr)
 {
     // We depend on the url getting immediately set in subframes, but we
@@ -400,6 +400,11 @@ public:
 
     void didRecalculateStyleForElement() { ++m_styleRecalcElementCounter; }
 
+    // Bumped whenever something that affects how the render tree paints
+    // changes, so that pictures recorded at an older generation are stale.
+    void invalidatePaint() { ++m_paintGeneration; }
+    unsigned paintGeneration() const { return m_paintGeneration; }
+
     Picture* rootPicture() const;
     void setRootPicture(PassRefPtr<Picture> picture);
 
@@ -529,6 +534,7 @@ private:
     bool m_hasViewportUnits;
 
     int m_styleRecalcElementCounter;
+    unsigned m_paintGeneration;
     mutable DocumentLoadTiming m_documentLoadTiming;
 
     RefPtr<Picture> m_picture;
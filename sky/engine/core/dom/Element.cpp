@@ -69,6 +69,8 @@
 #include "sky/engine/core/rendering/RenderLayer.h"
 #include "sky/engine/core/rendering/RenderView.h"
 #include "sky/engine/platform/EventDispatchForbiddenScope.h"
+#include "sky/engine/platform/TraceEvent.h"
+#include "sky/engine/platform/graphics/DisplayList.h"
 #include "sky/engine/tonic/dart_state.h"
 #include "sky/engine/wtf/BitVector.h"
 #include "sky/engine/wtf/HashFunctions.h"
@@ -1292,13 +1294,38 @@ void Element::paint(Canvas* canvas)
     if (!renderer() || !renderer()->isBox())
         return;
     RenderBox* box = toRenderBox(renderer());
-    GraphicsContext context(canvas->skCanvas());
 
-    // Very simplified painting to allow painting an arbitrary (layer-less) subtree.
-    Vector<RenderBox*> layers;
-    PaintInfo paintInfo(&context, box->absoluteBoundingBoxRect(), box);
-    box->paint(paintInfo, LayoutPoint(), layers);
-    // Note we're ignoring any layers encountered.
+    IntRect bounds = box->absoluteBoundingBoxRect();
+    LayoutRect overflow = box->visualOverflowRect();
+    overflow.moveBy(bounds.location());
+    bounds.unite(enclosingIntRect(overflow));
+
+    SkCanvas* skCanvas = canvas->skCanvas();
+    if (bounds.isEmpty() || skCanvas->quickReject(bounds))
+        return;
+
+    // Nothing that affects painting has changed in the document since we
+    // last recorded this subtree, so replay the recording.
+    unsigned paintGeneration = document().paintGeneration();
+    RefPtr<DisplayList> painting = box->recordedPainting(paintGeneration);
+    if (!painting) {
+        TRACE_EVENT0("blink", "Element::paint");
+        painting = adoptRef(new DisplayList);
+        GraphicsContext context(painting->beginRecording(bounds.size()));
+        context.translate(-bounds.x(), -bounds.y());
+
+        // Very simplified painting to allow painting an arbitrary (layer-less) subtree.
+        Vector<RenderBox*> layers;
+        PaintInfo paintInfo(&context, box->absoluteBoundingBoxRect(), box);
+        box->paint(paintInfo, LayoutPoint(), layers);
+        // Note we're ignoring any layers encountered.
+
+        painting->endRecording();
+        box->setRecordedPainting(painting, paintGeneration);
+    }
+
+    GraphicsContext context(skCanvas);
+    context.drawDisplayList(painting.get(), bounds.location());
 }
 
 } // namespace blink
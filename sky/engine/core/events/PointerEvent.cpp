@@ -77,6 +77,10 @@ PointerEvent::PointerEvent(const WebPointerEvent& event)
     , m_tilt(event.tilt)
 {
     m_timeStamp = event.timeStampMS;
+    for (int i = 0; i < event.historySize; ++i) {
+        HistoricalPosition position = { event.historyX[i], event.historyY[i], event.historyTimeStampMS[i] };
+        m_history.append(position);
+    }
 }
 
 PointerEvent::PointerEvent(const AtomicString& type, const PointerEventInit& initializer)
@@ -106,4 +110,19 @@ PointerEvent::PointerEvent(const AtomicString& type, const PointerEventInit& ini
 {
 }
 
+double PointerEvent::historicalX(unsigned index) const
+{
+    return index < m_history.size() ? m_history[index].x : 0;
+}
+
+double PointerEvent::historicalY(unsigned index) const
+{
+    return index < m_history.size() ? m_history[index].y : 0;
+}
+
+double PointerEvent::historicalTimeStamp(unsigned index) const
+{
+    return index < m_history.size() ? m_history[index].timeStamp : 0;
+}
+
 } // namespace blink
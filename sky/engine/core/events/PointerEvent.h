@@ -7,6 +7,7 @@
 
 #include "sky/engine/core/events/Event.h"
 #include "sky/engine/public/platform/WebInputEvent.h"
+#include "sky/engine/wtf/Vector.h"
 
 namespace blink {
 
@@ -80,7 +81,20 @@ public:
     void setDx(double dx) { m_dx = dx; }
     void setDy(double dy) { m_dy = dy; }
 
+    // The positions of the moves that were coalesced into this one, oldest
+    // first, for velocity tracking.
+    unsigned historySize() const { return m_history.size(); }
+    double historicalX(unsigned index) const;
+    double historicalY(unsigned index) const;
+    double historicalTimeStamp(unsigned index) const;
+
 private:
+    struct HistoricalPosition {
+        double x;
+        double y;
+        double timeStamp;
+    };
+
     PointerEvent();
     explicit PointerEvent(const WebPointerEvent& event);
     PointerEvent(const AtomicString&, const PointerEventInit&);
@@ -107,6 +121,7 @@ private:
     double m_radiusMax;
     double m_orientation;
     double m_tilt;
+    Vector<HistoricalPosition> m_history;
 };
 
 } // namespace blink
@@ -201,6 +201,7 @@ void FrameView::performPreLayoutTasks()
         // TODO(esprehn): This is way too much work, it rebuilds the entire sheet list
         // and does a full document recalc.
         document->styleResolverChanged();
+        m_lastViewportSize = layoutSize();
     }
 
     document->updateRenderTreeIfNeeded();
@@ -306,6 +307,7 @@ void FrameView::layout(bool allowSubtree)
         layer = rootForThisLayout->enclosingLayer();
 
         performLayout(rootForThisLayout, inSubtreeLayout);
+        document->invalidatePaint();
 
         m_layoutSubtreeRoot = 0;
     } // Reset m_layoutSchedulingEnabled to its previous value.
@@ -93,6 +93,11 @@ public:
     void setLayoutSizeFixedToFrameSize(bool isFixed) { m_layoutSizeFixedToFrameSize = isFixed; }
     bool layoutSizeFixedToFrameSize() { return m_layoutSizeFixedToFrameSize; }
 
+    // The layout size at the last layout. LayoutContext shares one view
+    // between many documents, so it swaps this in and out with the document.
+    IntSize lastViewportSize() const { return m_lastViewportSize; }
+    void setLastViewportSize(const IntSize& size) { m_lastViewportSize = size; }
+
     void recalcOverflowAfterStyleChange();
 
     void prepareForDetach();
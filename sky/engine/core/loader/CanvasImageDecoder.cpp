@@ -2,67 +2,271 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <vector>
+
 #include "base/bind.h"
+#include "base/lazy_instance.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/message_loop/message_loop.h"
+#include "base/synchronization/cancellation_flag.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread.h"
+#include "base/trace_event/trace_event.h"
 #include "sky/engine/core/loader/CanvasImageDecoder.h"
 #include "sky/engine/core/painting/CanvasImage.h"
 #include "sky/engine/platform/SharedBuffer.h"
+#include "sky/engine/platform/graphics/DecodedImageCache.h"
 #include "sky/engine/platform/image-decoders/ImageDecoder.h"
 
 namespace blink {
 
+namespace {
+
+// Decoders are spread over a few threads. Each decoder stays on one thread
+// because ImageDecoder and SharedBuffer are not thread safe.
+const size_t kDecodingThreadCount = 2;
+
+// Images smaller than this are only decoded once all of their data has
+// arrived, so that a DecodedImageCache hit skips decoding entirely. Larger
+// images are decoded incrementally as the data arrives.
+const size_t kIncrementalDecodeThreshold = 256 * 1024;
+
+// Owns the decoding threads. They start on first use and are joined by
+// Shutdown(), or when the process exits.
+class DecodingThreadPool {
+ public:
+  DecodingThreadPool() : next_thread_(0), shut_down_(false) {}
+
+  // Returns null once the pool has been shut down.
+  scoped_refptr<base::SingleThreadTaskRunner> NextTaskRunner() {
+    base::AutoLock lock(lock_);
+    if (shut_down_)
+      return nullptr;
+    scoped_ptr<base::Thread>& thread =
+        threads_[next_thread_++ % kDecodingThreadCount];
+    if (!thread) {
+      thread.reset(new base::Thread("ImageDecoderThread"));
+      CHECK(thread->Start());
+    }
+    return thread->task_runner();
+  }
+
+  void Shutdown() {
+    scoped_ptr<base::Thread> threads[kDecodingThreadCount];
+    {
+      base::AutoLock lock(lock_);
+      shut_down_ = true;
+      for (size_t i = 0; i < kDecodingThreadCount; ++i)
+        threads[i] = threads_[i].Pass();
+    }
+    // Join outside the lock. Pending decodes run to completion and their
+    // replies are dropped if the owning thread is gone.
+    for (size_t i = 0; i < kDecodingThreadCount; ++i)
+      threads[i].reset();
+  }
+
+ private:
+  base::Lock lock_;
+  scoped_ptr<base::Thread> threads_[kDecodingThreadCount];
+  size_t next_thread_;
+  bool shut_down_;
+
+  DISALLOW_COPY_AND_ASSIGN(DecodingThreadPool);
+};
+
+base::LazyInstance<DecodingThreadPool> s_decodingThreadPool =
+    LAZY_INSTANCE_INITIALIZER;
+
+base::MemoryPressureListener* s_memoryPressureListener;
+
+void onMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  DecodedImageCache* cache = DecodedImageCache::instance();
+  if (level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL)
+    cache->clear();
+  else
+    cache->reduceMemoryUsage(cache->cacheLimitInBytes() / 2);
+}
+
+}  // namespace
+
+// Owns the ImageDecoder and the encoded data. Everything except Cancel() runs
+// on the decoding thread.
+class CanvasImageDecoder::DecodeJob
+    : public base::RefCountedThreadSafe<DecodeJob> {
+ public:
+  DecodeJob(scoped_refptr<base::SingleThreadTaskRunner> decoding_runner,
+            scoped_refptr<base::SingleThreadTaskRunner> reply_runner,
+            base::WeakPtr<CanvasImageDecoder> owner,
+            const IntSize& target_size)
+      : decoding_runner_(decoding_runner),
+        reply_runner_(reply_runner),
+        owner_(owner),
+        target_size_(target_size) {}
+
+  void AppendData(const void* data, size_t num_bytes) {
+    const char* bytes = static_cast<const char*>(data);
+    scoped_ptr<std::vector<char>> chunk(
+        new std::vector<char>(bytes, bytes + num_bytes));
+    decoding_runner_->PostTask(
+        FROM_HERE, base::Bind(&DecodeJob::AppendDataOnDecodingThread, this,
+                              base::Passed(&chunk)));
+  }
+
+  void Finish() {
+    decoding_runner_->PostTask(
+        FROM_HERE, base::Bind(&DecodeJob::FinishOnDecodingThread, this));
+  }
+
+  void Cancel() { cancelled_.Set(); }
+
+ private:
+  friend class base::RefCountedThreadSafe<DecodeJob>;
+  ~DecodeJob() {}
+
+  void AppendDataOnDecodingThread(scoped_ptr<std::vector<char>> chunk) {
+    if (cancelled_.IsSet())
+      return;
+    if (!buffer_)
+      buffer_ = SharedBuffer::create();
+    buffer_->append(chunk->data(), chunk->size());
+    if (decoder_ || buffer_->size() >= kIncrementalDecodeThreshold)
+      Decode(false);
+  }
+
+  void FinishOnDecodingThread() {
+    if (cancelled_.IsSet())
+      return;
+    if (!buffer_)
+      buffer_ = SharedBuffer::create();
+    DecodedImageCache* cache = DecodedImageCache::instance();
+    DecodedImageCache::Key key(
+        buffer_->data(), buffer_->size(),
+        SkISize::Make(target_size_.width(), target_size_.height()));
+    SkBitmap bitmap;
+    if (!cache->lookup(key, &bitmap) && Decode(true)) {
+      bitmap = decoder_->frameBufferAtIndex(0)->getSkBitmap();
+      bitmap.setImmutable();
+      cache->insert(key, bitmap);
+    }
+    decoder_.clear();
+    buffer_.clear();
+    reply_runner_->PostTask(
+        FROM_HERE,
+        base::Bind(&CanvasImageDecoder::OnDecodeComplete, owner_, bitmap));
+  }
+
+  // Decodes as much of the first frame as the data received so far allows.
+  // Returns true if the first frame is complete.
+  bool Decode(bool all_data_received) {
+    TRACE_EVENT0("sky", "CanvasImageDecoder::Decode");
+    if (!decoder_) {
+      // The decoder can be null if we don't yet have enough data to guess
+      // what type of image this is.
+      decoder_ = ImageDecoder::create(*buffer_, ImageSource::AlphaPremultiplied,
+                                      ImageSource::GammaAndColorProfileIgnored,
+                                      target_size_);
+      if (!decoder_)
+        return false;
+    }
+    decoder_->setData(buffer_.get(), all_data_received);
+    if (decoder_->failed() || !decoder_->frameCount())
+      return false;
+    ImageFrame* frame = decoder_->frameBufferAtIndex(0);
+    return frame && frame->status() == ImageFrame::FrameComplete;
+  }
+
+  scoped_refptr<base::SingleThreadTaskRunner> decoding_runner_;
+  scoped_refptr<base::SingleThreadTaskRunner> reply_runner_;
+  base::WeakPtr<CanvasImageDecoder> owner_;
+  IntSize target_size_;
+  base::CancellationFlag cancelled_;
+
+  RefPtr<SharedBuffer> buffer_;
+  OwnPtr<ImageDecoder> decoder_;
+
+  DISALLOW_COPY_AND_ASSIGN(DecodeJob);
+};
+
 PassRefPtr<CanvasImageDecoder> CanvasImageDecoder::create(
     mojo::ScopedDataPipeConsumerHandle handle,
-    PassOwnPtr<ImageDecoderCallback> callback) {
-  return adoptRef(new CanvasImageDecoder(handle.Pass(), callback));
+    PassOwnPtr<ImageDecoderCallback> callback,
+    unsigned targetWidth,
+    unsigned targetHeight) {
+  return adoptRef(new CanvasImageDecoder(
+      handle.Pass(), callback, IntSize(targetWidth, targetHeight)));
 }
 
 CanvasImageDecoder::CanvasImageDecoder(
     mojo::ScopedDataPipeConsumerHandle handle,
-    PassOwnPtr<ImageDecoderCallback> callback)
+    PassOwnPtr<ImageDecoderCallback> callback,
+    const IntSize& targetSize)
     : callback_(callback), weak_factory_(this) {
   CHECK(callback_);
-  if (!handle.is_valid()) {
+  if (!s_memoryPressureListener) {
+    s_memoryPressureListener =
+        new base::MemoryPressureListener(base::Bind(&onMemoryPressure));
+  }
+  scoped_refptr<base::SingleThreadTaskRunner> decoding_runner;
+  if (handle.is_valid())
+    decoding_runner = s_decodingThreadPool.Get().NextTaskRunner();
+  if (!decoding_runner) {
     base::MessageLoop::current()->PostTask(
         FROM_HERE, base::Bind(&CanvasImageDecoder::RejectCallback,
                               weak_factory_.GetWeakPtr()));
     return;
   }
 
-  buffer_ = SharedBuffer::create();
+  job_ = new DecodeJob(decoding_runner,
+                       base::MessageLoop::current()->task_runner(),
+                       weak_factory_.GetWeakPtr(), targetSize);
   drainer_ = adoptPtr(new mojo::common::DataPipeDrainer(this, handle.Pass()));
 }
 
+// static
+void CanvasImageDecoder::ShutdownDecodingThreads() {
+  s_decodingThreadPool.Get().Shutdown();
+}
+
 CanvasImageDecoder::~CanvasImageDecoder() {
+  if (job_)
+    job_->Cancel();
+}
+
+void CanvasImageDecoder::cancel() {
+  drainer_.clear();
+  if (job_) {
+    job_->Cancel();
+    job_ = nullptr;
+  }
+  callback_.clear();
 }
 
 void CanvasImageDecoder::OnDataAvailable(const void* data, size_t num_bytes) {
-  buffer_->append(static_cast<const char*>(data), num_bytes);
+  job_->AppendData(data, num_bytes);
 }
 
 void CanvasImageDecoder::OnDataComplete() {
-  OwnPtr<ImageDecoder> decoder =
-      ImageDecoder::create(*buffer_.get(), ImageSource::AlphaPremultiplied,
-                           ImageSource::GammaAndColorProfileIgnored);
-  // decoder can be null if the buffer we was empty and we couldn't even guess
-  // what type of image to decode.
-  if (!decoder) {
-    callback_->handleEvent(nullptr);
+  job_->Finish();
+}
+
+void CanvasImageDecoder::OnDecodeComplete(const SkBitmap& bitmap) {
+  job_ = nullptr;
+  if (!callback_)
     return;
-  }
-  decoder->setData(buffer_.get(), true);
-  if (decoder->failed() || decoder->frameCount() == 0) {
+  if (bitmap.isNull()) {
     callback_->handleEvent(nullptr);
     return;
   }
 
   RefPtr<CanvasImage> resultImage = CanvasImage::create();
-  resultImage->setBitmap(decoder->frameBufferAtIndex(0)->getSkBitmap());
+  resultImage->setBitmap(bitmap);
   callback_->handleEvent(resultImage.get());
 }
 
 void CanvasImageDecoder::RejectCallback() {
-  callback_->handleEvent(nullptr);
+  if (callback_)
+    callback_->handleEvent(nullptr);
 }
 
 }  // namespace blink
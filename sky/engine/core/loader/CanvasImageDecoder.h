@@ -1,4 +1,3 @@
-// SKY_ENGINE_CORE_PAINTING_CANVASIMAGE_H_
 // Copyright 2015 The Chromium Authors. All rights reserved.
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
@@ -6,35 +5,51 @@
 #ifndef SKY_ENGINE_CORE_LOADER_CANVASIMAGELOADER_H_
 #define SKY_ENGINE_CORE_LOADER_CANVASIMAGELOADER_H_
 
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "mojo/common/data_pipe_drainer.h"
 #include "sky/engine/core/loader/ImageDecoderCallback.h"
-#include "sky/engine/platform/SharedBuffer.h"
+#include "sky/engine/platform/geometry/IntSize.h"
 #include "sky/engine/tonic/dart_wrappable.h"
 #include "sky/engine/wtf/OwnPtr.h"
 #include "sky/engine/wtf/text/AtomicString.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 
 namespace blink {
 
+// Drains an encoded image from a data pipe and decodes it on a decoding
+// thread as the bytes arrive, then hands the decoded image to the callback
+// on the thread that created the decoder. A non-zero target size lets the
+// decoder downsample while decoding (see ImageDecoder::setTargetSize).
 class CanvasImageDecoder : public mojo::common::DataPipeDrainer::Client,
                            public RefCounted<CanvasImageDecoder>,
                            public DartWrappable {
   DEFINE_WRAPPERTYPEINFO();
  public:
-  static PassRefPtr<CanvasImageDecoder> create(mojo::ScopedDataPipeConsumerHandle handle, PassOwnPtr<ImageDecoderCallback> callback);
+  static PassRefPtr<CanvasImageDecoder> create(mojo::ScopedDataPipeConsumerHandle handle, PassOwnPtr<ImageDecoderCallback> callback, unsigned targetWidth = 0, unsigned targetHeight = 0);
   virtual ~CanvasImageDecoder();
 
+  // Joins the decoding threads. Decoders created afterwards reject their
+  // images. Called from blink::shutdown().
+  static void ShutdownDecodingThreads();
+
+  // Stops reading and decoding. The callback will not be called.
+  void cancel();
+
   // mojo::common::DataPipeDrainer::Client
   void OnDataAvailable(const void*, size_t) override;
   void OnDataComplete() override;
 
  private:
-  CanvasImageDecoder(mojo::ScopedDataPipeConsumerHandle handle, PassOwnPtr<ImageDecoderCallback> callback);
+  class DecodeJob;
+
+  CanvasImageDecoder(mojo::ScopedDataPipeConsumerHandle handle, PassOwnPtr<ImageDecoderCallback> callback, const IntSize& targetSize);
 
+  void OnDecodeComplete(const SkBitmap& bitmap);
   void RejectCallback();
 
   OwnPtr<mojo::common::DataPipeDrainer> drainer_;
-  RefPtr<SharedBuffer> buffer_;
+  scoped_refptr<DecodeJob> job_;
   OwnPtr<ImageDecoderCallback> callback_;
 
   base::WeakPtrFactory<CanvasImageDecoder> weak_factory_;
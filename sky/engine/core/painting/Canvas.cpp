@@ -9,6 +9,7 @@
 #include "sky/engine/core/dom/Document.h"
 #include "sky/engine/core/dom/Element.h"
 #include "sky/engine/core/painting/CanvasImage.h"
+#include "sky/engine/core/painting/Matrix.h"
 #include "sky/engine/core/painting/PaintingTasks.h"
 #include "sky/engine/platform/geometry/IntRect.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -75,36 +76,6 @@ void Canvas::skew(float sx, float sy)
     m_canvas->skew(sx, sy);
 }
 
-// Mappings from SkMatrix-index to input-index.
-static const int kSkMatrixIndexToMatrix4Index[] = {
-    0, 4, 12,
-    1, 5, 13,
-    3, 7, 15,
-};
-
-SkMatrix toSkMatrix(const Float32List& matrix4, ExceptionState& es)
-{
-    ASSERT(matrix4.data());
-    SkMatrix sk_matrix;
-    if (matrix4.num_elements() != 16) {
-        es.ThrowTypeError("Incorrect number of elements in matrix.");
-        return sk_matrix;
-    }
-
-    for (intptr_t i = 0; i < 9; ++i)
-        sk_matrix[i] = matrix4[kSkMatrixIndexToMatrix4Index[i]];
-    return sk_matrix;
-}
-
-Float32List toMatrix4(const SkMatrix& sk_matrix)
-{
-    Float32List matrix4(Dart_NewTypedData(Dart_TypedData_kFloat32, 16));
-    for (intptr_t i = 0; i < 9; ++i)
-        matrix4[kSkMatrixIndexToMatrix4Index[i]] = sk_matrix[i];
-    matrix4[10] = 1.0; // Identity along the z axis.
-    return matrix4;
-}
-
 void Canvas::concat(const Float32List& matrix4, ExceptionState& es)
 {
     if (!m_canvas)
@@ -255,6 +226,20 @@ void Canvas::drawPaintingNode(PaintingNode* paintingNode, const Point& p)
     translate(-p.sk_point.x(), -p.sk_point.y());
 }
 
+void Canvas::drawPoints(SkCanvas::PointMode pointMode, const Paint* paint,
+    const Float32List& points, ExceptionState& es)
+{
+    if (!m_canvas)
+        return;
+    ASSERT(paint);
+    if (points.num_elements() % 2)
+        return es.ThrowRangeError("points must contain an even number of values");
+
+    static_assert(sizeof(SkPoint) == sizeof(float) * 2, "SkPoint doesn't use floats.");
+    m_canvas->drawPoints(pointMode, points.num_elements() / 2,
+        reinterpret_cast<const SkPoint*>(points.data()), paint->paint());
+}
+
 void Canvas::drawAtlas(CanvasImage* atlas,
     const Vector<RSTransform>& transforms, const Vector<Rect>& rects,
     const Vector<SkColor>& colors, SkXfermode::Mode mode,
@@ -284,6 +269,8 @@ void Canvas::drawAtlas(CanvasImage* atlas,
         skRects.append(rect.sk_rect);
     }
 
+    if (!skImage)
+        return;
     m_canvas->drawAtlas(
         skImage.get(),
         skXForms.data(),
@@ -296,5 +283,39 @@ void Canvas::drawAtlas(CanvasImage* atlas,
     );
 }
 
+void Canvas::drawRawAtlas(CanvasImage* atlas,
+    SkXfermode::Mode mode, const Rect& cullRect, Paint* paint,
+    const Float32List& rstTransforms, const Float32List& rects,
+    const Int32List& colors, ExceptionState& es)
+{
+    if (!m_canvas)
+        return;
+    if (rstTransforms.num_elements() % 4)
+        return es.ThrowRangeError("rstTransforms length must be a multiple of four");
+    if (rstTransforms.num_elements() != rects.num_elements())
+        return es.ThrowRangeError("rstTransforms and rects lengths must match");
+    if (colors.num_elements() && colors.num_elements() * 4 != rects.num_elements())
+        return es.ThrowRangeError("if supplied, colors must contain one value per rect");
+
+    // The typed data is handed to Skia as-is, so its layout must match.
+    static_assert(sizeof(SkRSXform) == sizeof(float) * 4, "SkRSXform doesn't use floats.");
+    static_assert(sizeof(SkRect) == sizeof(float) * 4, "SkRect doesn't use floats.");
+    static_assert(sizeof(SkColor) == sizeof(int32_t), "SkColor isn't 32 bits.");
+
+    RefPtr<SkImage> skImage = adoptRef(SkImage::NewFromBitmap(atlas->bitmap()));
+    if (!skImage)
+        return;
+    m_canvas->drawAtlas(
+        skImage.get(),
+        reinterpret_cast<const SkRSXform*>(rstTransforms.data()),
+        reinterpret_cast<const SkRect*>(rects.data()),
+        colors.num_elements() ? reinterpret_cast<const SkColor*>(colors.data()) : nullptr,
+        rects.num_elements() / 4,
+        mode,
+        cullRect.is_null ? nullptr : &cullRect.sk_rect,
+        paint ? &paint->paint() : nullptr
+    );
+}
+
 
 } // namespace blink
@@ -14,6 +14,7 @@
 #include "sky/engine/core/painting/Picture.h"
 #include "sky/engine/core/painting/PictureRecorder.h"
 #include "sky/engine/core/painting/Point.h"
+#include "sky/engine/core/painting/PointMode.h"
 #include "sky/engine/core/painting/RRect.h"
 #include "sky/engine/core/painting/Rect.h"
 #include "sky/engine/core/painting/Size.h"
@@ -21,6 +22,7 @@
 #include "sky/engine/platform/graphics/DisplayList.h"
 #include "sky/engine/tonic/dart_wrappable.h"
 #include "sky/engine/tonic/float32_list.h"
+#include "sky/engine/tonic/int32_list.h"
 #include "sky/engine/wtf/PassRefPtr.h"
 #include "sky/engine/wtf/RefCounted.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -89,11 +91,17 @@ public:
     void drawPicture(Picture* picture);
     void drawDrawable(Drawable* drawable);
     void drawPaintingNode(PaintingNode* paintingNode, const Point& p);
+    void drawPoints(SkCanvas::PointMode pointMode, const Paint* paint,
+        const Float32List& points, ExceptionState&);
 
     void drawAtlas(CanvasImage* atlas,
         const Vector<RSTransform>& transforms, const Vector<Rect>& rects,
         const Vector<SkColor>& colors, SkXfermode::Mode mode,
         const Rect& cullRect, Paint* paint, ExceptionState&);
+    void drawRawAtlas(CanvasImage* atlas,
+        SkXfermode::Mode mode, const Rect& cullRect, Paint* paint,
+        const Float32List& rstTransforms, const Float32List& rects,
+        const Int32List& colors, ExceptionState&);
 
     SkCanvas* skCanvas() { return m_canvas; }
     void clearSkCanvas() { m_canvas = nullptr; }
@@ -0,0 +1,122 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/painting/LayoutContext.h"
+
+#include "sky/engine/core/dom/Document.h"
+#include "sky/engine/core/dom/Element.h"
+#include "sky/engine/core/frame/FrameHost.h"
+#include "sky/engine/core/frame/FrameView.h"
+#include "sky/engine/core/frame/LocalFrame.h"
+#include "sky/engine/core/frame/Settings.h"
+#include "sky/engine/core/rendering/RenderView.h"
+#include "sky/engine/platform/TraceEvent.h"
+#include "sky/engine/platform/geometry/IntRect.h"
+#include "sky/engine/wtf/StdLibExtras.h"
+
+namespace blink {
+
+// Gives |document| the shared frame for as long as the binding lives.
+class LayoutContext::Binding {
+    WTF_MAKE_NONCOPYABLE(Binding);
+public:
+    Binding(LayoutContext& context, Document& document)
+        : m_frame(*context.m_frame)
+        , m_document(document)
+    {
+        // Layout runs with script forbidden, so nothing can reach another
+        // LayoutRoot while a document is bound.
+        ASSERT(!m_frame.document());
+        m_frame.setDocument(&m_document);
+        m_document.setFrame(&m_frame);
+    }
+
+    ~Binding()
+    {
+        ASSERT(!m_frame.view()->isSubtreeLayout());
+        m_document.setFrame(nullptr);
+        m_frame.setDocument(nullptr);
+    }
+
+private:
+    LocalFrame& m_frame;
+    Document& m_document;
+};
+
+LayoutContext& LayoutContext::shared()
+{
+    DEFINE_STATIC_LOCAL(LayoutContext, context, ());
+    return context;
+}
+
+LayoutContext::LayoutContext()
+{
+    m_settings = Settings::create();
+    // Using 14px default to match Material Design English Body1:
+    // http://www.google.com/design/spec/style/typography.html#typography-typeface
+    m_settings->setDefaultFixedFontSize(14);
+    m_settings->setDefaultFontSize(14);
+    m_frameHost = FrameHost::createDummy(m_settings.get());
+    m_frame = LocalFrame::create(nullptr, m_frameHost.get());
+    m_frame->createView(IntSize(), Color::white, false);
+}
+
+LayoutContext::~LayoutContext()
+{
+}
+
+void LayoutContext::attach(Document& document, Element* root)
+{
+    Binding binding(*this, document);
+    document.attach();
+    document.setChild(root, ASSERT_NO_EXCEPTION);
+}
+
+void LayoutContext::layout(Document& document, const IntSize& size, IntSize& lastViewportSize)
+{
+    RenderView* renderView = document.renderView();
+    bool sizeChanged = size != lastViewportSize;
+    if (!sizeChanged && !needsLayout(document))
+        return;
+
+    TRACE_EVENT0("blink", "LayoutContext::layout");
+
+    // The view still has the size of whichever document used it last. Size it
+    // before binding so that only a change in this document's own size
+    // dirties its layout.
+    FrameView* view = m_frame->view();
+    view->setFrameRect(IntRect(IntPoint(), size));
+    view->setLayoutSize(size);
+    view->setLastViewportSize(lastViewportSize);
+
+    Binding binding(*this, document);
+    if (sizeChanged) {
+        if (size.width() == lastViewportSize.width()
+            && renderView
+            && !document.hasViewportUnits()
+            && !renderView->childrenDependOnViewHeight()) {
+            // Only the view's own height and its positioned children depend
+            // on the new height, so skip the resize handling, which restyles
+            // the whole document, and let RenderView take its
+            // positioned-movement-only path.
+            view->setLastViewportSize(size);
+            renderView->setNeedsLayoutForHeightChangeOnly();
+        } else {
+            view->setNeedsLayout();
+        }
+    }
+    document.updateLayout();
+    lastViewportSize = size;
+}
+
+bool LayoutContext::needsLayout(const Document& document)
+{
+    RenderView* renderView = document.renderView();
+    return !renderView
+        || renderView->needsLayout()
+        || document.needsStyleRecalc()
+        || document.childNeedsStyleRecalc();
+}
+
+} // namespace blink
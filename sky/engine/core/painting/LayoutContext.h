@@ -0,0 +1,52 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_PAINTING_LAYOUTCONTEXT_H_
+#define SKY_ENGINE_CORE_PAINTING_LAYOUTCONTEXT_H_
+
+#include "sky/engine/platform/geometry/IntSize.h"
+#include "sky/engine/wtf/Noncopyable.h"
+#include "sky/engine/wtf/OwnPtr.h"
+#include "sky/engine/wtf/RefPtr.h"
+
+namespace blink {
+class Document;
+class Element;
+class FrameHost;
+class LocalFrame;
+class Settings;
+
+// The frame that LayoutRoots lay out their documents in. Documents only need
+// a frame while they are being attached or laid out, so every LayoutRoot
+// borrows the same one instead of building its own Settings, FrameHost,
+// LocalFrame and FrameView.
+class LayoutContext {
+    WTF_MAKE_NONCOPYABLE(LayoutContext);
+public:
+    static LayoutContext& shared();
+
+    // Makes |root| the child of |document| and creates its renderers.
+    void attach(Document& document, Element* root);
+
+    // Lays out |document| at |size|. |lastViewportSize| is the size the
+    // document was last laid out at, and is updated to |size|. Does nothing
+    // if the size is unchanged and the document is clean.
+    void layout(Document& document, const IntSize& size, IntSize& lastViewportSize);
+
+private:
+    class Binding;
+
+    static bool needsLayout(const Document&);
+
+    LayoutContext();
+    ~LayoutContext();
+
+    OwnPtr<Settings> m_settings;
+    OwnPtr<FrameHost> m_frameHost;
+    RefPtr<LocalFrame> m_frame;
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_CORE_PAINTING_LAYOUTCONTEXT_H_
@@ -0,0 +1,85 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/painting/LayoutContext.h"
+
+#include "gen/sky/core/HTMLNames.h"
+#include "sky/engine/bindings/exception_state_placeholder.h"
+#include "sky/engine/core/dom/Document.h"
+#include "sky/engine/core/dom/Element.h"
+#include "sky/engine/core/frame/FrameView.h"
+#include "sky/engine/core/rendering/RenderBox.h"
+#include "sky/engine/core/rendering/RenderView.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+class LayoutContextTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override
+    {
+        m_document = Document::create();
+        m_root = m_document->createElement("div", ASSERT_NO_EXCEPTION);
+        // Neither stretches nor shrinks, so it doesn't depend on the height.
+        m_root->setAttribute(HTMLNames::styleAttr, "height: 10px");
+        context().attach(*m_document, m_root.get());
+        context().layout(*m_document, IntSize(100, 100), m_lastViewportSize);
+        ASSERT_TRUE(renderView());
+        ASSERT_TRUE(m_root->renderBox());
+    }
+
+    virtual void TearDown() override
+    {
+        m_document->detach();
+    }
+
+    LayoutContext& context() { return LayoutContext::shared(); }
+    RenderView* renderView() { return m_document->renderView(); }
+    int layoutCount() { return renderView()->frameView()->layoutCount(); }
+
+    RefPtr<Document> m_document;
+    RefPtr<Element> m_root;
+    IntSize m_lastViewportSize;
+};
+
+TEST_F(LayoutContextTest, UnchangedSizeSkipsLayout)
+{
+    EXPECT_EQ(IntSize(100, 100), m_lastViewportSize);
+    int layouts = layoutCount();
+    context().layout(*m_document, IntSize(100, 100), m_lastViewportSize);
+    EXPECT_EQ(layouts, layoutCount());
+    EXPECT_EQ(IntSize(100, 100), m_lastViewportSize);
+}
+
+TEST_F(LayoutContextTest, HeightOnlyChangeOnlyMovesPositionedObjects)
+{
+    ASSERT_FALSE(renderView()->childrenDependOnViewHeight());
+    int layouts = layoutCount();
+    context().layout(*m_document, IntSize(100, 200), m_lastViewportSize);
+    EXPECT_EQ(layouts + 1, layoutCount());
+    EXPECT_EQ(IntSize(100, 200), m_lastViewportSize);
+    EXPECT_EQ(200, renderView()->height().toInt());
+    EXPECT_TRUE(renderView()->onlyNeededPositionedMovementLayout());
+}
+
+TEST_F(LayoutContextTest, HeightOnlyChangeDoesNotLayOutInFlowChildren)
+{
+    // Move the child out of place. Laying it out again would move it back.
+    RenderBox* child = m_root->renderBox();
+    LayoutPoint location = child->location();
+    child->setLocation(location + LayoutSize(0, 50));
+
+    context().layout(*m_document, IntSize(100, 200), m_lastViewportSize);
+    EXPECT_EQ(location + LayoutSize(0, 50), child->location());
+
+    // A width change lays the children out again.
+    context().layout(*m_document, IntSize(150, 200), m_lastViewportSize);
+    EXPECT_EQ(location, child->location());
+    EXPECT_FALSE(renderView()->onlyNeededPositionedMovementLayout());
+}
+
+} // namespace
@@ -6,12 +6,9 @@
 
 #include "sky/engine/core/dom/Document.h"
 #include "sky/engine/core/dom/Element.h"
-#include "sky/engine/core/frame/FrameView.h"
-#include "sky/engine/core/frame/LocalFrame.h"
-#include "sky/engine/core/frame/Settings.h"
 #include "sky/engine/core/painting/Canvas.h"
+#include "sky/engine/core/painting/LayoutContext.h"
 #include "sky/engine/core/painting/PaintingTasks.h"
-#include "sky/engine/platform/geometry/IntRect.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 
 namespace blink {
@@ -27,19 +24,11 @@ LayoutRoot::LayoutRoot()
     , m_minHeight(0)
     , m_maxHeight(0)
 {
-    m_settings = Settings::create();
-    // Using 14px default to match Material Design English Body1:
-    // http://www.google.com/design/spec/style/typography.html#typography-typeface
-    m_settings->setDefaultFixedFontSize(14);
-    m_settings->setDefaultFontSize(14);
-    m_frameHost = FrameHost::createDummy(m_settings.get());
-    m_frame = LocalFrame::create(nullptr, m_frameHost.get());
-    m_frame->createView(IntSize(), Color::white, false);
 }
 
 LayoutRoot::~LayoutRoot()
 {
-    if (!m_document->needsAttach())
+    if (m_document && !m_document->needsAttach())
         m_document->detach();
 }
 
@@ -53,32 +42,18 @@ Element* LayoutRoot::rootElement() const
 void LayoutRoot::setRootElement(Element* root)
 {
     m_document = &root->document();
-    m_frame->setDocument(m_document.get());
-    m_document->setFrame(m_frame.get());
-
-    m_document->attach();
-    m_document->setChild(root, ASSERT_NO_EXCEPTION);
-
-    m_document->setFrame(nullptr);
-    m_frame->setDocument(nullptr);
+    m_lastViewportSize = IntSize();
+    LayoutContext::shared().attach(*m_document, root);
 }
 
 void LayoutRoot::layout()
 {
-    m_frame->setDocument(m_document.get());
-    m_document->setFrame(m_frame.get());
+    if (!m_document)
+        return;
 
     LayoutUnit maxWidth = std::max(m_minWidth, m_maxWidth);
     LayoutUnit maxHeight = std::max(m_minHeight, m_maxHeight);
-    IntSize maxSize(maxWidth, maxHeight);
-
-    m_frame->view()->setFrameRect(IntRect(IntPoint(), maxSize));
-    m_frame->view()->setLayoutSize(maxSize);
-
-    m_document->updateLayout();
-
-    m_document->setFrame(nullptr);
-    m_frame->setDocument(nullptr);
+    LayoutContext::shared().layout(*m_document, IntSize(maxWidth, maxHeight), m_lastViewportSize);
 }
 
 void LayoutRoot::paint(Canvas* canvas)
@@ -6,9 +6,10 @@
 #define SKY_ENGINE_CORE_PAINTING_LAYOUTROOT_H_
 
 #include "sky/engine/core/dom/Node.h"
-#include "sky/engine/core/frame/FrameHost.h"
 #include "sky/engine/core/painting/Paint.h"
 #include "sky/engine/core/painting/Picture.h"
+#include "sky/engine/platform/geometry/IntSize.h"
+#include "sky/engine/platform/geometry/LayoutUnit.h"
 #include "sky/engine/platform/graphics/DisplayList.h"
 #include "sky/engine/tonic/dart_wrappable.h"
 #include "sky/engine/wtf/PassRefPtr.h"
@@ -18,7 +19,6 @@ namespace blink {
 class Canvas;
 class Document;
 class Element;
-class LocalFrame;
 
 class LayoutRoot : public RefCounted<LayoutRoot>, public DartWrappable {
     DEFINE_WRAPPERTYPEINFO();
@@ -52,11 +52,8 @@ private:
     LayoutUnit m_minHeight;
     LayoutUnit m_maxHeight;
     RefPtr<Document> m_document;
-    RefPtr<LocalFrame> m_frame;
-
-    // TODO(eseidel): All of these should be removed:
-    OwnPtr<Settings> m_settings;
-    OwnPtr<FrameHost> m_frameHost;
+    // The size |m_document| was last laid out at.
+    IntSize m_lastViewportSize;
 };
 
 } // namespace blink
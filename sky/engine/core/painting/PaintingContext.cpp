@@ -8,20 +8,23 @@
 #include "sky/engine/core/dom/Element.h"
 #include "sky/engine/core/painting/PaintingTasks.h"
 #include "sky/engine/platform/geometry/IntRect.h"
+#include "sky/engine/platform/graphics/DisplayList.h"
 
 namespace blink {
 
 PassRefPtr<PaintingContext> PaintingContext::create(PassRefPtr<Element> element, const FloatSize& size)
 {
-    return adoptRef(new PaintingContext(element, size));
+    RefPtr<DisplayList> displayList = adoptRef(new DisplayList);
+    SkCanvas* canvas = displayList->beginRecording(expandedIntSize(size));
+    return adoptRef(new PaintingContext(element, displayList.release(), canvas));
 }
 
 // TODO(iansf): Get rid of PaintingContext, which is only relevant to DOM-based
-//              Sky apps, which are now deprecated.  For now, make the compiler
-//              happy by constructing Canvas with a nullptr.
-PaintingContext::PaintingContext(PassRefPtr<Element> element, const FloatSize& size)
-    : Canvas(nullptr)
+//              Sky apps, which are now deprecated.
+PaintingContext::PaintingContext(PassRefPtr<Element> element, PassRefPtr<DisplayList> displayList, SkCanvas* canvas)
+    : Canvas(canvas)
     , m_element(element)
+    , m_displayList(displayList)
 {
 }
 
@@ -31,6 +34,12 @@ PaintingContext::~PaintingContext()
 
 void PaintingContext::commit()
 {
+    // Only the first commit counts; the recording is over after it.
+    if (!m_displayList)
+        return;
+    m_displayList->endRecording();
+    clearSkCanvas();
+    PaintingTasks::enqueueCommit(m_element, m_displayList.release());
     m_element->document().scheduleVisualUpdate();
 }
 
@@ -11,6 +11,8 @@
 namespace blink {
 class Element;
 
+// Records the custom painting of one element into its own DisplayList,
+// which commit() hands to PaintingTasks.
 class PaintingContext : public Canvas {
 public:
     ~PaintingContext() override;
@@ -19,9 +21,10 @@ public:
     void commit();
 
 private:
-    PaintingContext(PassRefPtr<Element> element, const FloatSize& size);
+    PaintingContext(PassRefPtr<Element> element, PassRefPtr<DisplayList> displayList, SkCanvas* canvas);
 
     RefPtr<Element> m_element;
+    RefPtr<DisplayList> m_displayList;
 };
 
 } // namespace blink
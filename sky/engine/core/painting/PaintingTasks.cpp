@@ -8,7 +8,10 @@
 #include "sky/engine/core/painting/PaintingCallback.h"
 #include "sky/engine/core/painting/PaintingContext.h"
 #include "sky/engine/core/rendering/RenderBox.h"
+#include "sky/engine/platform/TraceEvent.h"
 #include "sky/engine/platform/graphics/DisplayList.h"
+#include "sky/engine/wtf/HashMap.h"
+#include "sky/engine/wtf/MainThread.h"
 #include "sky/engine/wtf/OwnPtr.h"
 #include "sky/engine/wtf/RefPtr.h"
 #include "sky/engine/wtf/Vector.h"
@@ -22,9 +25,6 @@ struct RequestTask {
 
     RefPtr<Element> element;
     OwnPtr<PaintingCallback> callback;
-
-    // Used during serviceRequests.
-    RefPtr<PaintingContext> context;
 };
 
 struct CommitTask {
@@ -35,48 +35,64 @@ struct CommitTask {
     RefPtr<DisplayList> displayList;
 };
 
-static Vector<OwnPtr<RequestTask>>& requests()
-{
-    DEFINE_STATIC_LOCAL(OwnPtr<Vector<OwnPtr<RequestTask>>>, queue, (adoptPtr(new Vector<OwnPtr<RequestTask>>())));
-    return *queue;
-}
+// Painting only ever happens on the main thread.
+struct TaskQueues {
+    Vector<OwnPtr<RequestTask>> requests;
+    Vector<CommitTask> commits;
+};
 
-static Vector<CommitTask>& commits()
+static TaskQueues& queues()
 {
-    DEFINE_STATIC_LOCAL(OwnPtr<Vector<CommitTask>>, queue, (adoptPtr(new Vector<CommitTask>())));
-    return *queue;
+    DEFINE_STATIC_LOCAL(TaskQueues, queues, ());
+    return queues;
 }
 
 } // namespace
 
 void PaintingTasks::enqueueRequest(PassRefPtr<Element> element, PassOwnPtr<PaintingCallback> callback)
 {
-    requests().append(adoptPtr(new RequestTask(element, callback)));
+    ASSERT(isMainThread());
+    queues().requests.append(adoptPtr(new RequestTask(element, callback)));
 }
 
 void PaintingTasks::enqueueCommit(PassRefPtr<Node> node, PassRefPtr<DisplayList> displayList)
 {
-    commits().append(CommitTask(node, displayList));
+    ASSERT(isMainThread());
+    queues().commits.append(CommitTask(node, displayList));
 }
 
 bool PaintingTasks::serviceRequests()
 {
-    if (requests().isEmpty())
+    TaskQueues& queues = blink::queues();
+    if (queues.requests.isEmpty())
         return false;
 
-    for (auto& request : requests()) {
-        RenderObject* renderer = request->element->renderer();
+    TRACE_EVENT1("blink", "PaintingTasks::serviceRequests", "requests", static_cast<int>(queues.requests.size()));
+
+    // Take the whole queue first, so that requests made by the callbacks
+    // wait for the next frame instead of growing the list under us.
+    Vector<OwnPtr<RequestTask>> local;
+    swap(queues.requests, local);
+
+    // Size every context before running any callback, so that all of them
+    // see the render tree as it was when the frame started.
+    Vector<RefPtr<PaintingContext>> contexts(local.size());
+    for (size_t i = 0; i < local.size(); ++i) {
+        RenderObject* renderer = local[i]->element->renderer();
         if (!renderer || !renderer->isBox())
             continue;
-        request->context = PaintingContext::create(request->element, toRenderBox(renderer)->size());
+        contexts[i] = PaintingContext::create(local[i]->element, toRenderBox(renderer)->size());
     }
 
-    Vector<OwnPtr<RequestTask>> local;
-    swap(requests(), local);
-    for (const auto& request : local) {
-        if (!request->context)
+    // The callbacks run Dart, so they run one at a time on this thread, but
+    // each records into its own DisplayList and none of them touches the
+    // render tree until drainCommits().
+    for (size_t i = 0; i < local.size(); ++i) {
+        if (!contexts[i])
             continue;
-        request->callback->handleEvent(request->context.get());
+        // The event's duration is the time this element spent recording.
+        TRACE_EVENT1("blink", "PaintingTasks::serviceRequest", "element", TRACE_STR_COPY(local[i]->element->localName().utf8().data()));
+        local[i]->callback->handleEvent(contexts[i].get());
     }
 
     return true;
@@ -84,14 +100,27 @@ bool PaintingTasks::serviceRequests()
 
 void PaintingTasks::drainCommits()
 {
-    for (auto& commit : commits()) {
+    TaskQueues& queues = blink::queues();
+    if (queues.commits.isEmpty())
+        return;
+
+    TRACE_EVENT1("blink", "PaintingTasks::drainCommits", "commits", static_cast<int>(queues.commits.size()));
+
+    Vector<CommitTask> local;
+    swap(queues.commits, local);
+
+    // Resolve every commit before applying any, so that the render tree
+    // changes all at once. Later commits for a node replace earlier ones.
+    HashMap<RenderBox*, RefPtr<DisplayList>> paintings;
+    for (auto& commit : local) {
         RenderObject* renderer = commit.node->renderer();
         if (!renderer || !renderer->isBox())
-            return;
-        toRenderBox(renderer)->setCustomPainting(commit.displayList.release());
+            continue;
+        paintings.set(toRenderBox(renderer), commit.displayList.release());
     }
 
-    commits().clear();
+    for (auto& painting : paintings)
+        painting.key->setCustomPainting(painting.value.release());
 }
 
 } // namespace blink
@@ -14,12 +14,20 @@ class Element;
 class Node;
 class PaintingCallback;
 
+// Queues the custom painting of elements. Requests made during a frame are
+// serviced together at the start of the next one, each into its own
+// DisplayList, and the resulting commits are applied to the render tree all
+// at once so that a frame never sees half of them.
 class PaintingTasks {
 public:
     static void enqueueRequest(PassRefPtr<Element>, PassOwnPtr<PaintingCallback>);
     static void enqueueCommit(PassRefPtr<Node>, PassRefPtr<DisplayList>);
 
+    // Runs the pending painting callbacks. Requests made by the callbacks
+    // themselves wait for the next frame. Returns whether there were any.
     static bool serviceRequests();
+    // Gives every committed DisplayList to its element's RenderBox. If an
+    // element committed more than once, the last commit wins.
     static void drainCommits();
 
 private:
@@ -0,0 +1,75 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/core/painting/PaintingTasks.h"
+
+#include "gen/sky/core/HTMLNames.h"
+#include "sky/engine/bindings/exception_state_placeholder.h"
+#include "sky/engine/core/dom/Document.h"
+#include "sky/engine/core/dom/Element.h"
+#include "sky/engine/core/dom/Text.h"
+#include "sky/engine/core/painting/LayoutContext.h"
+#include "sky/engine/core/rendering/RenderBox.h"
+#include "sky/engine/platform/geometry/IntSize.h"
+#include "sky/engine/platform/graphics/DisplayList.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+PassRefPtr<DisplayList> createDisplayList()
+{
+    RefPtr<DisplayList> displayList = adoptRef(new DisplayList);
+    displayList->beginRecording(IntSize(10, 10));
+    displayList->endRecording();
+    return displayList.release();
+}
+
+PassRefPtr<Element> createChild(Document& document, Element& parent, const char* style)
+{
+    RefPtr<Element> child = document.createElement("div", ASSERT_NO_EXCEPTION);
+    child->setAttribute(HTMLNames::styleAttr, style);
+    parent.appendChild(child);
+    return child.release();
+}
+
+TEST(PaintingTasksTest, DrainCommitsAppliesEveryCommit)
+{
+    RefPtr<Document> document = Document::create();
+    RefPtr<Element> root = document->createElement("div", ASSERT_NO_EXCEPTION);
+    RefPtr<Element> first = createChild(*document, *root, "height: 10px");
+    RefPtr<Element> paragraph = createChild(*document, *root, "display: paragraph");
+    RefPtr<Text> text = Text::create(*document, "text");
+    paragraph->appendChild(text);
+    RefPtr<Element> last = createChild(*document, *root, "height: 10px");
+
+    LayoutContext& context = LayoutContext::shared();
+    context.attach(*document, root.get());
+    IntSize lastViewportSize;
+    context.layout(*document, IntSize(100, 100), lastViewportSize);
+    ASSERT_TRUE(first->renderBox());
+    ASSERT_TRUE(text->renderer());
+    ASSERT_FALSE(text->renderer()->isBox());
+    ASSERT_TRUE(last->renderBox());
+
+    // The text has no box to paint into, which must not drop the commits
+    // queued after it.
+    RefPtr<DisplayList> replaced = createDisplayList();
+    RefPtr<DisplayList> firstPainting = createDisplayList();
+    RefPtr<DisplayList> lastPainting = createDisplayList();
+    PaintingTasks::enqueueCommit(first, replaced);
+    PaintingTasks::enqueueCommit(text, createDisplayList());
+    PaintingTasks::enqueueCommit(last, lastPainting);
+    PaintingTasks::enqueueCommit(first, firstPainting);
+    PaintingTasks::drainCommits();
+
+    EXPECT_EQ(firstPainting.get(), first->renderBox()->customPainting());
+    EXPECT_EQ(lastPainting.get(), last->renderBox()->customPainting());
+
+    document->detach();
+}
+
+} // namespace
@@ -0,0 +1,18 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+part of dart.sky;
+
+/// How Canvas.drawPoints interprets its points. This list comes from Skia's
+/// SkCanvas.h and the values (order) should be kept in sync.
+enum PointMode {
+  /// Draw each point separately.
+  points,
+
+  /// Draw each pair of points as a line segment.
+  lines,
+
+  /// Draw the points as a connected polyline.
+  polygon,
+}
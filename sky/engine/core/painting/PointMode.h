@@ -0,0 +1,26 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_CORE_PAINTING_POINTMODE_H_
+#define SKY_ENGINE_CORE_PAINTING_POINTMODE_H_
+
+#include "sky/engine/tonic/dart_converter.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+
+namespace blink {
+
+class PointMode {};
+
+template <>
+struct DartConverter<PointMode>
+    : public DartConverterEnum<SkCanvas::PointMode> {};
+
+// If this fails, it's because SkCanvas::PointMode has changed. We need to
+// change PointMode.dart to ensure the PointMode enum is in sync with the C++
+// values.
+COMPILE_ASSERT(SkCanvas::kPolygon_PointMode == 2, Need_to_update_PointMode_dart);
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_CORE_PAINTING_POINTMODE_H_
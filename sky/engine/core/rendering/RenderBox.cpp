@@ -984,6 +984,26 @@ BackgroundBleedAvoidance RenderBox::determineBackgroundBleedAvoidance(GraphicsCo
     return BackgroundBleedClipBackground;
 }
 
+void RenderBox::setCustomPainting(PassRefPtr<DisplayList> customPainting)
+{
+    m_customPainting = customPainting;
+    document().invalidatePaint();
+}
+
+DisplayList* RenderBox::recordedPainting(unsigned paintGeneration) const
+{
+    if (!m_rareData || m_rareData->m_recordedPaintingGeneration != paintGeneration)
+        return 0;
+    return m_rareData->m_recordedPainting.get();
+}
+
+void RenderBox::setRecordedPainting(PassRefPtr<DisplayList> painting, unsigned paintGeneration)
+{
+    RenderBoxRareData& rareData = ensureRareData();
+    rareData.m_recordedPainting = painting;
+    rareData.m_recordedPaintingGeneration = paintGeneration;
+}
+
 void RenderBox::paintCustomPainting(PaintInfo& paintInfo, const LayoutPoint& paintOffset)
 {
     LayoutRect paintRect = borderBoxRect();
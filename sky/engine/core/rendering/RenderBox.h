@@ -26,6 +26,7 @@
 #include "sky/engine/core/rendering/FilterEffectRenderer.h"
 #include "sky/engine/core/rendering/RenderBoxModelObject.h"
 #include "sky/engine/core/rendering/RenderOverflow.h"
+#include "sky/engine/platform/graphics/DisplayList.h"
 
 namespace blink {
 
@@ -49,6 +50,7 @@ public:
         : m_inlineBoxWrapper(0)
         , m_overrideLogicalContentHeight(-1)
         , m_overrideLogicalContentWidth(-1)
+        , m_recordedPaintingGeneration(0)
     {
     }
 
@@ -56,6 +58,11 @@ public:
     InlineBox* m_inlineBoxWrapper;
     LayoutUnit m_overrideLogicalContentHeight;
     LayoutUnit m_overrideLogicalContentWidth;
+
+    // What Element::paint last recorded for this box and its descendants, and
+    // the document's paint generation when it did.
+    RefPtr<DisplayList> m_recordedPainting;
+    unsigned m_recordedPaintingGeneration;
 };
 
 enum LayerType {
@@ -467,7 +474,13 @@ public:
 
     bool hasSameDirectionAs(const RenderBox* object) const { return style()->direction() == object->style()->direction(); }
 
-    void setCustomPainting(PassRefPtr<DisplayList> customPainting) { m_customPainting = customPainting; }
+    void setCustomPainting(PassRefPtr<DisplayList>);
+    DisplayList* customPainting() const { return m_customPainting.get(); }
+
+    // The painting of this box and its descendants that was recorded at
+    // |paintGeneration|, or 0 if there is none.
+    DisplayList* recordedPainting(unsigned paintGeneration) const;
+    void setRecordedPainting(PassRefPtr<DisplayList>, unsigned paintGeneration);
 
 protected:
     virtual void willBeDestroyed() override;
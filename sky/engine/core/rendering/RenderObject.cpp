@@ -1181,6 +1181,7 @@ void RenderObject::setStyle(PassRefPtr<RenderStyle> style)
 
     RefPtr<RenderStyle> oldStyle = m_style.release();
     setStyleInternal(style);
+    document().invalidatePaint();
 
     updateFillImages(oldStyle ? &oldStyle->backgroundLayers() : 0, m_style->backgroundLayers());
 
@@ -44,6 +44,7 @@ RenderView::RenderView(Document* document)
     , m_selectionEndPos(-1)
     , m_renderCounterCount(0)
     , m_hitTestCount(0)
+    , m_heightChangeOnly(false)
 {
     // init RenderObject attributes
     setInline(false);
@@ -120,18 +121,59 @@ bool RenderView::isChildAllowed(RenderObject* child, RenderStyle*) const
     return child->isBox();
 }
 
+static bool hasPercentageHeight(RenderObject* child)
+{
+    return (child->isBox() && toRenderBox(child)->hasRelativeLogicalHeight())
+        || child->style()->logicalHeight().isPercent()
+        || child->style()->logicalMinHeight().isPercent()
+        || child->style()->logicalMaxHeight().isPercent();
+}
+
+bool RenderView::childrenDependOnViewHeight() const
+{
+    // Children stretch to our height in a row, and anything other than a
+    // single column packed at the start places them relative to it.
+    if (style()->flexDirection() != FlowColumn
+        || style()->flexWrap() != FlexNoWrap
+        || style()->justifyContent() != JustifyFlexStart)
+        return true;
+
+    // Children only shrink when they don't fit, so if they fit both before
+    // and after the change their sizes stay the same.
+    LayoutUnit availableHeight = std::min(height(), LayoutUnit(viewHeight())) - borderBottom() - paddingBottom();
+    for (RenderBox* child = firstChildBox(); child; child = child->nextSiblingBox()) {
+        if (child->isOutOfFlowPositioned())
+            continue;
+        if (hasPercentageHeight(child)
+            || child->style()->flexGrow()
+            || child->style()->marginTop().isAuto()
+            || child->style()->marginBottom().isAuto())
+            return true;
+        if (child->frameRect().maxY() + child->marginBottom() > availableHeight)
+            return true;
+    }
+    return false;
+}
+
+void RenderView::setNeedsLayoutForHeightChangeOnly()
+{
+    ASSERT(!childrenDependOnViewHeight());
+    m_heightChangeOnly = true;
+    setNeedsPositionedMovementLayout();
+}
+
 void RenderView::layout()
 {
     SubtreeLayoutScope layoutScope(*this);
 
-    bool relayoutChildren = (!m_frameView || width() != viewWidth() || height() != viewHeight());
+    bool heightChangeOnly = m_heightChangeOnly;
+    m_heightChangeOnly = false;
+    bool relayoutChildren = !m_frameView || width() != viewWidth()
+        || (height() != viewHeight() && !heightChangeOnly);
     if (relayoutChildren) {
         layoutScope.setChildNeedsLayout(this);
         for (RenderObject* child = firstChild(); child; child = child->nextSibling()) {
-            if ((child->isBox() && toRenderBox(child)->hasRelativeLogicalHeight())
-                    || child->style()->logicalHeight().isPercent()
-                    || child->style()->logicalMinHeight().isPercent()
-                    || child->style()->logicalMaxHeight().isPercent())
+            if (hasPercentageHeight(child))
                 layoutScope.setChildNeedsLayout(child);
         }
     }
@@ -270,6 +312,8 @@ void RenderView::setSelection(RenderObject* start, int startPos, RenderObject* e
         m_selectionEnd == end && m_selectionEndPos == endPos)
         return;
 
+    document().invalidatePaint();
+
     RenderObject* os = m_selectionStart;
     RenderObject* stop = rendererAfterPosition(m_selectionEnd, m_selectionEndPos);
     bool exploringBackwards = false;
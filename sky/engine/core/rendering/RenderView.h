@@ -53,6 +53,13 @@ public:
 
     virtual void layout() override;
     virtual void updateLogicalWidth() override;
+
+    // Whether a change in the view's height alone could move or resize any
+    // in-flow child. If not, only our own height and positioned children
+    // need to be laid out again.
+    bool childrenDependOnViewHeight() const;
+    // Makes the next layout after such a change skip the in-flow children.
+    void setNeedsLayoutForHeightChangeOnly();
     virtual void computeLogicalHeight(LayoutUnit logicalHeight, LayoutUnit logicalTop, LogicalExtentComputedValues&) const override;
 
     // The same as the FrameView's layoutHeight/layoutWidth but with null check guards.
@@ -105,6 +112,8 @@ private:
     unsigned m_renderCounterCount;
 
     unsigned m_hitTestCount;
+
+    bool m_heightChangeOnly;
 };
 
 DEFINE_RENDER_OBJECT_TYPE_CASTS(RenderView, isRenderView());
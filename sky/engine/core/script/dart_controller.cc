@@ -8,6 +8,7 @@
 #include "base/logging.h"
 #include "base/single_thread_task_runner.h"
 #include "base/trace_event/trace_event.h"
+#include "gen/sky/platform/RuntimeEnabledFeatures.h"
 #include "sky/engine/bindings/builtin.h"
 #include "sky/engine/bindings/builtin_natives.h"
 #include "sky/engine/bindings/builtin_sky.h"
@@ -57,7 +58,8 @@ void MessageNotifyCallback(Dart_Isolate dest_isolate) {
 
 } // namespace
 
-DartController::DartController() : weak_factory_(this) {
+DartController::DartController()
+    : snapshot_cache_(nullptr), weak_factory_(this) {
 }
 
 DartController::~DartController() {
@@ -81,9 +83,28 @@ void DartController::DidLoadMainLibrary(String name) {
   // TODO(eseidel): We need to load a 404 page instead!
   if (LogIfError(library))
     return;
+
+  // Snapshot before running main so that the snapshot holds only the loaded
+  // program and none of its state.
+  if (snapshot_cache_ && dart_state()->library_loader().record_sources())
+    StoreSnapshot(name);
+
   DartInvokeAppField(library, ToDart("main"), 0, nullptr);
 }
 
+void DartController::StoreSnapshot(const String& name) {
+  TRACE_EVENT0("sky", "DartController::StoreSnapshot");
+  DartLibraryLoader& loader = dart_state()->library_loader();
+
+  uint8_t* buffer = nullptr;
+  intptr_t size = 0;
+  if (!LogIfError(Dart_CreateScriptSnapshot(&buffer, &size))) {
+    snapshot_cache_->Store(name.toUTF8(), loader.loaded_sources(),
+                           std::vector<uint8_t>(buffer, buffer + size));
+  }
+  loader.set_record_sources(false);
+}
+
 void DartController::DidLoadSnapshot() {
   DCHECK(Dart_CurrentIsolate() == nullptr);
   snapshot_loader_ = nullptr;
@@ -107,15 +128,97 @@ void DartController::RunFromSnapshot(
 }
 
 void DartController::RunFromLibrary(const String& name,
+                                    DartLibraryProvider* library_provider,
+                                    DartSnapshotCache* snapshot_cache) {
+  snapshot_cache_ = snapshot_cache;
+  if (!snapshot_cache_) {
+    LoadFromSource(name, library_provider);
+    return;
+  }
+  snapshot_cache_->ReadManifest(
+      name.toUTF8(), base::Bind(&DartController::DidReadManifest,
+                                weak_factory_.GetWeakPtr(), name,
+                                library_provider));
+}
+
+void DartController::DidReadManifest(
+    const String& name,
+    DartLibraryProvider* library_provider,
+    bool found,
+    const DartSnapshotCache::Manifest& manifest) {
+  if (!found) {
+    LoadFromSource(name, library_provider);
+    return;
+  }
+  snapshot_cache_->Validate(
+      library_provider, manifest,
+      base::Bind(&DartController::DidValidateCachedSnapshot,
+                 weak_factory_.GetWeakPtr(), name, library_provider,
+                 manifest));
+}
+
+void DartController::DidValidateCachedSnapshot(
+    const String& name,
+    DartLibraryProvider* library_provider,
+    const DartSnapshotCache::Manifest& manifest,
+    bool valid) {
+  if (!valid) {
+    LoadFromSource(name, library_provider);
+    return;
+  }
+  snapshot_cache_->ReadSnapshot(
+      name.toUTF8(), manifest,
+      base::Bind(&DartController::DidReadCachedSnapshot,
+                 weak_factory_.GetWeakPtr(), name, library_provider));
+}
+
+void DartController::DidReadCachedSnapshot(
+    const String& name,
+    DartLibraryProvider* library_provider,
+    bool found,
+    const std::vector<uint8_t>& snapshot) {
+  if (found && LoadCachedSnapshot(name, snapshot))
+    return;
+  LoadFromSource(name, library_provider);
+}
+
+bool DartController::LoadCachedSnapshot(const String& name,
+                                        const std::vector<uint8_t>& snapshot) {
+  TRACE_EVENT0("sky", "DartController::LoadCachedSnapshot");
+  DartIsolateScope isolate_scope(dart_state()->isolate());
+  DartApiScope dart_api_scope;
+
+  if (LogIfError(Dart_LoadScriptFromSnapshot(snapshot.data(),
+                                             snapshot.size()))) {
+    snapshot_cache_->Remove(name.toUTF8());
+    return false;
+  }
+
+  Dart_Handle library = Dart_RootLibrary();
+  if (LogIfError(library))
+    return true;
+  DartInvokeAppField(library, ToDart("main"), 0, nullptr);
+  return true;
+}
+
+void DartController::LoadFromSource(const String& name,
                                     DartLibraryProvider* library_provider) {
   DartState::Scope scope(dart_state());
-  CreateEmptyRootLibraryIfNeeded();
-
   DartLibraryLoader& loader = dart_state()->library_loader();
   loader.set_library_provider(library_provider);
+  loader.set_prefetch_enabled(
+      RuntimeEnabledFeatures::dartLibraryPrefetchEnabled());
 
   DartDependencyCatcher dependency_catcher(loader);
-  loader.LoadLibrary(name.toUTF8());
+  // A script snapshot holds the root library and everything it imports, so
+  // the main library has to be the root library for it to be cached.
+  if (snapshot_cache_ && Dart_IsNull(Dart_RootLibrary())) {
+    loader.set_record_sources(true);
+    loader.LoadScript(name.toUTF8());
+  } else {
+    CreateEmptyRootLibraryIfNeeded();
+    loader.LoadLibrary(name.toUTF8());
+  }
   loader.WaitForDependencies(dependency_catcher.dependencies(),
                              base::Bind(&DartController::DidLoadMainLibrary,
                                         weak_factory_.GetWeakPtr(), name));
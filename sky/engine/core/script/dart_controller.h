@@ -10,6 +10,7 @@
 #include "base/memory/weak_ptr.h"
 #include "dart/runtime/include/dart_api.h"
 #include "mojo/public/cpp/system/data_pipe.h"
+#include "sky/engine/tonic/dart_snapshot_cache.h"
 #include "sky/engine/wtf/OwnPtr.h"
 #include "sky/engine/wtf/text/AtomicString.h"
 #include "sky/engine/wtf/text/TextPosition.h"
@@ -31,8 +32,12 @@ class DartController {
 
   static void InitVM();
 
+  // If |snapshot_cache| is not null, it is used to skip loading the sources
+  // when they haven't changed since the last run. It must outlive the
+  // DartController.
   void RunFromLibrary(const String& name,
-                      DartLibraryProvider* library_provider);
+                      DartLibraryProvider* library_provider,
+                      DartSnapshotCache* snapshot_cache);
   void RunFromSnapshot(mojo::ScopedDataPipeConsumerHandle snapshot);
 
   void CreateIsolateFor(PassOwnPtr<DOMDartState> dom_dart_state);
@@ -42,12 +47,30 @@ class DartController {
   DOMDartState* dart_state() const { return dom_dart_state_.get(); }
 
  private:
+  void LoadFromSource(const String& name,
+                      DartLibraryProvider* library_provider);
+  void DidReadManifest(const String& name,
+                       DartLibraryProvider* library_provider,
+                       bool found,
+                       const DartSnapshotCache::Manifest& manifest);
+  void DidValidateCachedSnapshot(const String& name,
+                                 DartLibraryProvider* library_provider,
+                                 const DartSnapshotCache::Manifest& manifest,
+                                 bool valid);
+  void DidReadCachedSnapshot(const String& name,
+                             DartLibraryProvider* library_provider,
+                             bool found,
+                             const std::vector<uint8_t>& snapshot);
+  bool LoadCachedSnapshot(const String& name,
+                          const std::vector<uint8_t>& snapshot);
+  void StoreSnapshot(const String& name);
   void DidLoadMainLibrary(String url);
   void DidLoadSnapshot();
 
   OwnPtr<DOMDartState> dom_dart_state_;
   OwnPtr<BuiltinSky> builtin_sky_;
   OwnPtr<DartSnapshotLoader> snapshot_loader_;
+  DartSnapshotCache* snapshot_cache_;
 
   base::WeakPtrFactory<DartController> weak_factory_;
 
@@ -6,7 +6,9 @@
 
 #include "base/bind.h"
 #include "base/logging.h"
+#include "base/sha1.h"
 #include "base/single_thread_task_runner.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/trace_event/trace_event.h"
 #include "dart/runtime/bin/embedded_dart_io.h"
 #include "dart/runtime/include/dart_mirrors_api.h"
@@ -197,4 +199,19 @@ void InitDartVM() {
   Dart_ServiceWaitForLoadPort();
 }
 
+const std::string& DartBuildIdentity() {
+  // Computed once, on first use, and leaked.
+  static const std::string* identity = nullptr;
+  if (!identity) {
+    unsigned char digest[base::kSHA1Length];
+    base::SHA1HashBytes(kDartIsolateSnapshotBuffer, kDartIsolateSnapshotSize,
+                        digest);
+    std::string text = Dart_VersionString();
+    text += " ";
+    text += base::HexEncode(digest, sizeof(digest));
+    identity = new std::string(text);
+  }
+  return *identity;
+}
+
 } // namespace blink
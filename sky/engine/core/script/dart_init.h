@@ -5,14 +5,20 @@
 #ifndef SKY_ENGINE_CORE_SCRIPT_DART_INIT_H_
 #define SKY_ENGINE_CORE_SCRIPT_DART_INIT_H_
 
+#include <string>
+
 #include "dart/runtime/include/dart_api.h"
 
 namespace blink {
 
 extern const uint8_t* kDartVmIsolateSnapshotBuffer;
 extern const uint8_t* kDartIsolateSnapshotBuffer;
+extern const size_t kDartIsolateSnapshotSize;
 
 void InitDartVM();
+// Identifies the VM and the engine's Dart libraries, which script snapshots
+// depend on.
+const std::string& DartBuildIdentity();
 Dart_Handle DartLibraryTagHandler(Dart_LibraryTag tag,
                                   Dart_Handle library,
                                   Dart_Handle url);
@@ -4,6 +4,8 @@
 
 #include "sky/engine/core/view/View.h"
 
+#include "sky/engine/core/painting/PaintingTasks.h"
+
 namespace blink {
 
 PassRefPtr<View> View::create(const base::Closure& scheduleFrameCallback)
@@ -67,6 +69,11 @@ void View::handleInputEvent(PassRefPtr<Event> event)
 
 void View::beginFrame(base::TimeTicks frameTime)
 {
+    // Custom painting requested since the last frame is recorded and
+    // committed first, so that this frame's painting sees all of it.
+    PaintingTasks::serviceRequests();
+    PaintingTasks::drainCommits();
+
     if (!m_frameCallback)
         return;
     double frameTimeMS = (frameTime - base::TimeTicks()).InMillisecondsF();
@@ -77,6 +77,8 @@ public:
 
     FontOrientation orientation() const { return m_orientation; }
     void setOrientation(FontOrientation orientation) { m_orientation = orientation; }
+    bool syntheticBold() const { return m_syntheticBold; }
+    bool syntheticItalic() const { return m_syntheticItalic; }
     void setSyntheticBold(bool syntheticBold) { m_syntheticBold = syntheticBold; }
     void setSyntheticItalic(bool syntheticItalic) { m_syntheticItalic = syntheticItalic; }
     bool operator==(const FontPlatformData&) const;
@@ -0,0 +1,228 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/fonts/harfbuzz/HarfBuzzShapeCache.h"
+
+#include <string.h>
+#include <algorithm>
+
+#include "sky/engine/platform/TraceEvent.h"
+#include "sky/engine/wtf/FastMalloc.h"
+#include "sky/engine/wtf/HashFunctions.h"
+#include "sky/engine/wtf/StdLibExtras.h"
+#include "sky/engine/wtf/StringHasher.h"
+
+namespace blink {
+
+namespace {
+
+const size_t initialTableSize = 1024;
+const size_t chunkSize = 64 * 1024;
+const size_t entryAlignment = 8;
+
+inline size_t roundUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+struct HarfBuzzShapeCache::Entry {
+    unsigned hash;
+    unsigned length;
+    unsigned glyphCount;
+    FontKey key;
+    // Followed by |length| UChars and then |glyphCount| Glyphs.
+};
+
+const size_t HarfBuzzShapeCache::defaultMaxBytes = 1024 * 1024;
+
+bool HarfBuzzShapeCache::FontKey::operator==(const FontKey& other) const
+{
+    return fontID == other.fontID
+        && size == other.size
+        && flags == other.flags
+        && featuresHash == other.featuresHash
+        && localeHash == other.localeHash
+        && script == other.script
+        && direction == other.direction;
+}
+
+HarfBuzzShapeCache& HarfBuzzShapeCache::instance()
+{
+    DEFINE_STATIC_LOCAL(HarfBuzzShapeCache, cache, ());
+    return cache;
+}
+
+HarfBuzzShapeCache::HarfBuzzShapeCache(size_t maxBytes)
+    : m_entryCount(0)
+    , m_chunkCursor(0)
+    , m_chunkRemaining(0)
+    , m_arenaBytes(0)
+    , m_maxBytes(maxBytes)
+{
+    m_table.resize(initialTableSize);
+    m_table.fill(0);
+}
+
+HarfBuzzShapeCache::~HarfBuzzShapeCache()
+{
+    clear();
+}
+
+unsigned HarfBuzzShapeCache::hash(const FontKey& key, const UChar* word, unsigned length)
+{
+    COMPILE_ASSERT(sizeof(FontKey) == 7 * sizeof(uint32_t), FontKey_has_no_padding);
+    return WTF::pairIntHash(StringHasher::hashMemory<sizeof(FontKey)>(&key),
+        StringHasher::computeHash(word, length));
+}
+
+size_t HarfBuzzShapeCache::entrySize(unsigned length, unsigned glyphCount)
+{
+    size_t glyphsOffset = roundUp(sizeof(Entry) + length * sizeof(UChar), sizeof(int32_t));
+    return roundUp(glyphsOffset + glyphCount * sizeof(Glyph), entryAlignment);
+}
+
+const UChar* HarfBuzzShapeCache::entryCharacters(const Entry* entry)
+{
+    return reinterpret_cast<const UChar*>(entry + 1);
+}
+
+const HarfBuzzShapeCache::Glyph* HarfBuzzShapeCache::entryGlyphs(const Entry* entry)
+{
+    size_t glyphsOffset = roundUp(sizeof(Entry) + entry->length * sizeof(UChar), sizeof(int32_t));
+    return reinterpret_cast<const Glyph*>(reinterpret_cast<const char*>(entry) + glyphsOffset);
+}
+
+size_t HarfBuzzShapeCache::findSlot(unsigned hash, const FontKey& key, const UChar* word, unsigned length) const
+{
+    size_t mask = m_table.size() - 1;
+    for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+        const Entry* entry = m_table[slot];
+        if (!entry)
+            return slot;
+        if (entry->hash == hash
+            && entry->length == length
+            && entry->key == key
+            && !memcmp(entryCharacters(entry), word, length * sizeof(UChar)))
+            return slot;
+    }
+}
+
+const HarfBuzzShapeCache::Glyph* HarfBuzzShapeCache::find(const FontKey& key, const UChar* word, unsigned length, unsigned* glyphCount)
+{
+    const Entry* entry = m_table[findSlot(hash(key, word, length), key, word, length)];
+    if (!entry) {
+        ++m_stats.misses;
+        return 0;
+    }
+    ++m_stats.hits;
+    *glyphCount = entry->glyphCount;
+    return entryGlyphs(entry);
+}
+
+void HarfBuzzShapeCache::add(const FontKey& key, const UChar* word, unsigned length, const Glyph* glyphs, unsigned glyphCount)
+{
+    size_t size = entrySize(length, glyphCount);
+    if (size > m_maxBytes / 2)
+        return;
+
+    size_t growth = size > m_chunkRemaining ? std::max(size, chunkSize) : 0;
+    if (needsToGrow(m_entryCount + 1))
+        growth += m_table.size() * sizeof(Entry*);
+    if (byteCount() + growth > m_maxBytes) {
+        clear();
+        ++m_stats.resets;
+    }
+
+    unsigned entryHash = hash(key, word, length);
+    size_t slot = findSlot(entryHash, key, word, length);
+    if (m_table[slot])
+        return;
+
+    Entry* entry = static_cast<Entry*>(allocate(size));
+    entry->hash = entryHash;
+    entry->length = length;
+    entry->glyphCount = glyphCount;
+    entry->key = key;
+    memcpy(const_cast<UChar*>(entryCharacters(entry)), word, length * sizeof(UChar));
+    memcpy(const_cast<Glyph*>(entryGlyphs(entry)), glyphs, glyphCount * sizeof(Glyph));
+
+    m_table[slot] = entry;
+    ++m_entryCount;
+    if (needsToGrow(m_entryCount))
+        grow();
+
+    TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("blink.fonts"), "HarfBuzzShapeCacheBytes", byteCount());
+}
+
+bool HarfBuzzShapeCache::needsToGrow(unsigned entryCount) const
+{
+    // Keep the load factor under 3/4 so that probe sequences stay short.
+    return entryCount * 4 > m_table.size() * 3;
+}
+
+void* HarfBuzzShapeCache::allocate(size_t size)
+{
+    ASSERT(!(size % entryAlignment));
+    if (size > m_chunkRemaining) {
+        size_t newChunkSize = std::max(size, chunkSize);
+        char* chunk = static_cast<char*>(fastMalloc(newChunkSize));
+        m_chunks.append(chunk);
+        m_chunkCursor = chunk;
+        m_chunkRemaining = newChunkSize;
+        m_arenaBytes += newChunkSize;
+    }
+    void* result = m_chunkCursor;
+    m_chunkCursor += size;
+    m_chunkRemaining -= size;
+    return result;
+}
+
+void HarfBuzzShapeCache::grow()
+{
+    Vector<Entry*> oldTable;
+    oldTable.swap(m_table);
+    m_table.resize(oldTable.size() * 2);
+    m_table.fill(0);
+    size_t mask = m_table.size() - 1;
+    for (size_t i = 0; i < oldTable.size(); ++i) {
+        Entry* entry = oldTable[i];
+        if (!entry)
+            continue;
+        size_t slot = entry->hash & mask;
+        while (m_table[slot])
+            slot = (slot + 1) & mask;
+        m_table[slot] = entry;
+    }
+}
+
+void HarfBuzzShapeCache::clear()
+{
+    for (size_t i = 0; i < m_chunks.size(); ++i)
+        fastFree(m_chunks[i]);
+    m_chunks.clear();
+    m_chunkCursor = 0;
+    m_chunkRemaining = 0;
+    m_arenaBytes = 0;
+
+    m_table.resize(initialTableSize);
+    m_table.shrinkToFit();
+    m_table.fill(0);
+    m_entryCount = 0;
+}
+
+void HarfBuzzShapeCache::setMaxBytes(size_t maxBytes)
+{
+    m_maxBytes = maxBytes;
+    if (byteCount() > m_maxBytes)
+        clear();
+}
+
+size_t HarfBuzzShapeCache::byteCount() const
+{
+    return m_arenaBytes + m_table.size() * sizeof(Entry*);
+}
+
+} // namespace blink
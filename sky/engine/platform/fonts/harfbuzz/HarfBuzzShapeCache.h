@@ -0,0 +1,135 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_PLATFORM_FONTS_HARFBUZZ_HARFBUZZSHAPECACHE_H_
+#define SKY_ENGINE_PLATFORM_FONTS_HARFBUZZ_HARFBUZZSHAPECACHE_H_
+
+#include <stdint.h>
+
+#include "hb.h"
+#include "sky/engine/platform/PlatformExport.h"
+#include "sky/engine/wtf/Noncopyable.h"
+#include "sky/engine/wtf/Vector.h"
+#include "sky/engine/wtf/unicode/Unicode.h"
+
+namespace blink {
+
+// FUNCTION
+//
+// HarfBuzzShapeCache holds the shaping results of single words. Line breaking
+// at a new width reshapes runs that start and end at different places, but
+// the words in them are the same, so caching words rather than whole runs
+// keeps the hit rate high when text is laid out again.
+//
+// Entries are keyed by everything that affects shaping (see FontKey) and the
+// word's characters. The table is open-addressed, and the characters and
+// glyphs of each entry live in an arena of large chunks, so a lookup never
+// allocates.
+//
+// The cache is bounded by bytes rather than entries. Entries can't be freed
+// from the arena individually, so when the budget is exceeded the whole cache
+// is dropped and refilled from the text being shaped.
+//
+// THREAD SAFETY
+//
+// The cache is used only by HarfBuzzShaper, on the main thread.
+
+class PLATFORM_EXPORT HarfBuzzShapeCache {
+    WTF_MAKE_NONCOPYABLE(HarfBuzzShapeCache);
+public:
+    // Everything other than the text that affects how a word is shaped.
+    struct FontKey {
+        FontKey()
+            : fontID(0)
+            , size(0)
+            , flags(0)
+            , featuresHash(0)
+            , localeHash(0)
+            , script(HB_SCRIPT_INVALID)
+            , direction(HB_DIRECTION_INVALID)
+        {
+        }
+
+        bool operator==(const FontKey&) const;
+
+        uint32_t fontID;
+        float size;
+        unsigned flags;
+        unsigned featuresHash;
+        unsigned localeHash;
+        hb_script_t script;
+        hb_direction_t direction;
+    };
+
+    // One shaped glyph, in visual order. |cluster| is relative to the start
+    // of the word, and positions are in HarfBuzz's 16.16 fixed point.
+    struct Glyph {
+        uint16_t glyph;
+        uint32_t cluster;
+        int32_t advance;
+        int32_t offsetX;
+        int32_t offsetY;
+    };
+
+    struct Stats {
+        Stats() : hits(0), misses(0), resets(0) { }
+        uint64_t hits;
+        uint64_t misses;
+        // How many times the cache was dropped for exceeding its budget.
+        uint64_t resets;
+    };
+
+    static HarfBuzzShapeCache& instance();
+
+    static const size_t defaultMaxBytes;
+
+    explicit HarfBuzzShapeCache(size_t maxBytes = defaultMaxBytes);
+    ~HarfBuzzShapeCache();
+
+    // Returns the glyphs for |word| and stores their number in |glyphCount|,
+    // or returns 0 if the word isn't cached. The glyphs stay valid until the
+    // next call to add() or clear().
+    const Glyph* find(const FontKey&, const UChar* word, unsigned length, unsigned* glyphCount);
+    void add(const FontKey&, const UChar* word, unsigned length, const Glyph*, unsigned glyphCount);
+    void clear();
+
+    size_t maxBytes() const { return m_maxBytes; }
+    void setMaxBytes(size_t);
+    size_t byteCount() const;
+    unsigned entryCount() const { return m_entryCount; }
+
+    const Stats& stats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+private:
+    struct Entry;
+
+    static unsigned hash(const FontKey&, const UChar* word, unsigned length);
+    static size_t entrySize(unsigned length, unsigned glyphCount);
+    static const UChar* entryCharacters(const Entry*);
+    static const Glyph* entryGlyphs(const Entry*);
+
+    // Returns the slot holding the matching entry, or the empty slot where
+    // it would go.
+    size_t findSlot(unsigned hash, const FontKey&, const UChar* word, unsigned length) const;
+    bool needsToGrow(unsigned entryCount) const;
+    void* allocate(size_t);
+    void grow();
+
+    // A power of two number of slots. Null slots are empty.
+    Vector<Entry*> m_table;
+    unsigned m_entryCount;
+
+    Vector<char*> m_chunks;
+    char* m_chunkCursor;
+    size_t m_chunkRemaining;
+    size_t m_arenaBytes;
+
+    size_t m_maxBytes;
+    Stats m_stats;
+};
+
+} // namespace blink
+
+#endif // SKY_ENGINE_PLATFORM_FONTS_HARFBUZZ_HARFBUZZSHAPECACHE_H_
@@ -0,0 +1,134 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/fonts/harfbuzz/HarfBuzzShapeCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+class HarfBuzzShapeCacheTest : public ::testing::Test {
+protected:
+    static HarfBuzzShapeCache::FontKey fontKey(uint32_t fontID)
+    {
+        HarfBuzzShapeCache::FontKey key;
+        key.fontID = fontID;
+        key.size = 16;
+        key.script = HB_SCRIPT_LATIN;
+        key.direction = HB_DIRECTION_LTR;
+        return key;
+    }
+
+    static void shape(const UChar* word, unsigned length, Vector<HarfBuzzShapeCache::Glyph>& glyphs)
+    {
+        glyphs.resize(length);
+        for (unsigned i = 0; i < length; ++i) {
+            glyphs[i].glyph = word[i];
+            glyphs[i].cluster = i;
+            glyphs[i].advance = 10 << 16;
+            glyphs[i].offsetX = 0;
+            glyphs[i].offsetY = 0;
+        }
+    }
+};
+
+const UChar hello[] = { 'h', 'e', 'l', 'l', 'o' };
+const UChar help[] = { 'h', 'e', 'l', 'p' };
+
+TEST_F(HarfBuzzShapeCacheTest, FindReturnsAddedGlyphs)
+{
+    HarfBuzzShapeCache cache;
+    HarfBuzzShapeCache::FontKey key = fontKey(1);
+    unsigned glyphCount = 0;
+    EXPECT_FALSE(cache.find(key, hello, 5, &glyphCount));
+
+    Vector<HarfBuzzShapeCache::Glyph> glyphs;
+    shape(hello, 5, glyphs);
+    cache.add(key, hello, 5, glyphs.data(), glyphs.size());
+    EXPECT_EQ(1u, cache.entryCount());
+
+    const HarfBuzzShapeCache::Glyph* cached = cache.find(key, hello, 5, &glyphCount);
+    ASSERT_TRUE(cached);
+    ASSERT_EQ(5u, glyphCount);
+    for (unsigned i = 0; i < glyphCount; ++i) {
+        EXPECT_EQ(hello[i], cached[i].glyph);
+        EXPECT_EQ(i, cached[i].cluster);
+        EXPECT_EQ(10 << 16, cached[i].advance);
+    }
+
+    EXPECT_EQ(1u, cache.stats().hits);
+    EXPECT_EQ(1u, cache.stats().misses);
+}
+
+TEST_F(HarfBuzzShapeCacheTest, KeyIncludesFontAndText)
+{
+    HarfBuzzShapeCache cache;
+    Vector<HarfBuzzShapeCache::Glyph> glyphs;
+    shape(hello, 5, glyphs);
+    cache.add(fontKey(1), hello, 5, glyphs.data(), glyphs.size());
+
+    unsigned glyphCount = 0;
+    EXPECT_FALSE(cache.find(fontKey(2), hello, 5, &glyphCount));
+    EXPECT_FALSE(cache.find(fontKey(1), hello, 4, &glyphCount));
+    EXPECT_FALSE(cache.find(fontKey(1), help, 4, &glyphCount));
+
+    HarfBuzzShapeCache::FontKey rtl = fontKey(1);
+    rtl.direction = HB_DIRECTION_RTL;
+    EXPECT_FALSE(cache.find(rtl, hello, 5, &glyphCount));
+
+    HarfBuzzShapeCache::FontKey bigger = fontKey(1);
+    bigger.size = 17;
+    EXPECT_FALSE(cache.find(bigger, hello, 5, &glyphCount));
+
+    EXPECT_TRUE(cache.find(fontKey(1), hello, 5, &glyphCount));
+}
+
+TEST_F(HarfBuzzShapeCacheTest, GrowsPastInitialTable)
+{
+    HarfBuzzShapeCache cache(16 * 1024 * 1024);
+    Vector<HarfBuzzShapeCache::Glyph> glyphs;
+    shape(hello, 5, glyphs);
+    for (uint32_t i = 0; i < 5000; ++i)
+        cache.add(fontKey(i), hello, 5, glyphs.data(), glyphs.size());
+    EXPECT_EQ(5000u, cache.entryCount());
+
+    unsigned glyphCount = 0;
+    for (uint32_t i = 0; i < 5000; ++i)
+        EXPECT_TRUE(cache.find(fontKey(i), hello, 5, &glyphCount));
+    EXPECT_EQ(0u, cache.stats().resets);
+}
+
+TEST_F(HarfBuzzShapeCacheTest, StaysWithinByteBudget)
+{
+    const size_t maxBytes = 256 * 1024;
+    HarfBuzzShapeCache cache(maxBytes);
+    Vector<HarfBuzzShapeCache::Glyph> glyphs;
+    shape(hello, 5, glyphs);
+    for (uint32_t i = 0; i < 20000; ++i) {
+        cache.add(fontKey(i), hello, 5, glyphs.data(), glyphs.size());
+        ASSERT_LE(cache.byteCount(), maxBytes);
+    }
+    EXPECT_GT(cache.stats().resets, 0u);
+
+    // The most recently added word survives the reset.
+    unsigned glyphCount = 0;
+    EXPECT_TRUE(cache.find(fontKey(19999), hello, 5, &glyphCount));
+}
+
+TEST_F(HarfBuzzShapeCacheTest, Clear)
+{
+    HarfBuzzShapeCache cache;
+    Vector<HarfBuzzShapeCache::Glyph> glyphs;
+    shape(hello, 5, glyphs);
+    cache.add(fontKey(1), hello, 5, glyphs.data(), glyphs.size());
+    cache.clear();
+    EXPECT_EQ(0u, cache.entryCount());
+
+    unsigned glyphCount = 0;
+    EXPECT_FALSE(cache.find(fontKey(1), hello, 5, &glyphCount));
+}
+
+} // namespace
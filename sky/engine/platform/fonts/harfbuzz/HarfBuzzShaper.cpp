@@ -45,12 +45,9 @@
 #include "sky/engine/platform/text/TextBreakIterator.h"
 #include "sky/engine/wtf/Compiler.h"
 #include "sky/engine/wtf/MathExtras.h"
+#include "sky/engine/wtf/StringHasher.h"
 #include "sky/engine/wtf/unicode/Unicode.h"
 
-#include <list>
-#include <map>
-#include <string>
-
 namespace blink {
 
 template<typename T>
@@ -78,135 +75,23 @@ private:
 };
 
 
-static const unsigned cHarfBuzzCacheMaxSize = 256;
-
-struct CachedShapingResultsLRUNode;
-struct CachedShapingResults;
-typedef std::map<std::wstring, CachedShapingResults*> CachedShapingResultsMap;
-typedef std::list<CachedShapingResultsLRUNode*> CachedShapingResultsLRU;
-
-struct CachedShapingResults {
-    CachedShapingResults(hb_buffer_t* harfBuzzBuffer, const Font* runFont, hb_direction_t runDir, const String& newLocale);
-    ~CachedShapingResults();
-
-    hb_buffer_t* buffer;
-    Font font;
-    hb_direction_t dir;
-    String locale;
-    CachedShapingResultsLRU::iterator lru;
-};
-
-struct CachedShapingResultsLRUNode {
-    CachedShapingResultsLRUNode(const CachedShapingResultsMap::iterator& cacheEntry);
-    ~CachedShapingResultsLRUNode();
-
-    CachedShapingResultsMap::iterator entry;
-};
-
-CachedShapingResults::CachedShapingResults(hb_buffer_t* harfBuzzBuffer, const Font* fontData, hb_direction_t dirData, const String& newLocale)
-    : buffer(harfBuzzBuffer)
-    , font(*fontData)
-    , dir(dirData)
-    , locale(newLocale)
-{
-}
-
-CachedShapingResults::~CachedShapingResults()
-{
-    hb_buffer_destroy(buffer);
-}
-
-CachedShapingResultsLRUNode::CachedShapingResultsLRUNode(const CachedShapingResultsMap::iterator& cacheEntry)
-    : entry(cacheEntry)
-{
-}
-
-CachedShapingResultsLRUNode::~CachedShapingResultsLRUNode()
-{
-}
-
-class HarfBuzzRunCache {
-public:
-    HarfBuzzRunCache();
-    ~HarfBuzzRunCache();
-
-    CachedShapingResults* find(const std::wstring& key) const;
-    void remove(CachedShapingResults* node);
-    void moveToBack(CachedShapingResults* node);
-    bool insert(const std::wstring& key, CachedShapingResults* run);
-
-private:
-    CachedShapingResultsMap m_harfBuzzRunMap;
-    CachedShapingResultsLRU m_harfBuzzRunLRU;
-};
-
-
-HarfBuzzRunCache::HarfBuzzRunCache()
-{
-}
-
-HarfBuzzRunCache::~HarfBuzzRunCache()
-{
-    for (CachedShapingResultsMap::iterator it = m_harfBuzzRunMap.begin(); it != m_harfBuzzRunMap.end(); ++it)
-        delete it->second;
-    for (CachedShapingResultsLRU::iterator it = m_harfBuzzRunLRU.begin(); it != m_harfBuzzRunLRU.end(); ++it)
-        delete *it;
-}
-
-bool HarfBuzzRunCache::insert(const std::wstring& key, CachedShapingResults* data)
+// Splits a run into the words that are shaped and cached separately.
+// |boundaries| receives the start of each word followed by the end of the
+// last one. Each space is a word of its own, so that the other words are
+// cached independently of the spacing around them.
+static void splitIntoWords(const UChar* text, unsigned length, Vector<unsigned, 64>& boundaries)
 {
-    std::pair<CachedShapingResultsMap::iterator, bool> results =
-        m_harfBuzzRunMap.insert(CachedShapingResultsMap::value_type(key, data));
-
-    if (!results.second)
-        return false;
-
-    CachedShapingResultsLRUNode* node = new CachedShapingResultsLRUNode(results.first);
-
-    m_harfBuzzRunLRU.push_back(node);
-    data->lru = --m_harfBuzzRunLRU.end();
-
-    if (m_harfBuzzRunMap.size() > cHarfBuzzCacheMaxSize) {
-        CachedShapingResultsLRUNode* lru = m_harfBuzzRunLRU.front();
-        CachedShapingResults* foo = lru->entry->second;
-        m_harfBuzzRunMap.erase(lru->entry);
-        m_harfBuzzRunLRU.pop_front();
-        delete foo;
-        delete lru;
+    boundaries.clear();
+    boundaries.append(0);
+    for (unsigned i = 0; i < length; ++i) {
+        if (!Character::treatAsSpace(text[i]))
+            continue;
+        if (boundaries.last() != i)
+            boundaries.append(i);
+        boundaries.append(i + 1);
     }
-
-    return true;
-}
-
-inline CachedShapingResults* HarfBuzzRunCache::find(const std::wstring& key) const
-{
-    CachedShapingResultsMap::const_iterator it = m_harfBuzzRunMap.find(key);
-
-    return it != m_harfBuzzRunMap.end() ? it->second : 0;
-}
-
-inline void HarfBuzzRunCache::remove(CachedShapingResults* node)
-{
-    CachedShapingResultsLRUNode* lruNode = *node->lru;
-
-    m_harfBuzzRunLRU.erase(node->lru);
-    m_harfBuzzRunMap.erase(lruNode->entry);
-    delete lruNode;
-    delete node;
-}
-
-inline void HarfBuzzRunCache::moveToBack(CachedShapingResults* node)
-{
-    CachedShapingResultsLRUNode* lruNode = *node->lru;
-    m_harfBuzzRunLRU.erase(node->lru);
-    m_harfBuzzRunLRU.push_back(lruNode);
-    node->lru = --m_harfBuzzRunLRU.end();
-}
-
-HarfBuzzRunCache& harfBuzzRunCache()
-{
-    DEFINE_STATIC_LOCAL(HarfBuzzRunCache, globalHarfBuzzRunCache, ());
-    return globalHarfBuzzRunCache;
+    if (boundaries.last() != length)
+        boundaries.append(length);
 }
 
 static inline float harfBuzzPositionToFloat(hb_position_t value)
@@ -264,9 +149,9 @@ HarfBuzzShaper::HarfBuzzRun::~HarfBuzzRun()
 {
 }
 
-inline void HarfBuzzShaper::HarfBuzzRun::applyShapeResult(hb_buffer_t* harfBuzzBuffer)
+inline void HarfBuzzShaper::HarfBuzzRun::applyShapeResult(unsigned numGlyphs)
 {
-    m_numGlyphs = hb_buffer_get_length(harfBuzzBuffer);
+    m_numGlyphs = numGlyphs;
     m_glyphs.resize(m_numGlyphs);
     m_advances.resize(m_numGlyphs);
     m_glyphToCharacterIndexes.resize(m_numGlyphs);
@@ -811,10 +696,21 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns()
 {
     HarfBuzzScopedPtr<hb_buffer_t> harfBuzzBuffer(hb_buffer_create(), hb_buffer_destroy);
 
-    HarfBuzzRunCache& runCache = harfBuzzRunCache();
+    HarfBuzzShapeCache& shapeCache = HarfBuzzShapeCache::instance();
     const FontDescription& fontDescription = m_font->fontDescription();
     const String& localeString = fontDescription.locale();
     CString locale = localeString.latin1();
+    hb_language_t language = hb_language_from_string(locale.data(), locale.length());
+
+    HarfBuzzShapeCache::FontKey cacheKey;
+    if (!m_features.isEmpty())
+        cacheKey.featuresHash = StringHasher::hashMemory(m_features.data(), m_features.size() * sizeof(hb_feature_t));
+    if (!localeString.isNull())
+        cacheKey.localeHash = localeString.impl()->hash();
+
+    Vector<unsigned, 64> wordBoundaries;
+    Vector<HarfBuzzShapeCache::Glyph, 256> runGlyphs;
+    Vector<HarfBuzzShapeCache::Glyph, 64> wordGlyphs;
 
     for (unsigned i = 0; i < m_harfBuzzRuns.size(); ++i) {
         unsigned runIndex = m_run.rtl() ? m_harfBuzzRuns.size() - i - 1 : i;
@@ -823,69 +719,97 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns()
         if (currentFontData->isSVGFont())
             return false;
 
-        FontPlatformData* platformData = const_cast<FontPlatformData*>(&currentFontData->platformData());
-        HarfBuzzFace* face = platformData->harfBuzzFace();
+        const FontPlatformData& platformData = currentFontData->platformData();
+        HarfBuzzFace* face = platformData.harfBuzzFace();
         if (!face)
             return false;
 
-        hb_buffer_set_language(harfBuzzBuffer.get(), hb_language_from_string(locale.data(), locale.length()));
-        hb_buffer_set_script(harfBuzzBuffer.get(), currentRun->script());
-        hb_buffer_set_direction(harfBuzzBuffer.get(), currentRun->direction());
-
-        const UChar* src = m_normalizedBuffer.get() + currentRun->startIndex();
-        std::wstring key(src, src + currentRun->numCharacters());
-
-        CachedShapingResults* cachedResults = runCache.find(key);
-        if (cachedResults) {
-            if (cachedResults->dir == currentRun->direction() && cachedResults->font == *m_font && cachedResults->locale == localeString) {
-                currentRun->applyShapeResult(cachedResults->buffer);
-                setGlyphPositionsForHarfBuzzRun(currentRun, cachedResults->buffer);
-
-                hb_buffer_clear_contents(harfBuzzBuffer.get());
-
-                runCache.moveToBack(cachedResults);
+        const UChar* text = m_normalizedBuffer.get() + currentRun->startIndex();
+        unsigned length = currentRun->numCharacters();
+        String upperText;
+        if (fontDescription.variant() == FontVariantSmallCaps && u_islower(text[0])) {
+            upperText = String(text, length).upper();
+            ASSERT(!upperText.is8Bit()); // m_normalizedBuffer is 16 bit, therefore upperText is 16 bit, even after we call makeUpper().
+            text = upperText.characters16();
+        }
 
-                continue;
+        cacheKey.fontID = platformData.uniqueID();
+        cacheKey.size = platformData.size();
+        cacheKey.flags = platformData.syntheticBold() | (platformData.syntheticItalic() << 1) | (platformData.orientation() << 2);
+        cacheKey.script = currentRun->script();
+        cacheKey.direction = currentRun->direction();
+
+        // The font is only needed if a word misses the cache.
+        HarfBuzzScopedPtr<hb_font_t> harfBuzzFont(0, hb_font_destroy);
+
+        // HarfBuzz returns glyphs in visual order, so words are appended in
+        // visual order too.
+        splitIntoWords(text, length, wordBoundaries);
+        unsigned wordCount = wordBoundaries.size() - 1;
+        runGlyphs.clear();
+        for (unsigned j = 0; j < wordCount; ++j) {
+            unsigned wordIndex = currentRun->rtl() ? wordCount - j - 1 : j;
+            unsigned wordStart = wordBoundaries[wordIndex];
+            unsigned wordLength = wordBoundaries[wordIndex + 1] - wordStart;
+
+            unsigned glyphCount = 0;
+            const HarfBuzzShapeCache::Glyph* glyphs = shapeCache.find(cacheKey, text + wordStart, wordLength, &glyphCount);
+            if (!glyphs) {
+                if (!harfBuzzFont.get())
+                    harfBuzzFont.set(face->createFont());
+                shapeWord(harfBuzzBuffer.get(), harfBuzzFont.get(), face, language, currentRun, text + wordStart, wordLength, wordGlyphs);
+                shapeCache.add(cacheKey, text + wordStart, wordLength, wordGlyphs.data(), wordGlyphs.size());
+                glyphs = wordGlyphs.data();
+                glyphCount = wordGlyphs.size();
             }
 
-            runCache.remove(cachedResults);
+            for (unsigned k = 0; k < glyphCount; ++k) {
+                runGlyphs.append(glyphs[k]);
+                runGlyphs.last().cluster += wordStart;
+            }
         }
 
-        // Add a space as pre-context to the buffer. This prevents showing dotted-circle
-        // for combining marks at the beginning of runs.
-        static const uint16_t preContext = ' ';
-        hb_buffer_add_utf16(harfBuzzBuffer.get(), &preContext, 1, 1, 0);
+        currentRun->applyShapeResult(runGlyphs.size());
+        setGlyphPositionsForHarfBuzzRun(currentRun, runGlyphs.data());
+    }
 
-        if (fontDescription.variant() == FontVariantSmallCaps && u_islower(m_normalizedBuffer[currentRun->startIndex()])) {
-            String upperText = String(m_normalizedBuffer.get() + currentRun->startIndex(), currentRun->numCharacters()).upper();
-            ASSERT(!upperText.is8Bit()); // m_normalizedBuffer is 16 bit, therefore upperText is 16 bit, even after we call makeUpper().
-            hb_buffer_add_utf16(harfBuzzBuffer.get(), toUint16(upperText.characters16()), currentRun->numCharacters(), 0, currentRun->numCharacters());
-        } else {
-            hb_buffer_add_utf16(harfBuzzBuffer.get(), toUint16(m_normalizedBuffer.get() + currentRun->startIndex()), currentRun->numCharacters(), 0, currentRun->numCharacters());
-        }
+    return true;
+}
 
-        if (fontDescription.orientation() == Vertical)
-            face->setScriptForVerticalGlyphSubstitution(harfBuzzBuffer.get());
+void HarfBuzzShaper::shapeWord(hb_buffer_t* harfBuzzBuffer, hb_font_t* harfBuzzFont, HarfBuzzFace* face, hb_language_t language, HarfBuzzRun* currentRun, const UChar* word, unsigned length, Vector<HarfBuzzShapeCache::Glyph, 64>& glyphs)
+{
+    hb_buffer_clear_contents(harfBuzzBuffer);
+    hb_buffer_set_language(harfBuzzBuffer, language);
+    hb_buffer_set_script(harfBuzzBuffer, currentRun->script());
+    hb_buffer_set_direction(harfBuzzBuffer, currentRun->direction());
 
-        HarfBuzzScopedPtr<hb_font_t> harfBuzzFont(face->createFont(), hb_font_destroy);
+    // Add a space as pre-context to the buffer. This prevents showing dotted-circle
+    // for combining marks at the beginning of runs.
+    static const uint16_t preContext = ' ';
+    hb_buffer_add_utf16(harfBuzzBuffer, &preContext, 1, 1, 0);
+    hb_buffer_add_utf16(harfBuzzBuffer, toUint16(word), length, 0, length);
 
-        hb_shape(harfBuzzFont.get(), harfBuzzBuffer.get(), m_features.isEmpty() ? 0 : m_features.data(), m_features.size());
-        currentRun->applyShapeResult(harfBuzzBuffer.get());
-        setGlyphPositionsForHarfBuzzRun(currentRun, harfBuzzBuffer.get());
+    if (m_font->fontDescription().orientation() == Vertical)
+        face->setScriptForVerticalGlyphSubstitution(harfBuzzBuffer);
 
-        runCache.insert(key, new CachedShapingResults(harfBuzzBuffer.get(), m_font, currentRun->direction(), localeString));
+    hb_shape(harfBuzzFont, harfBuzzBuffer, m_features.isEmpty() ? 0 : m_features.data(), m_features.size());
 
-        harfBuzzBuffer.set(hb_buffer_create());
+    unsigned numGlyphs = hb_buffer_get_length(harfBuzzBuffer);
+    hb_glyph_info_t* glyphInfos = hb_buffer_get_glyph_infos(harfBuzzBuffer, 0);
+    hb_glyph_position_t* glyphPositions = hb_buffer_get_glyph_positions(harfBuzzBuffer, 0);
+    glyphs.resize(numGlyphs);
+    for (unsigned i = 0; i < numGlyphs; ++i) {
+        glyphs[i].glyph = glyphInfos[i].codepoint;
+        glyphs[i].cluster = glyphInfos[i].cluster;
+        glyphs[i].advance = glyphPositions[i].x_advance;
+        glyphs[i].offsetX = glyphPositions[i].x_offset;
+        glyphs[i].offsetY = glyphPositions[i].y_offset;
     }
-
-    return true;
 }
 
-void HarfBuzzShaper::setGlyphPositionsForHarfBuzzRun(HarfBuzzRun* currentRun, hb_buffer_t* harfBuzzBuffer)
+void HarfBuzzShaper::setGlyphPositionsForHarfBuzzRun(HarfBuzzRun* currentRun, const HarfBuzzShapeCache::Glyph* shapedGlyphs)
 {
     const SimpleFontData* currentFontData = currentRun->fontData();
-    hb_glyph_info_t* glyphInfos = hb_buffer_get_glyph_infos(harfBuzzBuffer, 0);
-    hb_glyph_position_t* glyphPositions = hb_buffer_get_glyph_positions(harfBuzzBuffer, 0);
 
     if (!currentRun->hasGlyphToCharacterIndexes()) {
         // FIXME: https://crbug.com/337886
@@ -901,16 +825,16 @@ void HarfBuzzShaper::setGlyphPositionsForHarfBuzzRun(HarfBuzzRun* currentRun, hb
     // HarfBuzz returns the shaping result in visual order. We need not to flip for RTL.
     for (size_t i = 0; i < numGlyphs; ++i) {
         bool runEnd = i + 1 == numGlyphs;
-        uint16_t glyph = glyphInfos[i].codepoint;
-        float offsetX = harfBuzzPositionToFloat(glyphPositions[i].x_offset);
-        float offsetY = -harfBuzzPositionToFloat(glyphPositions[i].y_offset);
-        float advance = harfBuzzPositionToFloat(glyphPositions[i].x_advance);
+        uint16_t glyph = shapedGlyphs[i].glyph;
+        float offsetX = harfBuzzPositionToFloat(shapedGlyphs[i].offsetX);
+        float offsetY = -harfBuzzPositionToFloat(shapedGlyphs[i].offsetY);
+        float advance = harfBuzzPositionToFloat(shapedGlyphs[i].advance);
 
-        unsigned currentCharacterIndex = currentRun->startIndex() + glyphInfos[i].cluster;
-        bool isClusterEnd = runEnd || glyphInfos[i].cluster != glyphInfos[i + 1].cluster;
+        unsigned currentCharacterIndex = currentRun->startIndex() + shapedGlyphs[i].cluster;
+        bool isClusterEnd = runEnd || shapedGlyphs[i].cluster != shapedGlyphs[i + 1].cluster;
         float spacing = 0;
 
-        glyphToCharacterIndexes[i] = glyphInfos[i].cluster;
+        glyphToCharacterIndexes[i] = shapedGlyphs[i].cluster;
 
         if (isClusterEnd && !Character::treatAsZeroWidthSpace(m_normalizedBuffer[currentCharacterIndex]))
             spacing += m_letterSpacing;
@@ -32,6 +32,7 @@
 #define SKY_ENGINE_PLATFORM_FONTS_HARFBUZZ_HARFBUZZSHAPER_H_
 
 #include "hb.h"
+#include "sky/engine/platform/fonts/harfbuzz/HarfBuzzShapeCache.h"
 #include "sky/engine/platform/geometry/FloatBoxExtent.h"
 #include "sky/engine/platform/geometry/FloatPoint.h"
 #include "sky/engine/platform/text/TextRun.h"
@@ -47,6 +48,7 @@ namespace blink {
 
 class Font;
 class GlyphBuffer;
+class HarfBuzzFace;
 class SimpleFontData;
 
 class HarfBuzzShaper final {
@@ -76,7 +78,7 @@ private:
             return adoptPtr(new HarfBuzzRun(fontData, startIndex, numCharacters, direction, script));
         }
 
-        void applyShapeResult(hb_buffer_t*);
+        void applyShapeResult(unsigned numGlyphs);
         void setGlyphAndPositions(unsigned index, uint16_t glyphId, float advance, float offsetX, float offsetY);
         void setWidth(float width) { m_width = width; }
 
@@ -131,7 +133,8 @@ private:
     bool fillGlyphBuffer(GlyphBuffer*);
     void fillGlyphBufferFromHarfBuzzRun(GlyphBuffer*, HarfBuzzRun*, float& carryAdvance);
     void fillGlyphBufferForTextEmphasis(GlyphBuffer*, HarfBuzzRun* currentRun);
-    void setGlyphPositionsForHarfBuzzRun(HarfBuzzRun*, hb_buffer_t*);
+    void shapeWord(hb_buffer_t*, hb_font_t*, HarfBuzzFace*, hb_language_t, HarfBuzzRun*, const UChar* word, unsigned length, Vector<HarfBuzzShapeCache::Glyph, 64>& glyphs);
+    void setGlyphPositionsForHarfBuzzRun(HarfBuzzRun*, const HarfBuzzShapeCache::Glyph*);
     void addHarfBuzzRun(unsigned startCharacter, unsigned endCharacter, const SimpleFontData*, UScriptCode);
 
     const Font* m_font;
@@ -156,8 +159,6 @@ private:
     float m_totalWidth;
     FloatBoxExtent m_glyphBoundingBox;
     HashSet<const SimpleFontData*>* m_fallbackFonts;
-
-    friend struct CachedShapingResults;
 };
 
 } // namespace blink
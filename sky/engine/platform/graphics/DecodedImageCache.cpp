@@ -0,0 +1,175 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/graphics/DecodedImageCache.h"
+
+#include "base/sha1.h"
+#include "sky/engine/platform/TraceEvent.h"
+#include "sky/engine/wtf/HashFunctions.h"
+#include "sky/engine/wtf/Threading.h"
+
+namespace blink {
+
+namespace {
+
+static const size_t defaultCacheLimitInBytes = 32 * 1024 * 1024;
+
+} // namespace
+
+COMPILE_ASSERT(DecodedImageCache::Key::digestLength == base::kSHA1Length, DigestLengthMatchesSHA1);
+
+const size_t DecodedImageCache::Key::digestLength;
+
+DecodedImageCache::Key::Key(const char* encodedData, size_t length, const SkISize& targetSize)
+    : m_targetSize(targetSize)
+{
+    ASSERT(targetSize.width() >= 0 && targetSize.height() >= 0);
+    base::SHA1HashBytes(reinterpret_cast<const unsigned char*>(encodedData), length, m_digest);
+}
+
+unsigned DecodedImageCache::Key::hash() const
+{
+    // The digest is already uniformly distributed.
+    unsigned digestHash;
+    memcpy(&digestHash, m_digest, sizeof(digestHash));
+    return WTF::pairIntHash(digestHash, WTF::pairIntHash(m_targetSize.width(), m_targetSize.height()));
+}
+
+DecodedImageCache::DecodedImageCache()
+    : m_limitInBytes(defaultCacheLimitInBytes)
+    , m_memoryUsageInBytes(0)
+{
+}
+
+DecodedImageCache::~DecodedImageCache()
+{
+    clear();
+}
+
+DecodedImageCache* DecodedImageCache::instance()
+{
+    AtomicallyInitializedStatic(DecodedImageCache*, cache = DecodedImageCache::create().leakPtr());
+    return cache;
+}
+
+bool DecodedImageCache::lookup(const Key& key, SkBitmap* bitmap)
+{
+    ASSERT(bitmap);
+
+    MutexLocker lock(m_mutex);
+    CacheMap::iterator iter = m_cacheMap.find(key);
+    if (iter == m_cacheMap.end()) {
+        ++m_stats.misses;
+        return false;
+    }
+    ++m_stats.hits;
+
+    CacheEntry* cacheEntry = iter->value.get();
+    *bitmap = cacheEntry->bitmap();
+
+    // Put the entry to the end of list.
+    m_orderedCacheList.remove(cacheEntry);
+    m_orderedCacheList.append(cacheEntry);
+    return true;
+}
+
+void DecodedImageCache::insert(const Key& key, const SkBitmap& bitmap)
+{
+    ASSERT(bitmap.isImmutable());
+
+    OwnPtr<CacheEntry> newCacheEntry = adoptPtr(new CacheEntry(key, bitmap));
+    Vector<OwnPtr<CacheEntry> > cacheEntriesToDelete;
+    {
+        MutexLocker lock(m_mutex);
+        size_t entrySize = newCacheEntry->memoryUsageInBytes();
+        if (entrySize > m_limitInBytes)
+            return;
+
+        // Two decoders can race to insert the same image. Keep the first.
+        if (m_cacheMap.contains(key))
+            return;
+
+        // Prune old cache entries to give space for the new one.
+        pruneInternal(m_limitInBytes - entrySize, &cacheEntriesToDelete);
+
+        m_memoryUsageInBytes += entrySize;
+        m_orderedCacheList.append(newCacheEntry.get());
+        m_cacheMap.add(key, newCacheEntry.release());
+
+        TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("blink.image_decoding"), "DecodedImageCacheMemoryUsageBytes", m_memoryUsageInBytes);
+    }
+}
+
+void DecodedImageCache::reduceMemoryUsage(size_t targetUsageInBytes)
+{
+    TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("blink.image_decoding"), "DecodedImageCache::reduceMemoryUsage");
+
+    Vector<OwnPtr<CacheEntry> > cacheEntriesToDelete;
+    {
+        MutexLocker lock(m_mutex);
+        pruneInternal(targetUsageInBytes, &cacheEntriesToDelete);
+    }
+}
+
+void DecodedImageCache::clear()
+{
+    reduceMemoryUsage(0);
+}
+
+void DecodedImageCache::setCacheLimitInBytes(size_t cacheLimit)
+{
+    Vector<OwnPtr<CacheEntry> > cacheEntriesToDelete;
+    {
+        MutexLocker lock(m_mutex);
+        m_limitInBytes = cacheLimit;
+        pruneInternal(m_limitInBytes, &cacheEntriesToDelete);
+    }
+}
+
+size_t DecodedImageCache::cacheLimitInBytes()
+{
+    MutexLocker lock(m_mutex);
+    return m_limitInBytes;
+}
+
+size_t DecodedImageCache::memoryUsageInBytes()
+{
+    MutexLocker lock(m_mutex);
+    return m_memoryUsageInBytes;
+}
+
+int DecodedImageCache::cacheEntries()
+{
+    MutexLocker lock(m_mutex);
+    return m_cacheMap.size();
+}
+
+DecodedImageCache::Stats DecodedImageCache::stats()
+{
+    MutexLocker lock(m_mutex);
+    return m_stats;
+}
+
+void DecodedImageCache::resetStats()
+{
+    MutexLocker lock(m_mutex);
+    m_stats = Stats();
+}
+
+void DecodedImageCache::pruneInternal(size_t limitInBytes, Vector<OwnPtr<CacheEntry> >* deletionList)
+{
+    // Head of the list is the least recently used entry.
+    while (m_memoryUsageInBytes > limitInBytes) {
+        CacheEntry* cacheEntry = m_orderedCacheList.head();
+        ASSERT(cacheEntry);
+        m_orderedCacheList.remove(cacheEntry);
+        m_memoryUsageInBytes -= cacheEntry->memoryUsageInBytes();
+        deletionList->append(m_cacheMap.take(cacheEntry->key()));
+        ++m_stats.evictions;
+    }
+
+    TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("blink.image_decoding"), "DecodedImageCacheMemoryUsageBytes", m_memoryUsageInBytes);
+}
+
+} // namespace blink
@@ -0,0 +1,147 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_PLATFORM_GRAPHICS_DECODEDIMAGECACHE_H_
+#define SKY_ENGINE_PLATFORM_GRAPHICS_DECODEDIMAGECACHE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "sky/engine/platform/PlatformExport.h"
+#include "sky/engine/wtf/DoublyLinkedList.h"
+#include "sky/engine/wtf/HashMap.h"
+#include "sky/engine/wtf/OwnPtr.h"
+#include "sky/engine/wtf/PassOwnPtr.h"
+#include "sky/engine/wtf/ThreadingPrimitives.h"
+#include "sky/engine/wtf/Vector.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkSize.h"
+
+namespace blink {
+
+// FUNCTION
+//
+// DecodedImageCache is a process-wide cache of decoded images, shared by all
+// image decoders that produce CanvasImages. Identical encoded data decoded to
+// the same target size yields the same (immutable) bitmap, so an image that
+// appears many times on screen is decoded and stored once.
+//
+// Entries are keyed by the SHA-1 digest of the encoded bytes and the target
+// size, so different images never share an entry. The cache has a byte budget
+// and evicts the least recently used entries when the budget is exceeded. Like ImageDecodingStore, the head of the LRU list is the
+// least recently used entry.
+//
+// THREAD SAFETY
+//
+// All public methods can be used on any thread.
+
+class PLATFORM_EXPORT DecodedImageCache {
+public:
+    // Identifies a decoded image by the SHA-1 digest of its encoded data and
+    // the size it was decoded to. A target size of (0, 0) means the image's
+    // natural size.
+    class PLATFORM_EXPORT Key {
+    public:
+        static const size_t digestLength = 20;
+
+        Key(const char* encodedData, size_t length, const SkISize& targetSize);
+
+        // For HashMap.
+        Key() : m_targetSize(SkISize::Make(0, 0)) { memset(m_digest, 0, digestLength); }
+        explicit Key(WTF::HashTableDeletedValueType) : m_targetSize(SkISize::Make(-1, -1)) { memset(m_digest, 0, digestLength); }
+        bool isHashTableDeletedValue() const { return m_targetSize.width() == -1; }
+
+        unsigned hash() const;
+        bool operator==(const Key& other) const
+        {
+            return m_targetSize == other.m_targetSize && !memcmp(m_digest, other.m_digest, digestLength);
+        }
+
+    private:
+        unsigned char m_digest[digestLength];
+        SkISize m_targetSize;
+    };
+
+    struct Stats {
+        Stats() : hits(0), misses(0), evictions(0) { }
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+    };
+
+    static PassOwnPtr<DecodedImageCache> create() { return adoptPtr(new DecodedImageCache); }
+    ~DecodedImageCache();
+
+    static DecodedImageCache* instance();
+
+    // Returns true and sets |bitmap| if an entry for |key| is cached. Counts a
+    // hit or a miss.
+    bool lookup(const Key&, SkBitmap* bitmap);
+
+    // |bitmap| must be immutable. Bitmaps larger than the whole budget are not
+    // cached.
+    void insert(const Key&, const SkBitmap& bitmap);
+
+    // Evicts least recently used entries until the cache uses at most
+    // |targetUsageInBytes|. Used to respond to memory pressure.
+    void reduceMemoryUsage(size_t targetUsageInBytes);
+
+    void clear();
+    void setCacheLimitInBytes(size_t);
+    size_t cacheLimitInBytes();
+    size_t memoryUsageInBytes();
+    int cacheEntries();
+    Stats stats();
+    void resetStats();
+
+private:
+    class CacheEntry : public DoublyLinkedListNode<CacheEntry> {
+        friend class WTF::DoublyLinkedListNode<CacheEntry>;
+    public:
+        CacheEntry(const Key& key, const SkBitmap& bitmap)
+            : m_key(key)
+            , m_bitmap(bitmap)
+            , m_prev(0)
+            , m_next(0)
+        {
+        }
+
+        const Key& key() const { return m_key; }
+        const SkBitmap& bitmap() const { return m_bitmap; }
+        size_t memoryUsageInBytes() const { return m_bitmap.getSize(); }
+
+    private:
+        Key m_key;
+        SkBitmap m_bitmap;
+        CacheEntry* m_prev;
+        CacheEntry* m_next;
+    };
+
+    DecodedImageCache();
+
+    // Called while m_mutex is locked. Ownership of evicted entries is
+    // transferred to |deletionList| so that they are freed outside the lock.
+    void pruneInternal(size_t limitInBytes, Vector<OwnPtr<CacheEntry> >* deletionList);
+
+    DoublyLinkedList<CacheEntry> m_orderedCacheList;
+
+    struct KeyHash {
+        static unsigned hash(const Key& key) { return key.hash(); }
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = true;
+    };
+    typedef HashMap<Key, OwnPtr<CacheEntry>, KeyHash, WTF::SimpleClassHashTraits<Key> > CacheMap;
+    CacheMap m_cacheMap;
+
+    size_t m_limitInBytes;
+    size_t m_memoryUsageInBytes;
+    Stats m_stats;
+
+    // Protects all of the members above.
+    Mutex m_mutex;
+};
+
+} // namespace blink
+
+#endif  // SKY_ENGINE_PLATFORM_GRAPHICS_DECODEDIMAGECACHE_H_
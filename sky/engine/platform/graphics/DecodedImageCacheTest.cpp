@@ -0,0 +1,129 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/platform/graphics/DecodedImageCache.h"
+
+#include <gtest/gtest.h>
+#include <string.h>
+
+using namespace blink;
+
+namespace {
+
+class DecodedImageCacheTest : public ::testing::Test {
+public:
+    void SetUp() override
+    {
+        m_cache = DecodedImageCache::create();
+        m_cache->setCacheLimitInBytes(1024 * 1024);
+    }
+
+    void TearDown() override
+    {
+        m_cache->clear();
+    }
+
+protected:
+    static SkBitmap createBitmap(int width, int height)
+    {
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(width, height);
+        bitmap.eraseColor(SK_ColorRED);
+        bitmap.setImmutable();
+        return bitmap;
+    }
+
+    static DecodedImageCache::Key keyFor(const char* data, const SkISize& size = SkISize::Make(0, 0))
+    {
+        return DecodedImageCache::Key(data, strlen(data), size);
+    }
+
+    OwnPtr<DecodedImageCache> m_cache;
+};
+
+TEST_F(DecodedImageCacheTest, KeysCompareContentAndSize)
+{
+    EXPECT_TRUE(keyFor("abcdef") == keyFor("abcdef"));
+    EXPECT_FALSE(keyFor("abcdef") == keyFor("abcdeg"));
+    EXPECT_FALSE(keyFor("abcdef") == keyFor("abcde"));
+    EXPECT_FALSE(keyFor("abcdef") == keyFor("abcdef", SkISize::Make(5, 5)));
+    EXPECT_FALSE(keyFor("") == DecodedImageCache::Key());
+}
+
+TEST_F(DecodedImageCacheTest, DifferentContentNeverShares)
+{
+    // Many small inputs, none of which may find another's bitmap.
+    m_cache->setCacheLimitInBytes(1000 * 400);
+    char data[2] = { 0, 0 };
+    for (int i = 1; i < 256; ++i) {
+        data[0] = static_cast<char>(i);
+        m_cache->insert(keyFor(data), createBitmap(10, 10));
+    }
+    EXPECT_EQ(255, m_cache->cacheEntries());
+}
+
+TEST_F(DecodedImageCacheTest, HitAndMiss)
+{
+    SkBitmap result;
+    EXPECT_FALSE(m_cache->lookup(keyFor("a"), &result));
+
+    SkBitmap bitmap = createBitmap(10, 10);
+    m_cache->insert(keyFor("a"), bitmap);
+    EXPECT_EQ(1, m_cache->cacheEntries());
+    EXPECT_EQ(400u, m_cache->memoryUsageInBytes());
+
+    EXPECT_TRUE(m_cache->lookup(keyFor("a"), &result));
+    EXPECT_EQ(bitmap.getPixels(), result.getPixels());
+
+    // The same content at a different target size is a different entry.
+    EXPECT_FALSE(m_cache->lookup(keyFor("a", SkISize::Make(5, 5)), &result));
+
+    DecodedImageCache::Stats stats = m_cache->stats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(2u, stats.misses);
+}
+
+TEST_F(DecodedImageCacheTest, EvictsLeastRecentlyUsed)
+{
+    m_cache->setCacheLimitInBytes(1200);
+    m_cache->insert(keyFor("a"), createBitmap(10, 10));
+    m_cache->insert(keyFor("b"), createBitmap(10, 10));
+    m_cache->insert(keyFor("c"), createBitmap(10, 10));
+
+    // Touch "a" so that "b" becomes the least recently used entry.
+    SkBitmap result;
+    EXPECT_TRUE(m_cache->lookup(keyFor("a"), &result));
+
+    m_cache->insert(keyFor("d"), createBitmap(10, 10));
+    EXPECT_EQ(3, m_cache->cacheEntries());
+    EXPECT_EQ(1200u, m_cache->memoryUsageInBytes());
+    EXPECT_TRUE(m_cache->lookup(keyFor("a"), &result));
+    EXPECT_FALSE(m_cache->lookup(keyFor("b"), &result));
+    EXPECT_EQ(1u, m_cache->stats().evictions);
+}
+
+TEST_F(DecodedImageCacheTest, OversizedBitmapIsNotCached)
+{
+    m_cache->setCacheLimitInBytes(100);
+    m_cache->insert(keyFor("a"), createBitmap(10, 10));
+    EXPECT_EQ(0, m_cache->cacheEntries());
+    EXPECT_EQ(0u, m_cache->memoryUsageInBytes());
+}
+
+TEST_F(DecodedImageCacheTest, ReduceMemoryUsage)
+{
+    m_cache->insert(keyFor("a"), createBitmap(10, 10));
+    m_cache->insert(keyFor("b"), createBitmap(10, 10));
+    m_cache->reduceMemoryUsage(400);
+    EXPECT_EQ(1, m_cache->cacheEntries());
+
+    SkBitmap result;
+    EXPECT_TRUE(m_cache->lookup(keyFor("b"), &result));
+
+    m_cache->clear();
+    EXPECT_EQ(0, m_cache->cacheEntries());
+    EXPECT_EQ(0u, m_cache->memoryUsageInBytes());
+}
+
+} // namespace
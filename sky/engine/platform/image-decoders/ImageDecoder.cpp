@@ -104,6 +104,14 @@ PassOwnPtr<ImageDecoder> ImageDecoder::create(const SharedBuffer& data, ImageSou
     return nullptr;
 }
 
+PassOwnPtr<ImageDecoder> ImageDecoder::create(const SharedBuffer& data, ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption, const IntSize& targetSize)
+{
+    OwnPtr<ImageDecoder> decoder = create(data, alphaOption, gammaAndColorProfileOption);
+    if (decoder)
+        decoder->setTargetSize(targetSize);
+    return decoder.release();
+}
+
 bool ImageDecoder::frameHasAlphaAtIndex(size_t index) const
 {
     return !frameIsCompleteAtIndex(index) || m_frameBufferCache[index].hasAlpha();
@@ -89,6 +89,10 @@ public:
     // Returns a decoder with custom maxDecodedSize.
     static PassOwnPtr<ImageDecoder> create(const SharedBuffer& data, ImageSource::AlphaOption, ImageSource::GammaAndColorProfileOption, size_t maxDecodedSize);
 
+    // Returns a decoder that downsamples towards |targetSize| while decoding,
+    // if the format supports it. See setTargetSize().
+    static PassOwnPtr<ImageDecoder> create(const SharedBuffer& data, ImageSource::AlphaOption, ImageSource::GammaAndColorProfileOption, const IntSize& targetSize);
+
     virtual String filenameExtension() const = 0;
 
     bool isAllDataReceived() const { return m_isAllDataReceived; }
@@ -142,6 +146,15 @@ public:
         return true;
     }
 
+    // Asks the decoder to produce the smallest image, no larger than size(),
+    // that covers |targetSize| while preserving the aspect ratio. A zero
+    // width or height leaves that dimension unconstrained, and an empty size
+    // (the default) decodes at full size. Decoders that support this report
+    // the resulting size from decodedSize(); others ignore it. Must be called
+    // before decoding starts.
+    void setTargetSize(const IntSize& targetSize) { m_targetSize = targetSize; }
+    IntSize targetSize() const { return m_targetSize; }
+
     // Lazily-decodes enough of the image to get the frame count (if
     // possible), without decoding the individual frames.
     // FIXME: Right now that has to be done by each subclass; factor the
@@ -287,6 +300,8 @@ protected:
     // memory devices.
     size_t m_maxDecodedBytes;
 
+    IntSize m_targetSize;
+
 private:
     // Some code paths compute the size of the image as "width * height * 4"
     // and return it as a (signed) int.  Avoid overflow.
@@ -42,6 +42,8 @@
 #include "sky/engine/wtf/PassOwnPtr.h"
 #include "sky/engine/wtf/dtoa/utils.h"
 
+#include <algorithm>
+
 extern "C" {
 #include <stdio.h> // jpeglib.h needs stdio FILE.
 #include "jpeglib.h"
@@ -718,19 +720,41 @@ IntSize JPEGImageDecoder::decodedYUVSize(int component) const
     return m_decodedSize;
 }
 
+// libjpeg computes each output dimension as ceil(dimension * num / denom).
+static unsigned scaledDimension(unsigned dimension, unsigned scaleNumerator)
+{
+    return (dimension * scaleNumerator + scaleDenominator - 1) / scaleDenominator;
+}
+
 unsigned JPEGImageDecoder::desiredScaleNumerator() const
 {
+    unsigned scaleNumerator = scaleDenominator;
+
+    // Use the smallest DCT scale that still covers the target size.
+    if (m_targetSize.width() > 0 || m_targetSize.height() > 0) {
+        unsigned width = size().width();
+        unsigned height = size().height();
+        unsigned targetWidth = std::max(m_targetSize.width(), 0);
+        unsigned targetHeight = std::max(m_targetSize.height(), 0);
+        for (unsigned numerator = 1; numerator < scaleDenominator; ++numerator) {
+            if (scaledDimension(width, numerator) >= targetWidth && scaledDimension(height, numerator) >= targetHeight) {
+                scaleNumerator = numerator;
+                break;
+            }
+        }
+    }
+
     size_t originalBytes = size().width() * size().height() * 4;
     if (originalBytes <= m_maxDecodedBytes) {
-        return scaleDenominator;
+        return scaleNumerator;
     }
 
     // Downsample according to the maximum decoded size.
-    unsigned scaleNumerator = static_cast<unsigned>(floor(sqrt(
+    unsigned limitNumerator = static_cast<unsigned>(floor(sqrt(
         // MSVC needs explicit parameter type for sqrt().
         static_cast<float>(m_maxDecodedBytes * scaleDenominator * scaleDenominator / originalBytes))));
 
-    return scaleNumerator;
+    return std::min(scaleNumerator, limitNumerator);
 }
 
 bool JPEGImageDecoder::canDecodeToYUV() const
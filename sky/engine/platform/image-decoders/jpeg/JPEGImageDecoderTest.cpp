@@ -202,6 +202,47 @@ TEST(JPEGImageDecoderTest, downsampleImageSizeNotMultipleOf8)
     EXPECT_EQ(182u, outputHeight);
 }
 
+static void downsampleToTargetSize(const IntSize& targetSize, unsigned* outputWidth, unsigned* outputHeight, const char* imageFilePath)
+{
+    RefPtr<SharedBuffer> data = readFile(imageFilePath);
+    ASSERT_TRUE(data.get());
+
+    OwnPtr<JPEGImageDecoder> decoder = createDecoder(LargeEnoughSize);
+    decoder->setTargetSize(targetSize);
+    decoder->setData(data.get(), true);
+
+    ImageFrame* frame = decoder->frameBufferAtIndex(0);
+    ASSERT_TRUE(frame);
+    *outputWidth = frame->getSkBitmap().width();
+    *outputHeight = frame->getSkBitmap().height();
+    EXPECT_EQ(IntSize(*outputWidth, *outputHeight), decoder->decodedSize());
+}
+
+// Tests that the decoder picks the smallest DCT scale that covers the target size.
+TEST(JPEGImageDecoderTest, downsampleToTargetSize)
+{
+    const char* jpegFile = "/tests/fast/images/resources/lenna.jpg"; // 256x256
+    unsigned outputWidth, outputHeight;
+
+    downsampleToTargetSize(IntSize(32, 32), &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(32u, outputWidth);
+    EXPECT_EQ(32u, outputHeight);
+
+    downsampleToTargetSize(IntSize(48, 48), &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(64u, outputWidth);
+    EXPECT_EQ(64u, outputHeight);
+
+    // A zero width leaves the width unconstrained.
+    downsampleToTargetSize(IntSize(0, 100), &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(128u, outputWidth);
+    EXPECT_EQ(128u, outputHeight);
+
+    // Targets larger than the image decode at full size.
+    downsampleToTargetSize(IntSize(300, 300), &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(256u, outputWidth);
+    EXPECT_EQ(256u, outputHeight);
+}
+
 // Tests that upsampling is not allowed.
 TEST(JPEGImageDecoderTest, upsample)
 {
@@ -40,6 +40,9 @@
 
 #include "sky/engine/wtf/PassOwnPtr.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "png.h"
 #if USE(QCMSLIB)
 #include "qcms.h"
@@ -221,6 +224,8 @@ PNGImageDecoder::PNGImageDecoder(ImageSource::AlphaOption alphaOption,
     : ImageDecoder(alphaOption, gammaAndColorProfileOption, maxDecodedBytes)
     , m_doNothingOnFailure(false)
     , m_hasColorProfile(false)
+    , m_scale(1)
+    , m_accumulatedRows(0)
 {
 }
 
@@ -236,6 +241,26 @@ bool PNGImageDecoder::isSizeAvailable()
     return ImageDecoder::isSizeAvailable();
 }
 
+bool PNGImageDecoder::setSize(unsigned width, unsigned height)
+{
+    if (!ImageDecoder::setSize(width, height))
+        return false;
+
+    // Pick the largest factor that keeps the decoded image covering the
+    // target size.
+    m_scale = 1;
+    if (m_targetSize.width() > 0 || m_targetSize.height() > 0) {
+        unsigned scale = std::numeric_limits<unsigned>::max();
+        if (m_targetSize.width() > 0)
+            scale = std::min(scale, width / m_targetSize.width());
+        if (m_targetSize.height() > 0)
+            scale = std::min(scale, height / m_targetSize.height());
+        m_scale = std::max(scale, 1u);
+    }
+    m_decodedSize = IntSize((width + m_scale - 1) / m_scale, (height + m_scale - 1) / m_scale);
+    return true;
+}
+
 ImageFrame* PNGImageDecoder::frameBufferAtIndex(size_t index)
 {
     if (index)
@@ -402,7 +427,7 @@ void PNGImageDecoder::rowAvailable(unsigned char* rowBuffer, unsigned rowIndex,
     ImageFrame& buffer = m_frameBufferCache[0];
     if (buffer.status() == ImageFrame::FrameEmpty) {
         png_structp png = m_reader->pngPtr();
-        if (!buffer.setSize(size().width(), size().height())) {
+        if (!buffer.setSize(decodedSize().width(), decodedSize().height())) {
             longjmp(JMPBUF(png), 1);
             return;
         }
@@ -425,11 +450,16 @@ void PNGImageDecoder::rowAvailable(unsigned char* rowBuffer, unsigned rowIndex,
             }
         }
 #endif
+        if (m_scale > 1 && !m_reader->interlaceBuffer()) {
+            m_rowAccumulator.fill(0, decodedSize().width() * 4);
+            m_accumulatedRows = 0;
+        }
+
         buffer.setStatus(ImageFrame::FramePartial);
         buffer.setHasAlpha(false);
 
         // For PNGs, the frame always fills the entire image.
-        buffer.setOriginalFrameRect(IntRect(IntPoint(), size()));
+        buffer.setOriginalFrameRect(IntRect(IntPoint(), decodedSize()));
     }
 
     /* libpng comments (here to explain what follows).
@@ -488,27 +518,41 @@ void PNGImageDecoder::rowAvailable(unsigned char* rowBuffer, unsigned rowIndex,
     }
 #endif
 
+    if (m_scale == 1) {
+        writeRow(buffer, row, y, colorChannels);
+    } else if (m_reader->interlaceBuffer()) {
+        // Rows of interlaced images arrive once per pass, so they are point
+        // sampled rather than averaged.
+        if (!(y % m_scale))
+            writeRow(buffer, row, y / m_scale, colorChannels * m_scale);
+    } else {
+        accumulateRow(buffer, row, y);
+    }
+}
+
+void PNGImageDecoder::writeRow(ImageFrame& buffer, const unsigned char* row, int y, unsigned pixelStride)
+{
     // Write the decoded row pixels to the frame buffer. The repetitive
     // form of the row write loops is for speed.
     ImageFrame::PixelData* address = buffer.getAddr(0, y);
     unsigned alphaMask = 255;
-    int width = size().width();
+    int width = decodedSize().width();
 
-    png_bytep pixel = row;
-    if (hasAlpha) {
+    const unsigned char* pixel = row;
+    if (m_reader->hasAlpha()) {
         if (buffer.premultiplyAlpha()) {
-            for (int x = 0; x < width; ++x, pixel += 4) {
+            for (int x = 0; x < width; ++x, pixel += pixelStride) {
                 buffer.setRGBAPremultiply(address++, pixel[0], pixel[1], pixel[2], pixel[3]);
                 alphaMask &= pixel[3];
             }
         } else {
-            for (int x = 0; x < width; ++x, pixel += 4) {
+            for (int x = 0; x < width; ++x, pixel += pixelStride) {
                 buffer.setRGBARaw(address++, pixel[0], pixel[1], pixel[2], pixel[3]);
                 alphaMask &= pixel[3];
             }
         }
     } else {
-        for (int x = 0; x < width; ++x, pixel += 3) {
+        for (int x = 0; x < width; ++x, pixel += pixelStride) {
             buffer.setRGBARaw(address++, pixel[0], pixel[1], pixel[2], 255);
         }
     }
@@ -519,6 +563,57 @@ void PNGImageDecoder::rowAvailable(unsigned char* rowBuffer, unsigned rowIndex,
     buffer.setPixelsChanged(true);
 }
 
+void PNGImageDecoder::accumulateRow(ImageFrame& buffer, const unsigned char* row, int y)
+{
+    bool hasAlpha = m_reader->hasAlpha();
+    unsigned colorChannels = hasAlpha ? 4 : 3;
+    int width = size().width();
+
+    // Color channels are weighted by alpha so that transparent pixels do not
+    // darken their neighbors.
+    const unsigned char* pixel = row;
+    for (int x = 0; x < width; ++x, pixel += colorChannels) {
+        uint64_t* sum = &m_rowAccumulator[(x / m_scale) * 4];
+        unsigned alpha = hasAlpha ? pixel[3] : 255;
+        sum[0] += pixel[0] * alpha;
+        sum[1] += pixel[1] * alpha;
+        sum[2] += pixel[2] * alpha;
+        sum[3] += alpha;
+    }
+    ++m_accumulatedRows;
+
+    if ((y + 1) % m_scale && y != size().height() - 1)
+        return;
+
+    ImageFrame::PixelData* address = buffer.getAddr(0, y / m_scale);
+    unsigned alphaMask = 255;
+    int decodedWidth = decodedSize().width();
+    for (int x = 0; x < decodedWidth; ++x) {
+        uint64_t* sum = &m_rowAccumulator[x * 4];
+        unsigned columns = std::min<unsigned>(m_scale, width - x * m_scale);
+        uint64_t count = columns * m_accumulatedRows;
+        unsigned r = 0, g = 0, b = 0, a = 0;
+        if (sum[3]) {
+            r = sum[0] / sum[3];
+            g = sum[1] / sum[3];
+            b = sum[2] / sum[3];
+            a = (sum[3] + count / 2) / count;
+        }
+        if (buffer.premultiplyAlpha())
+            buffer.setRGBAPremultiply(address++, r, g, b, a);
+        else
+            buffer.setRGBARaw(address++, r, g, b, a);
+        alphaMask &= a;
+    }
+    m_rowAccumulator.fill(0);
+    m_accumulatedRows = 0;
+
+    if (alphaMask != 255 && !buffer.hasAlpha())
+        buffer.setHasAlpha(true);
+
+    buffer.setPixelsChanged(true);
+}
+
 void PNGImageDecoder::pngComplete()
 {
     if (!m_frameBufferCache.isEmpty())
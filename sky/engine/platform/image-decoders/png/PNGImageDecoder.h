@@ -45,6 +45,8 @@ public:
     virtual String filenameExtension() const override { return "png"; }
     virtual bool isSizeAvailable() override;
     virtual bool hasColorProfile() const override { return m_hasColorProfile; }
+    virtual IntSize decodedSize() const override { return m_decodedSize; }
+    virtual bool setSize(unsigned width, unsigned height) override;
     virtual ImageFrame* frameBufferAtIndex(size_t) override;
     // CAUTION: setFailed() deletes |m_reader|.  Be careful to avoid
     // accessing deleted memory, especially when calling this from inside
@@ -67,9 +69,23 @@ private:
     // data coming, sets the "decode failure" flag.
     void decode(bool onlySize);
 
+    // Writes every |pixelStride| bytes of |row| to row |y| of the frame.
+    void writeRow(ImageFrame&, const unsigned char* row, int y, unsigned pixelStride);
+
+    // Adds a full-size row to the running box filter, and writes a downsampled
+    // row to the frame once |m_scale| rows have been accumulated.
+    void accumulateRow(ImageFrame&, const unsigned char* row, int y);
+
     OwnPtr<PNGImageReader> m_reader;
     bool m_doNothingOnFailure;
     bool m_hasColorProfile;
+
+    // Integer downsampling factor chosen from the target size; 1 decodes at
+    // full size.
+    unsigned m_scale;
+    IntSize m_decodedSize;
+    Vector<uint64_t> m_rowAccumulator;
+    unsigned m_accumulatedRows;
 };
 
 } // namespace blink
@@ -0,0 +1,119 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "platform/image-decoders/png/PNGImageDecoder.h"
+
+#include "sky/engine/platform/SharedBuffer.h"
+#include "sky/engine/wtf/OwnPtr.h"
+#include "sky/engine/wtf/PassOwnPtr.h"
+
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+// 8x8 RGBA images. The left half is opaque red. The right half is a
+// checkerboard of opaque green, where x + y is even, and transparent black.
+// The second image is the same picture, Adam7 interlaced.
+const unsigned char checkerboardPNG[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+    0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x08,
+    0x08, 0x06, 0x00, 0x00, 0x00, 0xc4, 0x0f, 0xbe, 0x8b, 0x00, 0x00, 0x00,
+    0x1c, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0xf8, 0xcf, 0xc0, 0xf0,
+    0x1f, 0x19, 0x83, 0x21, 0x08, 0x20, 0x68, 0x34, 0x05, 0xa8, 0x92, 0xff,
+    0x19, 0x86, 0x85, 0x09, 0x00, 0x41, 0x86, 0x5f, 0xa1, 0xdb, 0x74, 0x67,
+    0x23, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60,
+    0x82,
+};
+
+const unsigned char interlacedCheckerboardPNG[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+    0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x08,
+    0x08, 0x06, 0x00, 0x00, 0x01, 0xb3, 0x08, 0x8e, 0x1d, 0x00, 0x00, 0x00,
+    0x21, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0xf8, 0xcf, 0xc0, 0x00,
+    0x46, 0xff, 0x11, 0x14, 0x76, 0x06, 0x12, 0x07, 0x9f, 0x00, 0x0c, 0x50,
+    0x20, 0x80, 0x22, 0xf1, 0x1f, 0x89, 0xa6, 0xbd, 0x02, 0x00, 0x71, 0x79,
+    0x5f, 0xa1, 0x65, 0x76, 0x4d, 0xe1, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
+    0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+PassOwnPtr<PNGImageDecoder> createDecoder(const IntSize& targetSize)
+{
+    OwnPtr<PNGImageDecoder> decoder = adoptPtr(new PNGImageDecoder(ImageSource::AlphaNotPremultiplied, ImageSource::GammaAndColorProfileIgnored, ImageDecoder::noDecodedImageByteLimit));
+    decoder->setTargetSize(targetSize);
+    return decoder.release();
+}
+
+ImageFrame* decode(PNGImageDecoder* decoder, const unsigned char* data, size_t length)
+{
+    RefPtr<SharedBuffer> buffer = SharedBuffer::create(reinterpret_cast<const char*>(data), length);
+    decoder->setData(buffer.get(), true);
+    ImageFrame* frame = decoder->frameBufferAtIndex(0);
+    if (!frame || frame->status() != ImageFrame::FrameComplete)
+        return 0;
+    EXPECT_EQ(IntSize(frame->getSkBitmap().width(), frame->getSkBitmap().height()), decoder->decodedSize());
+    return frame;
+}
+
+IntSize decodedSizeFor(const IntSize& targetSize)
+{
+    OwnPtr<PNGImageDecoder> decoder = createDecoder(targetSize);
+    if (!decode(decoder.get(), checkerboardPNG, sizeof(checkerboardPNG)))
+        return IntSize();
+    return decoder->decodedSize();
+}
+
+void expectPixel(ImageFrame* frame, int x, int y, unsigned r, unsigned g, unsigned b, unsigned a)
+{
+    SCOPED_TRACE(testing::Message() << "pixel (" << x << ", " << y << ")");
+    ImageFrame::PixelData pixel = *frame->getAddr(x, y);
+    EXPECT_EQ(r, SkGetPackedR32(pixel));
+    EXPECT_EQ(g, SkGetPackedG32(pixel));
+    EXPECT_EQ(b, SkGetPackedB32(pixel));
+    EXPECT_EQ(a, SkGetPackedA32(pixel));
+}
+
+// Tests that the decoder picks the largest integer factor that covers the
+// target size.
+TEST(PNGImageDecoderTest, downsampleToTargetSize)
+{
+    EXPECT_EQ(IntSize(2, 2), decodedSizeFor(IntSize(2, 2)));
+    EXPECT_EQ(IntSize(4, 4), decodedSizeFor(IntSize(3, 3)));
+
+    // A zero height leaves the height unconstrained.
+    EXPECT_EQ(IntSize(4, 4), decodedSizeFor(IntSize(4, 0)));
+
+    // No target, or a target larger than the image, decodes at full size.
+    EXPECT_EQ(IntSize(8, 8), decodedSizeFor(IntSize()));
+    EXPECT_EQ(IntSize(8, 8), decodedSizeFor(IntSize(16, 16)));
+}
+
+// Tests that the box filter weights colors by alpha, so that transparent
+// pixels lower the alpha of the result without darkening it.
+TEST(PNGImageDecoderTest, downsampleAveragesByAlpha)
+{
+    OwnPtr<PNGImageDecoder> decoder = createDecoder(IntSize(2, 2));
+    ImageFrame* frame = decode(decoder.get(), checkerboardPNG, sizeof(checkerboardPNG));
+    ASSERT_TRUE(frame);
+    EXPECT_TRUE(frame->hasAlpha());
+    for (int y = 0; y < 2; ++y) {
+        expectPixel(frame, 0, y, 255, 0, 0, 255);
+        expectPixel(frame, 1, y, 0, 255, 0, 128);
+    }
+}
+
+// Tests that interlaced images are point sampled.
+TEST(PNGImageDecoderTest, downsampleInterlaced)
+{
+    OwnPtr<PNGImageDecoder> decoder = createDecoder(IntSize(2, 2));
+    ImageFrame* frame = decode(decoder.get(), interlacedCheckerboardPNG, sizeof(interlacedCheckerboardPNG));
+    ASSERT_TRUE(frame);
+    for (int y = 0; y < 2; ++y) {
+        expectPixel(frame, 0, y, 255, 0, 0, 255);
+        expectPixel(frame, 1, y, 0, 255, 0, 255);
+    }
+}
+
+} // namespace
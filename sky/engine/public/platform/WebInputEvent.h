@@ -232,6 +232,14 @@ public:
     float orientation = 0;
     float tilt = 0;
 
+    // When pointer moves are coalesced, the positions of the moves that were
+    // merged into this one, oldest first.
+    enum { kMaxHistorySize = 16 };
+    int historySize = 0;
+    float historyX[kMaxHistorySize];
+    float historyY[kMaxHistorySize];
+    double historyTimeStampMS[kMaxHistorySize];
+
     WebPointerEvent() : WebInputEvent(sizeof(WebPointerEvent)) {}
 };
 
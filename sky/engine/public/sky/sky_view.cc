@@ -6,6 +6,7 @@
 
 #include "base/bind.h"
 #include "base/trace_event/trace_event.h"
+#include "sky/compositor/layer.h"
 #include "sky/engine/core/events/GestureEvent.h"
 #include "sky/engine/core/events/KeyboardEvent.h"
 #include "sky/engine/core/events/PointerEvent.h"
@@ -37,9 +38,10 @@ void SkyView::SetDisplayMetrics(const SkyDisplayMetrics& metrics) {
 }
 
 void SkyView::RunFromLibrary(const WebString& name,
-                             DartLibraryProvider* library_provider) {
+                             DartLibraryProvider* library_provider,
+                             DartSnapshotCache* snapshot_cache) {
   CreateView(name);
-  dart_controller_->RunFromLibrary(name, library_provider);
+  dart_controller_->RunFromLibrary(name, library_provider, snapshot_cache);
 }
 
 void SkyView::RunFromSnapshot(const WebString& name,
@@ -58,6 +60,12 @@ skia::RefPtr<SkPicture> SkyView::Paint() {
   return skia::RefPtr<SkPicture>();
 }
 
+std::shared_ptr<sky::compositor::Layer> SkyView::GetRootLayer() {
+  if (Scene* scene = view_->scene())
+    return scene->rootLayer();
+  return nullptr;
+}
+
 void SkyView::HandleInputEvent(const WebInputEvent& inputEvent) {
   TRACE_EVENT0("input", "SkyView::HandleInputEvent");
 
@@ -20,9 +20,16 @@
 #include "sky/engine/wtf/text/WTFString.h"
 #include "third_party/skia/include/core/SkPicture.h"
 
+namespace sky {
+namespace compositor {
+class Layer;
+}
+}
+
 namespace blink {
 class DartController;
 class DartLibraryProvider;
+class DartSnapshotCache;
 class SkyViewClient;
 class View;
 class WebInputEvent;
@@ -36,12 +43,16 @@ class SkyView {
   void SetDisplayMetrics(const SkyDisplayMetrics& metrics);
   void BeginFrame(base::TimeTicks frame_time);
 
+  // |snapshot_cache| may be null.
   void RunFromLibrary(const WebString& name,
-                      DartLibraryProvider* library_provider);
+                      DartLibraryProvider* library_provider,
+                      DartSnapshotCache* snapshot_cache);
   void RunFromSnapshot(const WebString& name,
                        mojo::ScopedDataPipeConsumerHandle snapshot);
 
   skia::RefPtr<SkPicture> Paint();
+  // Returns the root of the view's scene, if it has one.
+  std::shared_ptr<sky::compositor::Layer> GetRootLayer();
   void HandleInputEvent(const WebInputEvent& event);
 
  private:
@@ -31,6 +31,8 @@
 #ifndef SKY_ENGINE_PUBLIC_WEB_SKY_H_
 #define SKY_ENGINE_PUBLIC_WEB_SKY_H_
 
+#include <string>
+
 #include "../platform/Platform.h"
 
 namespace blink {
@@ -46,6 +48,10 @@ BLINK_EXPORT void initialize(Platform*);
 // terminated by the time this function returns.
 BLINK_EXPORT void shutdown();
 
+// Identifies the Dart VM and the engine's Dart libraries. Caches of compiled
+// Dart code are only valid for the build that wrote them.
+BLINK_EXPORT std::string dartBuildIdentity();
+
 // Alters the rendering of content to conform to a fixed set of rules.
 BLINK_EXPORT void setLayoutTestMode(bool);
 BLINK_EXPORT bool layoutTestMode();
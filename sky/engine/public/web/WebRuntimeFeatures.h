@@ -96,6 +96,8 @@ public:
 
     BLINK_EXPORT static void enableDartCheckedMode(bool);
 
+    BLINK_EXPORT static void enableDartLibraryPrefetch(bool);
+
 private:
     WebRuntimeFeatures();
 };
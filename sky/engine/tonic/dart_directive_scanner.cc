@@ -0,0 +1,125 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/tonic/dart_directive_scanner.h"
+
+#include "base/strings/string_util.h"
+
+namespace blink {
+namespace {
+
+bool IsIdentifierChar(char c) {
+  return base::IsAsciiAlpha(c) || base::IsAsciiDigit(c) || c == '_' ||
+         c == '$';
+}
+
+}  // namespace
+
+DartDirectiveScanner::DartDirectiveScanner(const uint8_t* data, size_t size)
+    : data_(reinterpret_cast<const char*>(data)), size_(size), pos_(0) {
+}
+
+DartDirectiveScanner::~DartDirectiveScanner() {
+}
+
+bool DartDirectiveScanner::Scan(std::vector<std::string>* uris) {
+  if (size_ >= 2 && data_[0] == '#' && data_[1] == '!') {
+    if (!SkipPast('\n'))
+      return false;
+  }
+  while (true) {
+    if (!SkipWhitespaceAndComments())
+      return false;
+    std::string keyword = ReadIdentifier();
+    // The identifier might continue past the end of the input.
+    if (AtEnd())
+      return false;
+    if (keyword != "library" && keyword != "import" && keyword != "export" &&
+        keyword != "part")
+      return true;
+
+    std::string uri;
+    if (keyword != "library") {
+      if (!SkipWhitespaceAndComments())
+        return false;
+      char quote = data_[pos_];
+      // Anything other than a string is "part of", which names no URI.
+      if (quote == '\'' || quote == '"') {
+        size_t start = ++pos_;
+        if (!SkipPast(quote))
+          return false;
+        uri.assign(data_ + start, pos_ - start - 1);
+      }
+    }
+    if (!SkipPastSemicolon())
+      return false;
+    if (!uri.empty())
+      uris->push_back(uri);
+  }
+}
+
+std::string DartDirectiveScanner::ReadIdentifier() {
+  size_t start = pos_;
+  while (!AtEnd() && IsIdentifierChar(data_[pos_]))
+    ++pos_;
+  return std::string(data_ + start, pos_ - start);
+}
+
+bool DartDirectiveScanner::SkipPast(char c) {
+  while (!AtEnd()) {
+    if (data_[pos_++] == c)
+      return true;
+  }
+  return false;
+}
+
+// Returns false if the input ends before something other than whitespace or
+// a comment.
+bool DartDirectiveScanner::SkipWhitespaceAndComments() {
+  while (!AtEnd()) {
+    char c = data_[pos_];
+    if (base::IsAsciiWhitespace(c)) {
+      ++pos_;
+    } else if (c == '/' && pos_ + 1 < size_ && data_[pos_ + 1] == '/') {
+      if (!SkipPast('\n'))
+        return false;
+    } else if (c == '/' && pos_ + 1 < size_ && data_[pos_ + 1] == '*') {
+      pos_ += 2;
+      if (!SkipPastCommentEnd())
+        return false;
+    } else if (c == '/' && pos_ + 1 == size_) {
+      // Can't tell yet whether this starts a comment.
+      return false;
+    } else {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool DartDirectiveScanner::SkipPastCommentEnd() {
+  while (pos_ + 1 < size_) {
+    if (data_[pos_] == '*' && data_[pos_ + 1] == '/') {
+      pos_ += 2;
+      return true;
+    }
+    ++pos_;
+  }
+  return false;
+}
+
+// Skips the rest of a directive, such as its prefix and show and hide
+// clauses.
+bool DartDirectiveScanner::SkipPastSemicolon() {
+  while (!AtEnd()) {
+    char c = data_[pos_++];
+    if (c == ';')
+      return true;
+    if ((c == '\'' || c == '"') && !SkipPast(c))
+      return false;
+  }
+  return false;
+}
+
+}  // namespace blink
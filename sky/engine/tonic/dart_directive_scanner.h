@@ -0,0 +1,49 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_TONIC_DART_DIRECTIVE_SCANNER_H_
+#define SKY_ENGINE_TONIC_DART_DIRECTIVE_SCANNER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace blink {
+
+// Finds the URIs named by the import, export and part directives at the top
+// of a Dart source. This is not a Dart parser. It stops at the first thing
+// that isn't a directive, and it only reports a directive once it has seen
+// the semicolon that ends it, so it is safe to run on a prefix of a source.
+class DartDirectiveScanner {
+ public:
+  DartDirectiveScanner(const uint8_t* data, size_t size);
+  ~DartDirectiveScanner();
+
+  // Appends the URIs found to |uris|. Returns true if the scanner reached the
+  // end of the directives, or false if it ran out of input first.
+  bool Scan(std::vector<std::string>* uris);
+
+ private:
+  bool AtEnd() const { return pos_ >= size_; }
+
+  std::string ReadIdentifier();
+  bool SkipPast(char c);
+  bool SkipWhitespaceAndComments();
+  bool SkipPastCommentEnd();
+  bool SkipPastSemicolon();
+
+  const char* data_;
+  size_t size_;
+  size_t pos_;
+
+  DISALLOW_COPY_AND_ASSIGN(DartDirectiveScanner);
+};
+
+}  // namespace blink
+
+#endif  // SKY_ENGINE_TONIC_DART_DIRECTIVE_SCANNER_H_
@@ -0,0 +1,125 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/tonic/dart_directive_scanner.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace blink {
+namespace {
+
+bool Scan(const std::string& source, std::vector<std::string>* uris) {
+  return DartDirectiveScanner(
+             reinterpret_cast<const uint8_t*>(source.data()), source.size())
+      .Scan(uris);
+}
+
+std::vector<std::string> ScanAll(const std::string& source) {
+  std::vector<std::string> uris;
+  EXPECT_TRUE(Scan(source, &uris)) << source;
+  return uris;
+}
+
+TEST(DartDirectiveScannerTest, FindsImportsExportsAndParts) {
+  std::vector<std::string> uris = ScanAll(
+      "library foo;\n"
+      "import 'dart:async';\n"
+      "import \"package:sky/widgets.dart\" as widgets show Widget;\n"
+      "export 'src/exported.dart' hide Hidden;\n"
+      "part 'src/part.dart';\n"
+      "\n"
+      "void main() {}\n");
+  ASSERT_EQ(4u, uris.size());
+  EXPECT_EQ("dart:async", uris[0]);
+  EXPECT_EQ("package:sky/widgets.dart", uris[1]);
+  EXPECT_EQ("src/exported.dart", uris[2]);
+  EXPECT_EQ("src/part.dart", uris[3]);
+}
+
+TEST(DartDirectiveScannerTest, PartOfNamesNoUri) {
+  EXPECT_TRUE(ScanAll("part of foo;\nclass Bar {}\n").empty());
+}
+
+TEST(DartDirectiveScannerTest, SkipsComments) {
+  std::vector<std::string> uris = ScanAll(
+      "// import 'line_comment.dart';\n"
+      "/* import 'block_comment.dart'; */\n"
+      "/**\n"
+      " * import 'doc_comment.dart';\n"
+      " */\n"
+      "import /* inline */ 'a.dart'; // trailing\n"
+      "import // between\n"
+      "    'b.dart';\n"
+      "class A {}\n");
+  ASSERT_EQ(2u, uris.size());
+  EXPECT_EQ("a.dart", uris[0]);
+  EXPECT_EQ("b.dart", uris[1]);
+}
+
+TEST(DartDirectiveScannerTest, SkipsStringsInDirectives) {
+  std::vector<std::string> uris = ScanAll(
+      "import 'semi;colon.dart';\n"
+      "import \"it's.dart\";\n"
+      "import 'a.dart' as a;\n"
+      "class A {}\n");
+  ASSERT_EQ(3u, uris.size());
+  EXPECT_EQ("semi;colon.dart", uris[0]);
+  EXPECT_EQ("it's.dart", uris[1]);
+  EXPECT_EQ("a.dart", uris[2]);
+}
+
+TEST(DartDirectiveScannerTest, SkipsScriptTag) {
+  std::vector<std::string> uris =
+      ScanAll("#!/usr/bin/env dart import 'no.dart';\nimport 'yes.dart';\n"
+              "main() {}\n");
+  ASSERT_EQ(1u, uris.size());
+  EXPECT_EQ("yes.dart", uris[0]);
+}
+
+TEST(DartDirectiveScannerTest, StopsAtFirstDeclaration) {
+  std::vector<std::string> uris = ScanAll(
+      "import 'a.dart';\n"
+      "const String s = \"import 'b.dart';\";\n"
+      "import 'c.dart';\n");
+  ASSERT_EQ(1u, uris.size());
+  EXPECT_EQ("a.dart", uris[0]);
+}
+
+TEST(DartDirectiveScannerTest, IdentifiersStartingWithKeywordsEndDirectives) {
+  std::vector<std::string> uris =
+      ScanAll("import 'a.dart';\nimportant() {}\n");
+  ASSERT_EQ(1u, uris.size());
+}
+
+TEST(DartDirectiveScannerTest, PrefixesReportOnlyFinishedDirectives) {
+  const std::string source =
+      "import 'a.dart';\n"
+      "/* comment */\n"
+      "import 'b.dart' as b;\n"
+      "main() {}\n";
+  const size_t end_of_directives = source.find("main");
+  for (size_t length = 0; length < end_of_directives; ++length) {
+    std::vector<std::string> uris;
+    EXPECT_FALSE(Scan(source.substr(0, length), &uris)) << length;
+    size_t expected = 0;
+    if (length > source.find(';'))
+      ++expected;
+    if (length > source.find(';', source.find("'b.dart'")))
+      ++expected;
+    EXPECT_EQ(expected, uris.size()) << length;
+  }
+  std::vector<std::string> uris;
+  EXPECT_TRUE(Scan(source, &uris));
+  EXPECT_EQ(2u, uris.size());
+}
+
+TEST(DartDirectiveScannerTest, EmptySourceIsUnfinished) {
+  std::vector<std::string> uris;
+  EXPECT_FALSE(Scan("", &uris));
+  EXPECT_FALSE(Scan("// just a comment", &uris));
+  EXPECT_TRUE(uris.empty());
+}
+
+}  // namespace
+}  // namespace blink
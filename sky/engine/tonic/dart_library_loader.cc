@@ -12,6 +12,7 @@
 #include "sky/engine/tonic/dart_dependency_catcher.h"
 #include "sky/engine/tonic/dart_error.h"
 #include "sky/engine/tonic/dart_isolate_scope.h"
+#include "sky/engine/tonic/dart_library_prefetcher.h"
 #include "sky/engine/tonic/dart_library_provider.h"
 #include "sky/engine/tonic/dart_state.h"
 
@@ -38,9 +39,13 @@ class DartLibraryLoader::Job : public DartDependency,
                                public DataPipeDrainer::Client {
  public:
   Job(DartLibraryLoader* loader, const std::string& name)
-      : loader_(loader), name_(name), weak_factory_(this) {
-    loader->library_provider()->GetLibraryAsStream(
-        name, base::Bind(&Job::OnStreamAvailable, weak_factory_.GetWeakPtr()));
+      : loader_(loader), name_(name), scanned_(false), weak_factory_(this) {
+    DartLibraryPrefetcher* prefetcher = loader->prefetcher();
+    if (prefetcher &&
+        prefetcher->Take(name, base::Bind(&Job::OnPrefetched,
+                                          weak_factory_.GetWeakPtr())))
+      return;
+    FetchFromProvider();
   }
 
   const std::string& name() const { return name_; }
@@ -51,6 +56,20 @@ class DartLibraryLoader::Job : public DartDependency,
   std::vector<uint8_t> buffer_;
 
  private:
+  void FetchFromProvider() {
+    loader_->library_provider()->GetLibraryAsStream(
+        name_, base::Bind(&Job::OnStreamAvailable, weak_factory_.GetWeakPtr()));
+  }
+
+  void OnPrefetched(bool success, const std::vector<uint8_t>& buffer) {
+    if (!success) {
+      FetchFromProvider();
+      return;
+    }
+    buffer_ = buffer;
+    OnDataComplete();
+  }
+
   void OnStreamAvailable(mojo::ScopedDataPipeConsumerHandle pipe) {
     if (!pipe.is_valid()) {
       loader_->DidFailJob(this);
@@ -63,10 +82,14 @@ class DartLibraryLoader::Job : public DartDependency,
   void OnDataAvailable(const void* data, size_t num_bytes) override {
     const uint8_t* bytes = static_cast<const uint8_t*>(data);
     buffer_.insert(buffer_.end(), bytes, bytes + num_bytes);
+    DartLibraryPrefetcher* prefetcher = loader_->prefetcher();
+    if (prefetcher && !scanned_)
+      scanned_ = prefetcher->Scan(name_, buffer_);
   }
   // Subclasses must implement OnDataComplete.
 
   std::string name_;
+  bool scanned_;
   OwnPtr<DataPipeDrainer> drainer_;
 
   base::WeakPtrFactory<Job> weak_factory_;
@@ -74,17 +97,22 @@ class DartLibraryLoader::Job : public DartDependency,
 
 class DartLibraryLoader::ImportJob : public Job {
  public:
-  ImportJob(DartLibraryLoader* loader, const std::string& name) : Job(loader, name) {
+  ImportJob(DartLibraryLoader* loader, const std::string& name, bool is_script)
+      : Job(loader, name), is_script_(is_script) {
     TRACE_EVENT_ASYNC_BEGIN1("sky", "DartLibraryLoader::ImportJob", this, "url",
                              name);
   }
 
+  bool is_script() const { return is_script_; }
+
  private:
   // DataPipeDrainer::Client
   void OnDataComplete() override {
     TRACE_EVENT_ASYNC_END0("sky", "DartLibraryLoader::ImportJob", this);
     loader_->DidCompleteImportJob(this, buffer_);
   }
+
+  bool is_script_;
 };
 
 class DartLibraryLoader::SourceJob : public Job {
@@ -185,7 +213,9 @@ class DartLibraryLoader::WatcherSignaler {
 DartLibraryLoader::DartLibraryLoader(DartState* dart_state)
     : dart_state_(dart_state),
       library_provider_(nullptr),
-      dependency_catcher_(nullptr) {
+      dependency_catcher_(nullptr),
+      prefetch_enabled_(false),
+      record_sources_(false) {
 }
 
 DartLibraryLoader::~DartLibraryLoader() {
@@ -222,7 +252,8 @@ void DartLibraryLoader::LoadLibrary(const std::string& name) {
   const auto& result = pending_libraries_.insert(std::make_pair(name, nullptr));
   if (result.second) {
     // New entry.
-    std::unique_ptr<Job> job = std::unique_ptr<Job>(new ImportJob(this, name));
+    std::unique_ptr<Job> job =
+        std::unique_ptr<Job>(new ImportJob(this, name, false));
     result.first->second = job.get();
     jobs_.insert(std::move(job));
   }
@@ -230,6 +261,16 @@ void DartLibraryLoader::LoadLibrary(const std::string& name) {
     dependency_catcher_->AddDependency(result.first->second);
 }
 
+void DartLibraryLoader::LoadScript(const std::string& name) {
+  DCHECK(pending_libraries_.find(name) == pending_libraries_.end());
+  std::unique_ptr<Job> job =
+      std::unique_ptr<Job>(new ImportJob(this, name, true));
+  pending_libraries_[name] = job.get();
+  if (dependency_catcher_)
+    dependency_catcher_->AddDependency(job.get());
+  jobs_.insert(std::move(job));
+}
+
 Dart_Handle DartLibraryLoader::Import(Dart_Handle library, Dart_Handle url) {
   LoadLibrary(StdStringFromDart(url));
   return Dart_True();
@@ -257,16 +298,20 @@ void DartLibraryLoader::DidCompleteImportJob(
 
   WatcherSignaler watcher_signaler(*this, job);
 
-  Dart_Handle result = Dart_LoadLibrary(
-      StdStringToDart(job->name()),
-      Dart_NewStringFromUTF8(buffer.data(), buffer.size()), 0, 0);
+  Dart_Handle url = StdStringToDart(job->name());
+  Dart_Handle source = Dart_NewStringFromUTF8(buffer.data(), buffer.size());
+  Dart_Handle result = job->is_script() ? Dart_LoadScript(url, source, 0, 0)
+                                        : Dart_LoadLibrary(url, source, 0, 0);
   if (Dart_IsError(result)) {
     LOG(ERROR) << "Error Loading " << job->name() << " "
         << Dart_GetError(result);
+    set_record_sources(false);
+  } else {
+    RecordSource(job->name(), buffer);
   }
 
   pending_libraries_.erase(job->name());
-  EraseUniquePtr<Job>(jobs_, job);
+  EraseJob(job);
 }
 
 void DartLibraryLoader::DidCompleteSourceJob(
@@ -285,9 +330,12 @@ void DartLibraryLoader::DidCompleteSourceJob(
   if (Dart_IsError(result)) {
     LOG(ERROR) << "Error Loading " << job->name() << " "
         << Dart_GetError(result);
+    set_record_sources(false);
+  } else {
+    RecordSource(job->name(), buffer);
   }
 
-  EraseUniquePtr<Job>(jobs_, job);
+  EraseJob(job);
 }
 
 void DartLibraryLoader::DidFailJob(Job* job) {
@@ -298,8 +346,35 @@ void DartLibraryLoader::DidFailJob(Job* job) {
 
   LOG(ERROR) << "Library Load failed: " << job->name();
   // TODO(eseidel): Call Dart_LibraryHandleError in the SourceJob case?
+  set_record_sources(false);
+
+  EraseJob(job);
+}
 
+void DartLibraryLoader::EraseJob(Job* job) {
   EraseUniquePtr<Job>(jobs_, job);
+  // Once nothing is loading, anything still prefetched was never imported.
+  if (jobs_.empty())
+    prefetcher_ = nullptr;
+}
+
+DartLibraryPrefetcher* DartLibraryLoader::prefetcher() {
+  if (!prefetcher_ && prefetch_enabled_ && library_provider_) {
+    prefetcher_ = std::unique_ptr<DartLibraryPrefetcher>(
+        new DartLibraryPrefetcher(library_provider_,
+                                  DartLibraryPrefetcher::kDefaultMaxInFlight));
+  }
+  return prefetcher_.get();
+}
+
+void DartLibraryLoader::RecordSource(const std::string& name,
+                                     const std::vector<uint8_t>& buffer) {
+  if (!record_sources_)
+    return;
+  DartSnapshotCache::Source source;
+  source.url = name;
+  source.hash = DartSnapshotCache::HashContent(buffer);
+  loaded_sources_.push_back(source);
 }
 
 }  // namespace blink
@@ -15,10 +15,12 @@
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "dart/runtime/include/dart_api.h"
+#include "sky/engine/tonic/dart_snapshot_cache.h"
 
 namespace blink {
 class DartDependency;
 class DartDependencyCatcher;
+class DartLibraryPrefetcher;
 class DartLibraryProvider;
 class DartState;
 
@@ -37,6 +39,8 @@ class DartLibraryLoader {
                                       Dart_Handle url);
 
   void LoadLibrary(const std::string& name);
+  // Loads |name| as the isolate's root library, which must not exist yet.
+  void LoadScript(const std::string& name);
 
   void WaitForDependencies(
       const std::unordered_set<DartDependency*>& dependencies,
@@ -56,6 +60,26 @@ class DartLibraryLoader {
     library_provider_ = library_provider;
   }
 
+  // When enabled, the loader fetches the libraries and parts named by each
+  // source's directives as soon as they arrive, rather than waiting for the
+  // VM to ask for them one at a time.
+  void set_prefetch_enabled(bool prefetch_enabled) {
+    prefetch_enabled_ = prefetch_enabled;
+  }
+
+  // While recording, the loader remembers the URL and content hash of every
+  // library and part it loads so that the result can be stored in a
+  // DartSnapshotCache. Recording stops if any load fails.
+  void set_record_sources(bool record_sources) {
+    record_sources_ = record_sources;
+    if (!record_sources_)
+      loaded_sources_.clear();
+  }
+  bool record_sources() const { return record_sources_; }
+  const std::vector<DartSnapshotCache::Source>& loaded_sources() const {
+    return loaded_sources_;
+  }
+
  private:
   class Job;
   class ImportJob;
@@ -69,6 +93,10 @@ class DartLibraryLoader {
   void DidCompleteImportJob(ImportJob* job, const std::vector<uint8_t>& buffer);
   void DidCompleteSourceJob(SourceJob* job, const std::vector<uint8_t>& buffer);
   void DidFailJob(Job* job);
+  void EraseJob(Job* job);
+  DartLibraryPrefetcher* prefetcher();
+  void RecordSource(const std::string& name,
+                    const std::vector<uint8_t>& buffer);
 
   DartState* dart_state_;
   DartLibraryProvider* library_provider_;
@@ -76,6 +104,10 @@ class DartLibraryLoader {
   std::unordered_set<std::unique_ptr<Job>> jobs_;
   std::unordered_set<std::unique_ptr<DependencyWatcher>> dependency_watchers_;
   DartDependencyCatcher* dependency_catcher_;
+  bool prefetch_enabled_;
+  std::unique_ptr<DartLibraryPrefetcher> prefetcher_;
+  bool record_sources_;
+  std::vector<DartSnapshotCache::Source> loaded_sources_;
 
   DISALLOW_COPY_AND_ASSIGN(DartLibraryLoader);
 };
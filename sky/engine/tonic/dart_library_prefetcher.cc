@@ -0,0 +1,188 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/tonic/dart_library_prefetcher.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "base/strings/string_util.h"
+#include "base/trace_event/trace_event.h"
+#include "mojo/common/data_pipe_drainer.h"
+#include "sky/engine/tonic/dart_directive_scanner.h"
+#include "sky/engine/tonic/dart_library_provider.h"
+
+using mojo::common::DataPipeDrainer;
+
+namespace blink {
+class DartLibraryPrefetcher::Fetch : public DataPipeDrainer::Client {
+ public:
+  Fetch(DartLibraryPrefetcher* prefetcher, const std::string& url)
+      : prefetcher_(prefetcher),
+        url_(url),
+        done_(false),
+        failed_(false),
+        scanned_(false),
+        weak_factory_(this) {
+    TRACE_EVENT_ASYNC_BEGIN1("sky", "DartLibraryPrefetcher::Fetch", this,
+                             "url", url);
+    prefetcher_->provider_->GetLibraryAsStream(
+        url, base::Bind(&Fetch::OnStreamAvailable, weak_factory_.GetWeakPtr()));
+  }
+
+  ~Fetch() override {
+    TRACE_EVENT_ASYNC_END0("sky", "DartLibraryPrefetcher::Fetch", this);
+  }
+
+  const std::string& url() const { return url_; }
+  bool done() const { return done_; }
+  bool failed() const { return failed_; }
+  std::vector<uint8_t>& buffer() { return buffer_; }
+
+  // The callback of whoever is waiting for this fetch, if anyone.
+  TakeCallback& callback() { return callback_; }
+
+ private:
+  void OnStreamAvailable(mojo::ScopedDataPipeConsumerHandle pipe) {
+    if (!pipe.is_valid()) {
+      failed_ = true;
+      prefetcher_->DidFinishFetch(this);
+      return;
+    }
+    drainer_ = std::unique_ptr<DataPipeDrainer>(
+        new DataPipeDrainer(this, pipe.Pass()));
+  }
+
+  // DataPipeDrainer::Client
+  void OnDataAvailable(const void* data, size_t num_bytes) override {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + num_bytes);
+    if (!scanned_)
+      scanned_ = prefetcher_->Scan(url_, buffer_);
+  }
+
+  void OnDataComplete() override {
+    if (!scanned_)
+      prefetcher_->Scan(url_, buffer_);
+    done_ = true;
+    prefetcher_->DidFinishFetch(this);
+  }
+
+  DartLibraryPrefetcher* prefetcher_;
+  std::string url_;
+  bool done_;
+  bool failed_;
+  bool scanned_;
+  std::vector<uint8_t> buffer_;
+  TakeCallback callback_;
+  std::unique_ptr<DataPipeDrainer> drainer_;
+
+  base::WeakPtrFactory<Fetch> weak_factory_;
+};
+
+const size_t DartLibraryPrefetcher::kDefaultMaxInFlight = 8;
+
+DartLibraryPrefetcher::DartLibraryPrefetcher(DartLibraryProvider* provider,
+                                             size_t max_in_flight)
+    : provider_(provider),
+      max_in_flight_(max_in_flight),
+      in_flight_(0),
+      weak_factory_(this) {
+  DCHECK(max_in_flight_);
+}
+
+DartLibraryPrefetcher::~DartLibraryPrefetcher() {
+}
+
+bool DartLibraryPrefetcher::Scan(const std::string& url,
+                                 const std::vector<uint8_t>& buffer) {
+  std::vector<std::string> uris;
+  bool done = DartDirectiveScanner(buffer.data(), buffer.size()).Scan(&uris);
+  for (const auto& uri : uris) {
+    if (base::StartsWithASCII(uri, "dart:", true))
+      continue;
+    std::string resolved = provider_->ResolveURL(url, uri);
+    if (!resolved.empty())
+      Enqueue(resolved);
+  }
+  StartFetches();
+  return done;
+}
+
+bool DartLibraryPrefetcher::Take(const std::string& url,
+                                 const TakeCallback& callback) {
+  seen_.insert(url);
+  auto queued = std::find(queue_.begin(), queue_.end(), url);
+  if (queued != queue_.end()) {
+    // The VM is waiting for this one, so start it ahead of the rest of the
+    // queue, even if that goes over |max_in_flight_|.
+    queue_.erase(queued);
+    StartFetch(url);
+  }
+
+  auto it = fetches_.find(url);
+  if (it == fetches_.end())
+    return false;
+  Fetch* fetch = it->second.get();
+  if (fetch->failed()) {
+    fetches_.erase(it);
+    return false;
+  }
+
+  DCHECK(fetch->callback().is_null());
+  fetch->callback() = callback;
+  if (fetch->done()) {
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE, base::Bind(&DartLibraryPrefetcher::Deliver,
+                              weak_factory_.GetWeakPtr(), url));
+  }
+  return true;
+}
+
+void DartLibraryPrefetcher::Enqueue(const std::string& url) {
+  if (seen_.insert(url).second)
+    queue_.push_back(url);
+}
+
+void DartLibraryPrefetcher::StartFetches() {
+  while (in_flight_ < max_in_flight_ && !queue_.empty()) {
+    std::string url = queue_.front();
+    queue_.pop_front();
+    StartFetch(url);
+  }
+}
+
+void DartLibraryPrefetcher::StartFetch(const std::string& url) {
+  ++in_flight_;
+  fetches_[url] = std::unique_ptr<Fetch>(new Fetch(this, url));
+}
+
+void DartLibraryPrefetcher::DidFinishFetch(Fetch* fetch) {
+  DCHECK(in_flight_);
+  --in_flight_;
+  StartFetches();
+  if (!fetch->callback().is_null())
+    Deliver(fetch->url());
+}
+
+void DartLibraryPrefetcher::Deliver(const std::string& url) {
+  auto it = fetches_.find(url);
+  if (it == fetches_.end())
+    return;
+  // Take everything we need before running the callback, which can call
+  // back into us.
+  std::unique_ptr<Fetch> fetch = std::move(it->second);
+  fetches_.erase(it);
+  TakeCallback callback = fetch->callback();
+  std::vector<uint8_t> buffer;
+  buffer.swap(fetch->buffer());
+  bool success = !fetch->failed();
+  // |fetch| may be the drainer client that called us, so it has to outlive
+  // this call stack.
+  base::MessageLoop::current()->DeleteSoon(FROM_HERE, fetch.release());
+  callback.Run(success, buffer);
+}
+
+}  // namespace blink
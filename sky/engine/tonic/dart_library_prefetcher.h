@@ -0,0 +1,80 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_TONIC_DART_LIBRARY_PREFETCHER_H_
+#define SKY_ENGINE_TONIC_DART_LIBRARY_PREFETCHER_H_
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+
+namespace blink {
+class DartLibraryProvider;
+
+// Fetches libraries and parts before the VM asks for them. Sources are
+// scanned for import, export and part directives as their bytes arrive, and
+// every URL found is requested from the provider, with at most
+// |max_in_flight| requests outstanding at once.
+//
+// The prefetcher only buffers data. The DartLibraryLoader still hands each
+// source to the VM when the VM asks for it, so libraries reach the VM in
+// dependency order.
+class DartLibraryPrefetcher {
+ public:
+  // Called with the prefetched source, or with |success| false if the
+  // prefetch failed and the caller should fetch the URL itself.
+  typedef base::Callback<void(bool success, const std::vector<uint8_t>&)>
+      TakeCallback;
+
+  DartLibraryPrefetcher(DartLibraryProvider* provider, size_t max_in_flight);
+  ~DartLibraryPrefetcher();
+
+  static const size_t kDefaultMaxInFlight;
+
+  // Scans the first |buffer| bytes of the source at |url| for directives and
+  // prefetches the URLs they name. |buffer| may be a prefix of the source.
+  // Returns true once the directives have all been seen, after which there
+  // is no need to call Scan for |url| again.
+  bool Scan(const std::string& url, const std::vector<uint8_t>& buffer);
+
+  // Claims the prefetch for |url|, starting it now if it was still queued.
+  // Returns false if |url| was never found in a directive or its prefetch
+  // already failed, in which case the caller should fetch |url| itself.
+  // Otherwise |callback| is called asynchronously. Either way |url| is not
+  // prefetched again after this call.
+  bool Take(const std::string& url, const TakeCallback& callback);
+
+ private:
+  class Fetch;
+
+  void Enqueue(const std::string& url);
+  void StartFetches();
+  void StartFetch(const std::string& url);
+  void DidFinishFetch(Fetch* fetch);
+  void Deliver(const std::string& url);
+
+  DartLibraryProvider* provider_;
+  size_t max_in_flight_;
+  size_t in_flight_;
+
+  // Every URL that has been prefetched or taken, so none is fetched twice.
+  std::unordered_set<std::string> seen_;
+  std::deque<std::string> queue_;
+  std::unordered_map<std::string, std::unique_ptr<Fetch>> fetches_;
+
+  base::WeakPtrFactory<DartLibraryPrefetcher> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(DartLibraryPrefetcher);
+};
+
+}  // namespace blink
+
+#endif  // SKY_ENGINE_TONIC_DART_LIBRARY_PREFETCHER_H_
@@ -0,0 +1,180 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/tonic/dart_library_prefetcher.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "mojo/common/data_pipe_utils.h"
+#include "mojo/common/message_pump_mojo.h"
+#include "sky/engine/tonic/dart_library_provider.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace blink {
+namespace {
+
+// Serves sources from memory and counts how often each one is requested.
+class TestLibraryProvider : public DartLibraryProvider {
+ public:
+  TestLibraryProvider() {}
+  ~TestLibraryProvider() override {}
+
+  void AddSource(const std::string& url, const std::string& source) {
+    sources_[url] = source;
+  }
+
+  int RequestCount(const std::string& url) { return requests_[url]; }
+
+  void GetLibraryAsStream(const std::string& name,
+                          DataPipeConsumerCallback callback) override {
+    ++requests_[name];
+    mojo::ScopedDataPipeConsumerHandle consumer;
+    auto it = sources_.find(name);
+    if (it != sources_.end()) {
+      mojo::DataPipe pipe;
+      mojo::common::BlockingCopyFromString(it->second, pipe.producer_handle);
+      consumer = pipe.consumer_handle.Pass();
+    }
+    // An invalid handle tells the caller that |name| doesn't exist.
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE, base::Bind(callback, base::Passed(&consumer)));
+  }
+
+  Dart_Handle CanonicalizeURL(Dart_Handle library, Dart_Handle url) override {
+    return url;
+  }
+
+  std::string ResolveURL(const std::string& library_url,
+                         const std::string& url) override {
+    return url;
+  }
+
+ private:
+  std::map<std::string, std::string> sources_;
+  std::map<std::string, int> requests_;
+};
+
+struct TakeResult {
+  TakeResult() : called(false), success(false) {}
+
+  bool called;
+  bool success;
+  std::string source;
+};
+
+void DidTake(TakeResult* result,
+             bool success,
+             const std::vector<uint8_t>& buffer) {
+  result->called = true;
+  result->success = success;
+  result->source.assign(buffer.begin(), buffer.end());
+}
+
+class DartLibraryPrefetcherTest : public testing::Test {
+ protected:
+  DartLibraryPrefetcherTest()
+      : loop_(mojo::common::MessagePumpMojo::Create()) {}
+
+  void Scan(DartLibraryPrefetcher* prefetcher,
+            const std::string& url,
+            const std::string& source) {
+    prefetcher->Scan(url, std::vector<uint8_t>(source.begin(), source.end()));
+  }
+
+  bool Take(DartLibraryPrefetcher* prefetcher,
+            const std::string& url,
+            TakeResult* result) {
+    return prefetcher->Take(url, base::Bind(&DidTake, result));
+  }
+
+  TestLibraryProvider provider_;
+
+ private:
+  base::MessageLoop loop_;
+};
+
+TEST_F(DartLibraryPrefetcherTest, DeliversPrefetchedSource) {
+  provider_.AddSource("a.dart", "library a;");
+  DartLibraryPrefetcher prefetcher(&provider_, 8);
+  Scan(&prefetcher, "main.dart", "import 'a.dart';\nmain() {}\n");
+  EXPECT_EQ(1, provider_.RequestCount("a.dart"));
+  base::RunLoop().RunUntilIdle();
+
+  TakeResult result;
+  EXPECT_TRUE(Take(&prefetcher, "a.dart", &result));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(result.called);
+  EXPECT_TRUE(result.success);
+  EXPECT_EQ("library a;", result.source);
+  EXPECT_EQ(1, provider_.RequestCount("a.dart"));
+}
+
+TEST_F(DartLibraryPrefetcherTest, TakeWaitsForFetchInFlight) {
+  provider_.AddSource("a.dart", "library a;");
+  DartLibraryPrefetcher prefetcher(&provider_, 8);
+  Scan(&prefetcher, "main.dart", "import 'a.dart';\nmain() {}\n");
+
+  TakeResult result;
+  EXPECT_TRUE(Take(&prefetcher, "a.dart", &result));
+  EXPECT_FALSE(result.called);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(result.success);
+  EXPECT_EQ("library a;", result.source);
+  EXPECT_EQ(1, provider_.RequestCount("a.dart"));
+}
+
+TEST_F(DartLibraryPrefetcherTest, TakeStartsQueuedFetch) {
+  provider_.AddSource("a.dart", "library a;");
+  provider_.AddSource("b.dart", "library b;");
+  DartLibraryPrefetcher prefetcher(&provider_, 1);
+  Scan(&prefetcher, "main.dart",
+       "import 'a.dart';\nimport 'b.dart';\nmain() {}\n");
+  EXPECT_EQ(1, provider_.RequestCount("a.dart"));
+  EXPECT_EQ(0, provider_.RequestCount("b.dart"));
+
+  TakeResult result;
+  EXPECT_TRUE(Take(&prefetcher, "b.dart", &result));
+  EXPECT_EQ(1, provider_.RequestCount("b.dart"));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(result.success);
+  EXPECT_EQ("library b;", result.source);
+  EXPECT_EQ(1, provider_.RequestCount("b.dart"));
+}
+
+TEST_F(DartLibraryPrefetcherTest, PrefetchesImportsOfPrefetchedSources) {
+  provider_.AddSource("a.dart", "import 'b.dart';\nclass A {}\n");
+  provider_.AddSource("b.dart", "part 'c.dart';\nclass B {}\n");
+  provider_.AddSource("c.dart", "part of b;\n");
+  DartLibraryPrefetcher prefetcher(&provider_, 8);
+  Scan(&prefetcher, "main.dart", "import 'a.dart';\nmain() {}\n");
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, provider_.RequestCount("b.dart"));
+  EXPECT_EQ(1, provider_.RequestCount("c.dart"));
+
+  // Seeing the same import again doesn't fetch it twice.
+  Scan(&prefetcher, "other.dart", "import 'b.dart';\nmain() {}\n");
+  EXPECT_EQ(1, provider_.RequestCount("b.dart"));
+}
+
+TEST_F(DartLibraryPrefetcherTest, UnknownAndFailedFetchesAreNotTaken) {
+  DartLibraryPrefetcher prefetcher(&provider_, 8);
+  TakeResult unknown;
+  EXPECT_FALSE(Take(&prefetcher, "unknown.dart", &unknown));
+
+  Scan(&prefetcher, "main.dart", "import 'missing.dart';\nmain() {}\n");
+  base::RunLoop().RunUntilIdle();
+  TakeResult missing;
+  EXPECT_FALSE(Take(&prefetcher, "missing.dart", &missing));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(unknown.called);
+  EXPECT_FALSE(missing.called);
+}
+
+}  // namespace
+}  // namespace blink
@@ -9,4 +9,9 @@ namespace blink {
 DartLibraryProvider::~DartLibraryProvider() {
 }
 
+std::string DartLibraryProvider::ResolveURL(const std::string& library_url,
+                                            const std::string& url) {
+  return std::string();
+}
+
 }  // namespace blink
@@ -23,6 +23,13 @@ class DartLibraryProvider {
 
   virtual Dart_Handle CanonicalizeURL(Dart_Handle library, Dart_Handle url) = 0;
 
+  // Resolves |url| as it would be if imported by the library at
+  // |library_url|, without calling into the VM. Used to prefetch libraries
+  // before the VM asks for them. The default returns an empty string, which
+  // disables prefetching for this provider.
+  virtual std::string ResolveURL(const std::string& library_url,
+                                 const std::string& url);
+
   virtual ~DartLibraryProvider();
 };
 
@@ -0,0 +1,404 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/tonic/dart_snapshot_cache.h"
+
+#include <algorithm>
+#include <map>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/logging.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/sha1.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/task_runner.h"
+#include "base/trace_event/trace_event.h"
+#include "mojo/common/data_pipe_drainer.h"
+#include "sky/engine/tonic/dart_library_provider.h"
+
+using mojo::common::DataPipeDrainer;
+
+namespace blink {
+namespace {
+
+const char kManifestHeader[] = "sky-dart-snapshot-cache 2";
+const char kManifestExtension[] = ".manifest";
+const char kSnapshotExtension[] = ".snapshot";
+
+std::string HashString(const std::string& content) {
+  std::string hash = base::SHA1HashString(content);
+  return base::HexEncode(hash.data(), hash.size());
+}
+
+std::string SerializeManifest(const std::string& build_identity,
+                              const DartSnapshotCache::Manifest& manifest) {
+  std::string result = kManifestHeader;
+  result += "\n";
+  result += build_identity;
+  result += "\n";
+  result += manifest.snapshot_hash;
+  result += "\n";
+  for (const auto& source : manifest.sources)
+    result += source.hash + " " + source.url + "\n";
+  return result;
+}
+
+bool ParseManifest(const std::string& text,
+                   const std::string& build_identity,
+                   DartSnapshotCache::Manifest* manifest) {
+  std::vector<std::string> lines = base::SplitString(
+      text, "\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  if (lines.size() < 3 || lines[0] != kManifestHeader)
+    return false;
+  // The entry name already covers the build identity, so a mismatch here
+  // means a truncated hash collided.
+  if (lines[1] != build_identity)
+    return false;
+  manifest->snapshot_hash = lines[2];
+  manifest->sources.clear();
+  for (size_t i = 3; i < lines.size(); ++i) {
+    size_t space = lines[i].find(' ');
+    if (space == std::string::npos)
+      return false;
+    DartSnapshotCache::Source source;
+    source.hash = lines[i].substr(0, space);
+    source.url = lines[i].substr(space + 1);
+    manifest->sources.push_back(source);
+  }
+  return !manifest->sources.empty();
+}
+
+// Deletes the least recently used entries until the directory holds at most
+// |max_size_in_bytes|. Reading an entry touches its manifest, so the
+// manifest's modification time is the entry's last use.
+void PruneDirectory(const base::FilePath& directory,
+                    int64_t max_size_in_bytes) {
+  struct EntryInfo {
+    EntryInfo() : size(0) {}
+    base::Time last_used;
+    int64_t size;
+  };
+  std::map<base::FilePath::StringType, EntryInfo> entries;
+  int64_t total_size = 0;
+
+  base::FileEnumerator enumerator(directory, false,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    base::FileEnumerator::FileInfo info = enumerator.GetInfo();
+    EntryInfo& entry = entries[path.RemoveExtension().value()];
+    entry.size += info.GetSize();
+    if (path.MatchesExtension(kManifestExtension))
+      entry.last_used = info.GetLastModifiedTime();
+    total_size += info.GetSize();
+  }
+
+  if (total_size <= max_size_in_bytes)
+    return;
+
+  std::vector<std::pair<base::Time, base::FilePath::StringType>> by_age;
+  for (const auto& entry : entries)
+    by_age.push_back(std::make_pair(entry.second.last_used, entry.first));
+  std::sort(by_age.begin(), by_age.end());
+
+  for (const auto& entry : by_age) {
+    if (total_size <= max_size_in_bytes)
+      break;
+    base::FilePath base_path(entry.second);
+    base::DeleteFile(base_path.AddExtension(kManifestExtension), false);
+    base::DeleteFile(base_path.AddExtension(kSnapshotExtension), false);
+    total_size -= entries[entry.second].size;
+  }
+}
+
+void StoreOnFileThread(const base::FilePath& directory,
+                       const base::FilePath& manifest_path,
+                       const base::FilePath& snapshot_path,
+                       const std::string& manifest,
+                       const std::string& snapshot,
+                       int64_t max_size_in_bytes) {
+  TRACE_EVENT0("sky", "DartSnapshotCache::Store");
+  if (!base::CreateDirectory(directory))
+    return;
+  // Write the snapshot first so that a manifest never points at a missing or
+  // partial snapshot.
+  if (!base::ImportantFileWriter::WriteFileAtomically(snapshot_path, snapshot))
+    return;
+  if (!base::ImportantFileWriter::WriteFileAtomically(manifest_path, manifest))
+    return;
+  PruneDirectory(directory, max_size_in_bytes);
+}
+
+void RemoveOnFileThread(const base::FilePath& manifest_path,
+                        const base::FilePath& snapshot_path) {
+  base::DeleteFile(manifest_path, false);
+  base::DeleteFile(snapshot_path, false);
+}
+
+struct ManifestResult {
+  ManifestResult() : found(false) {}
+  bool found;
+  DartSnapshotCache::Manifest manifest;
+};
+
+void ReadManifestOnFileThread(const base::FilePath& manifest_path,
+                              const base::FilePath& snapshot_path,
+                              const std::string& build_identity,
+                              ManifestResult* result) {
+  TRACE_EVENT0("sky", "DartSnapshotCache::ReadManifest");
+  std::string text;
+  if (!base::ReadFileToString(manifest_path, &text))
+    return;
+  if (!ParseManifest(text, build_identity, &result->manifest)) {
+    RemoveOnFileThread(manifest_path, snapshot_path);
+    return;
+  }
+  base::Time now = base::Time::Now();
+  base::TouchFile(manifest_path, now, now);
+  result->found = true;
+}
+
+void DidReadManifest(const DartSnapshotCache::ManifestCallback& callback,
+                     ManifestResult* result) {
+  callback.Run(result->found, result->manifest);
+}
+
+struct SnapshotResult {
+  SnapshotResult() : found(false) {}
+  bool found;
+  std::vector<uint8_t> snapshot;
+};
+
+void ReadSnapshotOnFileThread(const base::FilePath& manifest_path,
+                              const base::FilePath& snapshot_path,
+                              const std::string& snapshot_hash,
+                              SnapshotResult* result) {
+  TRACE_EVENT0("sky", "DartSnapshotCache::ReadSnapshot");
+  std::string data;
+  if (!base::ReadFileToString(snapshot_path, &data))
+    return;
+  if (HashString(data) != snapshot_hash) {
+    RemoveOnFileThread(manifest_path, snapshot_path);
+    return;
+  }
+  result->snapshot.assign(data.begin(), data.end());
+  result->found = true;
+}
+
+void DidReadSnapshot(const DartSnapshotCache::SnapshotCallback& callback,
+                     SnapshotResult* result) {
+  callback.Run(result->found, result->snapshot);
+}
+
+}  // namespace
+
+// Fetches the sources listed in a manifest in parallel and compares their
+// hashes. Finishes as soon as one source fails or differs.
+class DartSnapshotCache::Validation {
+ public:
+  Validation(DartSnapshotCache* cache,
+             DartLibraryProvider* provider,
+             const Manifest& manifest,
+             const base::Callback<void(bool)>& callback)
+      : cache_(cache),
+        callback_(callback),
+        remaining_(manifest.sources.size()),
+        finished_(false),
+        weak_factory_(this) {
+    TRACE_EVENT_ASYNC_BEGIN0("sky", "DartSnapshotCache::Validate", this);
+    for (const auto& source : manifest.sources) {
+      fetches_.push_back(std::unique_ptr<Fetch>(new Fetch(this, source.hash)));
+      provider->GetLibraryAsStream(
+          source.url, base::Bind(&Validation::OnStreamAvailable,
+                                 weak_factory_.GetWeakPtr(),
+                                 fetches_.back().get()));
+    }
+  }
+
+  ~Validation() {
+    TRACE_EVENT_ASYNC_END0("sky", "DartSnapshotCache::Validate", this);
+  }
+
+  const base::Callback<void(bool)>& callback() const { return callback_; }
+
+ private:
+  class Fetch : public DataPipeDrainer::Client {
+   public:
+    Fetch(Validation* validation, const std::string& expected_hash)
+        : validation_(validation), expected_hash_(expected_hash) {}
+
+    void Start(mojo::ScopedDataPipeConsumerHandle pipe) {
+      drainer_ = std::unique_ptr<DataPipeDrainer>(
+          new DataPipeDrainer(this, pipe.Pass()));
+    }
+
+   private:
+    // DataPipeDrainer::Client
+    void OnDataAvailable(const void* data, size_t num_bytes) override {
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      buffer_.insert(buffer_.end(), bytes, bytes + num_bytes);
+    }
+
+    void OnDataComplete() override {
+      validation_->DidFetch(HashContent(buffer_) == expected_hash_);
+    }
+
+    Validation* validation_;
+    std::string expected_hash_;
+    std::vector<uint8_t> buffer_;
+    std::unique_ptr<DataPipeDrainer> drainer_;
+  };
+
+  void OnStreamAvailable(Fetch* fetch,
+                         mojo::ScopedDataPipeConsumerHandle pipe) {
+    if (!pipe.is_valid()) {
+      DidFetch(false);
+      return;
+    }
+    fetch->Start(pipe.Pass());
+  }
+
+  void DidFetch(bool matches) {
+    // Fetches that complete after the result is known are ignored.
+    if (finished_)
+      return;
+    if (!matches)
+      Finish(false);
+    else if (!--remaining_)
+      Finish(true);
+  }
+
+  // Schedules the deletion of |this|, which may be called from one of its
+  // own drainers.
+  void Finish(bool valid) {
+    finished_ = true;
+    weak_factory_.InvalidateWeakPtrs();
+    cache_->DidValidate(this, valid);
+  }
+
+  DartSnapshotCache* cache_;
+  base::Callback<void(bool)> callback_;
+  std::vector<std::unique_ptr<Fetch>> fetches_;
+  size_t remaining_;
+  bool finished_;
+
+  base::WeakPtrFactory<Validation> weak_factory_;
+};
+
+const int64_t DartSnapshotCache::kDefaultMaxSizeInBytes = 32 * 1024 * 1024;
+
+DartSnapshotCache::Manifest::Manifest() {
+}
+
+DartSnapshotCache::Manifest::~Manifest() {
+}
+
+DartSnapshotCache::DartSnapshotCache(
+    const base::FilePath& directory,
+    const std::string& build_identity,
+    int64_t max_size_in_bytes,
+    scoped_refptr<base::TaskRunner> file_task_runner)
+    : directory_(directory),
+      build_identity_(build_identity),
+      max_size_in_bytes_(max_size_in_bytes),
+      file_task_runner_(file_task_runner) {
+}
+
+DartSnapshotCache::~DartSnapshotCache() {
+}
+
+std::string DartSnapshotCache::HashContent(
+    const std::vector<uint8_t>& content) {
+  return HashString(std::string(content.begin(), content.end()));
+}
+
+std::string DartSnapshotCache::EntryName(const std::string& root_url) const {
+  return HashString(build_identity_ + "\n" + root_url).substr(0, 16);
+}
+
+base::FilePath DartSnapshotCache::ManifestPath(
+    const std::string& root_url) const {
+  return directory_.AppendASCII(EntryName(root_url) + kManifestExtension);
+}
+
+base::FilePath DartSnapshotCache::SnapshotPath(
+    const std::string& root_url) const {
+  return directory_.AppendASCII(EntryName(root_url) + kSnapshotExtension);
+}
+
+void DartSnapshotCache::ReadManifest(const std::string& root_url,
+                                     const ManifestCallback& callback) {
+  ManifestResult* result = new ManifestResult;
+  file_task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      base::Bind(&ReadManifestOnFileThread, ManifestPath(root_url),
+                 SnapshotPath(root_url), build_identity_,
+                 base::Unretained(result)),
+      base::Bind(&DidReadManifest, callback, base::Owned(result)));
+}
+
+void DartSnapshotCache::ReadSnapshot(const std::string& root_url,
+                                     const Manifest& manifest,
+                                     const SnapshotCallback& callback) {
+  SnapshotResult* result = new SnapshotResult;
+  file_task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      base::Bind(&ReadSnapshotOnFileThread, ManifestPath(root_url),
+                 SnapshotPath(root_url), manifest.snapshot_hash,
+                 base::Unretained(result)),
+      base::Bind(&DidReadSnapshot, callback, base::Owned(result)));
+}
+
+void DartSnapshotCache::Validate(DartLibraryProvider* provider,
+                                 const Manifest& manifest,
+                                 const base::Callback<void(bool)>& callback) {
+  DCHECK(!manifest.sources.empty());
+  validations_.push_back(std::unique_ptr<Validation>(
+      new Validation(this, provider, manifest, callback)));
+}
+
+void DartSnapshotCache::DidValidate(Validation* validation, bool valid) {
+  auto it = std::find_if(validations_.begin(), validations_.end(),
+                         [validation](const std::unique_ptr<Validation>& v) {
+                           return v.get() == validation;
+                         });
+  DCHECK(it != validations_.end());
+  it->release();
+  validations_.erase(it);
+  base::Callback<void(bool)> callback = validation->callback();
+  // |validation| may be the drainer client that called us, so it has to
+  // outlive this call stack.
+  base::MessageLoop::current()->DeleteSoon(FROM_HERE, validation);
+  callback.Run(valid);
+}
+
+void DartSnapshotCache::Store(const std::string& root_url,
+                              const std::vector<Source>& sources,
+                              std::vector<uint8_t> snapshot) {
+  if (sources.empty())
+    return;
+  std::string data(snapshot.begin(), snapshot.end());
+  Manifest manifest;
+  manifest.sources = sources;
+  manifest.snapshot_hash = HashString(data);
+  file_task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(&StoreOnFileThread, directory_, ManifestPath(root_url),
+                 SnapshotPath(root_url),
+                 SerializeManifest(build_identity_, manifest), data,
+                 max_size_in_bytes_));
+}
+
+void DartSnapshotCache::Remove(const std::string& root_url) {
+  file_task_runner_->PostTask(
+      FROM_HERE, base::Bind(&RemoveOnFileThread, ManifestPath(root_url),
+                            SnapshotPath(root_url)));
+}
+
+}  // namespace blink
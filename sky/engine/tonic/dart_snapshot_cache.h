@@ -0,0 +1,110 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_ENGINE_TONIC_DART_SNAPSHOT_CACHE_H_
+#define SKY_ENGINE_TONIC_DART_SNAPSHOT_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+
+namespace base {
+class TaskRunner;
+}
+
+namespace blink {
+class DartLibraryProvider;
+
+// An on-disk cache of script snapshots. A snapshot holds the root library and
+// everything it loaded, already tokenized, so loading it skips fetching and
+// scanning the sources.
+//
+// Each entry is keyed by the build identity and the root library's URL, so
+// different engine builds never read each other's snapshots. It records the
+// URL and content hash of every library and part that went into the snapshot,
+// and the entry is only used if all of those sources are unchanged. The cache
+// evicts the least recently used entries to stay under its size cap.
+//
+// All file IO happens on the file task runner.
+class DartSnapshotCache {
+ public:
+  struct Source {
+    std::string url;
+    std::string hash;
+  };
+
+  struct Manifest {
+    Manifest();
+    ~Manifest();
+
+    std::vector<Source> sources;
+    std::string snapshot_hash;
+  };
+
+  typedef base::Callback<void(bool found, const Manifest& manifest)>
+      ManifestCallback;
+  typedef base::Callback<void(bool found, const std::vector<uint8_t>& snapshot)>
+      SnapshotCallback;
+
+  // |build_identity| identifies the VM and the engine's Dart libraries; see
+  // blink::dartBuildIdentity().
+  DartSnapshotCache(const base::FilePath& directory,
+                    const std::string& build_identity,
+                    int64_t max_size_in_bytes,
+                    scoped_refptr<base::TaskRunner> file_task_runner);
+  ~DartSnapshotCache();
+
+  static const int64_t kDefaultMaxSizeInBytes;
+
+  static std::string HashContent(const std::vector<uint8_t>& content);
+
+  // Reads the entry for |root_url| without validating it, and calls
+  // |callback| on this thread.
+  void ReadManifest(const std::string& root_url,
+                    const ManifestCallback& callback);
+  // Reads the snapshot for |root_url|, and calls |callback| on this thread.
+  // The snapshot isn't found if it doesn't match |manifest|.
+  void ReadSnapshot(const std::string& root_url,
+                    const Manifest& manifest,
+                    const SnapshotCallback& callback);
+
+  // Fetches every source listed in |manifest| from |provider| in parallel
+  // and calls |callback| with true if they all match their recorded hashes.
+  // |provider| must outlive the validation.
+  void Validate(DartLibraryProvider* provider,
+                const Manifest& manifest,
+                const base::Callback<void(bool)>& callback);
+
+  void Store(const std::string& root_url,
+             const std::vector<Source>& sources,
+             std::vector<uint8_t> snapshot);
+
+  // Deletes the entry for |root_url|, for example because it failed to load.
+  void Remove(const std::string& root_url);
+
+ private:
+  class Validation;
+
+  std::string EntryName(const std::string& root_url) const;
+  base::FilePath ManifestPath(const std::string& root_url) const;
+  base::FilePath SnapshotPath(const std::string& root_url) const;
+  void DidValidate(Validation* validation, bool valid);
+
+  base::FilePath directory_;
+  std::string build_identity_;
+  int64_t max_size_in_bytes_;
+  scoped_refptr<base::TaskRunner> file_task_runner_;
+  std::vector<std::unique_ptr<Validation>> validations_;
+
+  DISALLOW_COPY_AND_ASSIGN(DartSnapshotCache);
+};
+
+}  // namespace blink
+
+#endif  // SKY_ENGINE_TONIC_DART_SNAPSHOT_CACHE_H_
@@ -0,0 +1,304 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/tonic/dart_snapshot_cache.h"
+
+#include <string.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "mojo/common/data_pipe_utils.h"
+#include "mojo/common/message_pump_mojo.h"
+#include "sky/engine/tonic/dart_library_provider.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace blink {
+namespace {
+
+const char kBuildIdentity[] = "test-build";
+
+// Serves sources from memory.
+class TestLibraryProvider : public DartLibraryProvider {
+ public:
+  TestLibraryProvider() {}
+  ~TestLibraryProvider() override {}
+
+  void SetSource(const std::string& url, const std::string& source) {
+    sources_[url] = source;
+  }
+
+  void GetLibraryAsStream(const std::string& name,
+                          DataPipeConsumerCallback callback) override {
+    mojo::ScopedDataPipeConsumerHandle consumer;
+    auto it = sources_.find(name);
+    if (it != sources_.end()) {
+      mojo::DataPipe pipe;
+      mojo::common::BlockingCopyFromString(it->second, pipe.producer_handle);
+      consumer = pipe.consumer_handle.Pass();
+    }
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE, base::Bind(callback, base::Passed(&consumer)));
+  }
+
+  Dart_Handle CanonicalizeURL(Dart_Handle library, Dart_Handle url) override {
+    return url;
+  }
+
+  std::string ResolveURL(const std::string& library_url,
+                         const std::string& url) override {
+    return url;
+  }
+
+ private:
+  std::map<std::string, std::string> sources_;
+};
+
+std::vector<uint8_t> Bytes(const std::string& text) {
+  return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+DartSnapshotCache::Source MakeSource(const std::string& url,
+                                     const std::string& content) {
+  DartSnapshotCache::Source source;
+  source.url = url;
+  source.hash = DartSnapshotCache::HashContent(Bytes(content));
+  return source;
+}
+
+void DidReadManifest(bool* found_out,
+                     DartSnapshotCache::Manifest* manifest_out,
+                     bool found,
+                     const DartSnapshotCache::Manifest& manifest) {
+  *found_out = found;
+  *manifest_out = manifest;
+}
+
+void DidReadSnapshot(bool* found_out,
+                     std::vector<uint8_t>* snapshot_out,
+                     bool found,
+                     const std::vector<uint8_t>& snapshot) {
+  *found_out = found;
+  *snapshot_out = snapshot;
+}
+
+void DidValidate(bool* valid_out, bool valid) {
+  *valid_out = valid;
+}
+
+class DartSnapshotCacheTest : public testing::Test {
+ protected:
+  DartSnapshotCacheTest()
+      : message_loop_(mojo::common::MessagePumpMojo::Create()) {}
+
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  std::unique_ptr<DartSnapshotCache> CreateCache(
+      const std::string& build_identity,
+      int64_t max_size_in_bytes = DartSnapshotCache::kDefaultMaxSizeInBytes) {
+    return std::unique_ptr<DartSnapshotCache>(new DartSnapshotCache(
+        temp_dir_.path(), build_identity, max_size_in_bytes,
+        message_loop_.task_runner()));
+  }
+
+  void RunUntilIdle() { base::RunLoop().RunUntilIdle(); }
+
+  // Stores |root_url| with a single source and waits for the write.
+  void Store(DartSnapshotCache* cache,
+             const std::string& root_url,
+             const std::string& source,
+             const std::string& snapshot) {
+    std::vector<DartSnapshotCache::Source> sources;
+    sources.push_back(MakeSource(root_url, source));
+    cache->Store(root_url, sources, Bytes(snapshot));
+    RunUntilIdle();
+  }
+
+  bool ReadManifest(DartSnapshotCache* cache,
+                    const std::string& root_url,
+                    DartSnapshotCache::Manifest* manifest) {
+    bool found = false;
+    cache->ReadManifest(root_url,
+                        base::Bind(&DidReadManifest, &found, manifest));
+    RunUntilIdle();
+    return found;
+  }
+
+  bool ReadSnapshot(DartSnapshotCache* cache,
+                    const std::string& root_url,
+                    const DartSnapshotCache::Manifest& manifest,
+                    std::string* snapshot) {
+    bool found = false;
+    std::vector<uint8_t> bytes;
+    cache->ReadSnapshot(root_url, manifest,
+                        base::Bind(&DidReadSnapshot, &found, &bytes));
+    RunUntilIdle();
+    snapshot->assign(bytes.begin(), bytes.end());
+    return found;
+  }
+
+  bool Validate(DartSnapshotCache* cache,
+                const DartSnapshotCache::Manifest& manifest) {
+    bool valid = false;
+    cache->Validate(&provider_, manifest, base::Bind(&DidValidate, &valid));
+    RunUntilIdle();
+    return valid;
+  }
+
+  // Returns the one file in the cache directory with |extension|.
+  base::FilePath OnlyFileWithExtension(const std::string& extension) {
+    base::FilePath result;
+    base::FileEnumerator enumerator(temp_dir_.path(), false,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      if (!path.MatchesExtension(extension))
+        continue;
+      EXPECT_TRUE(result.empty()) << "More than one " << extension;
+      result = path;
+    }
+    return result;
+  }
+
+  base::MessageLoop message_loop_;
+  base::ScopedTempDir temp_dir_;
+  TestLibraryProvider provider_;
+};
+
+TEST_F(DartSnapshotCacheTest, HitWhenSourcesAreUnchanged) {
+  std::unique_ptr<DartSnapshotCache> cache = CreateCache(kBuildIdentity);
+  provider_.SetSource("main.dart", "main() {}");
+  Store(cache.get(), "main.dart", "main() {}", "snapshot");
+
+  DartSnapshotCache::Manifest manifest;
+  ASSERT_TRUE(ReadManifest(cache.get(), "main.dart", &manifest));
+  ASSERT_EQ(1u, manifest.sources.size());
+  EXPECT_EQ("main.dart", manifest.sources[0].url);
+  EXPECT_TRUE(Validate(cache.get(), manifest));
+
+  std::string snapshot;
+  EXPECT_TRUE(ReadSnapshot(cache.get(), "main.dart", manifest, &snapshot));
+  EXPECT_EQ("snapshot", snapshot);
+}
+
+TEST_F(DartSnapshotCacheTest, MissWhenASourceChanges) {
+  std::unique_ptr<DartSnapshotCache> cache = CreateCache(kBuildIdentity);
+  Store(cache.get(), "main.dart", "main() {}", "snapshot");
+  provider_.SetSource("main.dart", "main() { print('changed'); }");
+
+  DartSnapshotCache::Manifest manifest;
+  ASSERT_TRUE(ReadManifest(cache.get(), "main.dart", &manifest));
+  EXPECT_FALSE(Validate(cache.get(), manifest));
+}
+
+TEST_F(DartSnapshotCacheTest, MissWhenASourceIsGone) {
+  std::unique_ptr<DartSnapshotCache> cache = CreateCache(kBuildIdentity);
+  Store(cache.get(), "main.dart", "main() {}", "snapshot");
+
+  DartSnapshotCache::Manifest manifest;
+  ASSERT_TRUE(ReadManifest(cache.get(), "main.dart", &manifest));
+  EXPECT_FALSE(Validate(cache.get(), manifest));
+}
+
+TEST_F(DartSnapshotCacheTest, OtherBuildsDontSeeTheEntry) {
+  std::unique_ptr<DartSnapshotCache> cache = CreateCache(kBuildIdentity);
+  Store(cache.get(), "main.dart", "main() {}", "snapshot");
+
+  std::unique_ptr<DartSnapshotCache> other_build = CreateCache("other-build");
+  DartSnapshotCache::Manifest manifest;
+  EXPECT_FALSE(ReadManifest(other_build.get(), "main.dart", &manifest));
+  EXPECT_TRUE(ReadManifest(cache.get(), "main.dart", &manifest));
+}
+
+TEST_F(DartSnapshotCacheTest, RejectsManifestOfAnotherBuild) {
+  std::unique_ptr<DartSnapshotCache> cache = CreateCache(kBuildIdentity);
+  Store(cache.get(), "main.dart", "main() {}", "snapshot");
+
+  // Rewrite the manifest as if another build had written it under the same
+  // entry name.
+  base::FilePath manifest_path = OnlyFileWithExtension(".manifest");
+  std::string text;
+  ASSERT_TRUE(base::ReadFileToString(manifest_path, &text));
+  size_t identity = text.find(kBuildIdentity);
+  ASSERT_NE(std::string::npos, identity);
+  text.replace(identity, strlen(kBuildIdentity), "other-build");
+  ASSERT_EQ(static_cast<int>(text.size()),
+            base::WriteFile(manifest_path, text.data(), text.size()));
+
+  DartSnapshotCache::Manifest manifest;
+  EXPECT_FALSE(ReadManifest(cache.get(), "main.dart", &manifest));
+  // The rejected entry is deleted.
+  EXPECT_FALSE(base::PathExists(manifest_path));
+  EXPECT_TRUE(OnlyFileWithExtension(".snapshot").empty());
+}
+
+TEST_F(DartSnapshotCacheTest, RejectsCorruptManifest) {
+  std::unique_ptr<DartSnapshotCache> cache = CreateCache(kBuildIdentity);
+  Store(cache.get(), "main.dart", "main() {}", "snapshot");
+
+  base::FilePath manifest_path = OnlyFileWithExtension(".manifest");
+  const char kGarbage[] = "garbage";
+  ASSERT_EQ(static_cast<int>(strlen(kGarbage)),
+            base::WriteFile(manifest_path, kGarbage, strlen(kGarbage)));
+
+  DartSnapshotCache::Manifest manifest;
+  EXPECT_FALSE(ReadManifest(cache.get(), "main.dart", &manifest));
+  EXPECT_FALSE(base::PathExists(manifest_path));
+}
+
+TEST_F(DartSnapshotCacheTest, RejectsCorruptSnapshot) {
+  std::unique_ptr<DartSnapshotCache> cache = CreateCache(kBuildIdentity);
+  Store(cache.get(), "main.dart", "main() {}", "snapshot");
+
+  base::FilePath snapshot_path = OnlyFileWithExtension(".snapshot");
+  const char kGarbage[] = "snapshoT";
+  ASSERT_EQ(static_cast<int>(strlen(kGarbage)),
+            base::WriteFile(snapshot_path, kGarbage, strlen(kGarbage)));
+
+  DartSnapshotCache::Manifest manifest;
+  ASSERT_TRUE(ReadManifest(cache.get(), "main.dart", &manifest));
+  std::string snapshot;
+  EXPECT_FALSE(ReadSnapshot(cache.get(), "main.dart", manifest, &snapshot));
+  EXPECT_FALSE(base::PathExists(snapshot_path));
+  EXPECT_FALSE(ReadManifest(cache.get(), "main.dart", &manifest));
+}
+
+TEST_F(DartSnapshotCacheTest, PrunesLeastRecentlyUsedEntriesAtTheCap) {
+  const std::string kSnapshot(1000, 'x');
+  // Room for two entries, each a snapshot plus a small manifest, but not
+  // three.
+  std::unique_ptr<DartSnapshotCache> cache =
+      CreateCache(kBuildIdentity, 2 * kSnapshot.size() + 500);
+  Store(cache.get(), "a.dart", "a", kSnapshot);
+  Store(cache.get(), "b.dart", "b", kSnapshot);
+
+  // Age both entries explicitly, with a older than b, and then use a so that
+  // b becomes the least recently used.
+  base::Time now = base::Time::Now();
+  base::FileEnumerator enumerator(temp_dir_.path(), false,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    base::Time time = now - base::TimeDelta::FromHours(1);
+    base::TouchFile(path, time, time);
+  }
+  DartSnapshotCache::Manifest manifest;
+  ASSERT_TRUE(ReadManifest(cache.get(), "a.dart", &manifest));
+
+  Store(cache.get(), "c.dart", "c", kSnapshot);
+  EXPECT_TRUE(ReadManifest(cache.get(), "a.dart", &manifest));
+  EXPECT_FALSE(ReadManifest(cache.get(), "b.dart", &manifest));
+  EXPECT_TRUE(ReadManifest(cache.get(), "c.dart", &manifest));
+}
+
+}  // namespace
+}  // namespace blink
@@ -4,17 +4,32 @@
 
 #include "sky/engine/tonic/dart_timer_heap.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/message_loop/message_loop.h"
 #include "base/time/time.h"
-#include "sky/engine/tonic/dart_api_scope.h"
+#include "base/trace_event/trace_event.h"
 #include "sky/engine/tonic/dart_invoke.h"
-#include "sky/engine/tonic/dart_isolate_scope.h"
 #include "sky/engine/tonic/dart_state.h"
 
 namespace blink {
+namespace {
+
+const int64_t kDefaultSlackMicroseconds = 1000;
+
+// Rebuild the heap once it holds this many more entries than live timers.
+const size_t kMinDeadEntriesForCompaction = 64;
 
-DartTimerHeap::DartTimerHeap() : next_timer_id_(1), weak_factory_(this) {
+}  // namespace
+
+DartTimerHeap::DartTimerHeap()
+    : next_timer_id_(1),
+      next_sequence_(0),
+      slack_(base::TimeDelta::FromMicroseconds(kDefaultSlackMicroseconds)),
+      running_id_(0),
+      running_removed_(false),
+      wakeup_weak_factory_(this) {
 }
 
 DartTimerHeap::~DartTimerHeap() {
@@ -22,34 +37,193 @@ DartTimerHeap::~DartTimerHeap() {
 
 int DartTimerHeap::Add(std::unique_ptr<Task> task) {
   int id = next_timer_id_++;
-  Schedule(id, std::move(task));
+  Schedule(id, std::move(task), Now());
+  ScheduleWakeup();
   return id;
 }
 
 void DartTimerHeap::Remove(int id) {
-  heap_.erase(id);
+  if (id == running_id_)
+    running_removed_ = true;
+  // The heap entry is dropped lazily, when it reaches the top or when the
+  // heap is compacted.
+  if (tasks_.erase(id))
+    CompactIfNeeded();
+}
+
+bool DartTimerHeap::Later(const Entry& a, const Entry& b) {
+  if (a.deadline != b.deadline)
+    return a.deadline > b.deadline;
+  return a.sequence > b.sequence;
+}
+
+void DartTimerHeap::Schedule(int id,
+                             std::unique_ptr<Task> task,
+                             base::TimeTicks now) {
+  Entry entry;
+  entry.deadline = now + task->delay;
+  entry.sequence = next_sequence_++;
+  entry.id = id;
+
+  ScheduledTask& scheduled = tasks_[id];
+  scheduled.task = std::move(task);
+  scheduled.sequence = entry.sequence;
+
+  heap_.push_back(entry);
+  std::push_heap(heap_.begin(), heap_.end(), &DartTimerHeap::Later);
+}
+
+bool DartTimerHeap::IsLive(const Entry& entry) const {
+  auto it = tasks_.find(entry.id);
+  return it != tasks_.end() && it->second.sequence == entry.sequence;
 }
 
-void DartTimerHeap::Schedule(int id, std::unique_ptr<Task> task) {
-  base::TimeDelta delay = task->delay;
-  heap_[id] = std::move(task);
-  base::MessageLoop::current()->PostDelayedTask(FROM_HERE,
-    base::Bind(&DartTimerHeap::Run, weak_factory_.GetWeakPtr(), id), delay);
+void DartTimerHeap::PopDeadEntries() {
+  while (!heap_.empty() && !IsLive(heap_.front())) {
+    std::pop_heap(heap_.begin(), heap_.end(), &DartTimerHeap::Later);
+    heap_.pop_back();
+  }
 }
 
-void DartTimerHeap::Run(int id) {
-  auto it = heap_.find(id);
-  if (it == heap_.end())
+void DartTimerHeap::CompactIfNeeded() {
+  if (heap_.size() < 2 * tasks_.size() + kMinDeadEntriesForCompaction)
     return;
-  std::unique_ptr<Task> task = std::unique_ptr<Task>(it->second.release());
-  heap_.erase(it);
-  if (!task->closure.dart_state())
+  heap_.erase(std::remove_if(heap_.begin(), heap_.end(),
+                             [this](const Entry& entry) {
+                               return !IsLive(entry);
+                             }),
+              heap_.end());
+  std::make_heap(heap_.begin(), heap_.end(), &DartTimerHeap::Later);
+}
+
+base::TimeTicks DartTimerHeap::CoalescedDeadline() const {
+  DCHECK(!heap_.empty());
+  base::TimeTicks limit = heap_.front().deadline + slack_;
+  base::TimeTicks latest = heap_.front().deadline;
+
+  // Children are never earlier than their parent, so subtrees whose root is
+  // past the limit can be skipped.
+  std::vector<size_t> stack(1, 0);
+  while (!stack.empty()) {
+    size_t index = stack.back();
+    stack.pop_back();
+    const Entry& entry = heap_[index];
+    if (entry.deadline > limit)
+      continue;
+    if (IsLive(entry))
+      latest = std::max(latest, entry.deadline);
+    for (size_t child = 2 * index + 1; child <= 2 * index + 2; ++child) {
+      if (child < heap_.size())
+        stack.push_back(child);
+    }
+  }
+  return latest;
+}
+
+void DartTimerHeap::ScheduleWakeup() {
+  PopDeadEntries();
+  if (heap_.empty())
     return;
-  DartIsolateScope scope(task->closure.dart_state()->isolate());
-  DartApiScope api_scope;
+
+  base::TimeTicks earliest = heap_.front().deadline;
+  // A pending wakeup that is no earlier than the first deadline and within
+  // the slack window already covers it.
+  if (!wakeup_time_.is_null() && wakeup_time_ >= earliest &&
+      wakeup_time_ <= earliest + slack_)
+    return;
+
+  base::TimeTicks target = CoalescedDeadline();
+  if (!wakeup_time_.is_null() && wakeup_time_ <= target)
+    return;
+
+  wakeup_weak_factory_.InvalidateWeakPtrs();
+  wakeup_time_ = target;
+  base::TimeDelta delay = std::max(target - Now(), base::TimeDelta());
+  PostWakeup(base::Bind(&DartTimerHeap::OnWakeup,
+                        wakeup_weak_factory_.GetWeakPtr()),
+             delay);
+}
+
+void DartTimerHeap::OnWakeup() {
+  wakeup_time_ = base::TimeTicks();
+  base::TimeTicks now = Now();
+
+  // Collect every expired timer before running any of them, so that timers
+  // added by the callbacks wait for the next wakeup.
+  std::vector<int> expired;
+  PopDeadEntries();
+  while (!heap_.empty() && heap_.front().deadline <= now) {
+    expired.push_back(heap_.front().id);
+    std::pop_heap(heap_.begin(), heap_.end(), &DartTimerHeap::Later);
+    heap_.pop_back();
+    PopDeadEntries();
+  }
+
+  if (!expired.empty()) {
+    TRACE_EVENT1("sky", "DartTimerHeap::OnWakeup", "timers", expired.size());
+
+    // Split the timers, in deadline order, into runs that share an isolate.
+    std::vector<std::pair<DartState*, std::vector<int>>> batches;
+    for (int id : expired) {
+      auto it = tasks_.find(id);
+      DCHECK(it != tasks_.end());
+      DartState* dart_state = GetDartState(*it->second.task);
+      if (!dart_state) {
+        // The isolate is gone, so the timer can't run.
+        tasks_.erase(it);
+        continue;
+      }
+      if (batches.empty() || batches.back().first != dart_state)
+        batches.push_back(std::make_pair(dart_state, std::vector<int>()));
+      batches.back().second.push_back(id);
+    }
+
+    for (const auto& batch : batches)
+      RunBatch(batch.first, batch.second);
+  }
+
+  ScheduleWakeup();
+}
+
+base::TimeTicks DartTimerHeap::Now() {
+  return base::TimeTicks::Now();
+}
+
+void DartTimerHeap::PostWakeup(const base::Closure& wakeup,
+                               base::TimeDelta delay) {
+  base::MessageLoop::current()->PostDelayedTask(FROM_HERE, wakeup, delay);
+}
+
+DartState* DartTimerHeap::GetDartState(const Task& task) {
+  return task.closure.dart_state().get();
+}
+
+void DartTimerHeap::RunBatch(DartState* dart_state,
+                             const std::vector<int>& ids) {
+  DartState::Scope scope(dart_state);
+  for (int id : ids)
+    RunTimer(id);
+}
+
+void DartTimerHeap::InvokeTimer(Task* task) {
   DartInvokeAppClosure(task->closure.value(), 0, nullptr);
-  if (task->repeating)
-    Schedule(id, std::move(task));
+}
+
+void DartTimerHeap::RunTimer(int id) {
+  // An earlier callback in this wakeup may have cancelled the timer.
+  auto it = tasks_.find(id);
+  if (it == tasks_.end())
+    return;
+  std::unique_ptr<Task> task = std::move(it->second.task);
+  tasks_.erase(it);
+
+  running_id_ = id;
+  running_removed_ = false;
+  InvokeTimer(task.get());
+  running_id_ = 0;
+
+  if (task->repeating && !running_removed_)
+    Schedule(id, std::move(task), Now());
 }
 
 }
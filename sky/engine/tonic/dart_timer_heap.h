@@ -6,18 +6,30 @@
 #define SKY_ENGINE_TONIC_DART_TIMER_HEAP_H_
 
 #include <unordered_map>
+#include <vector>
 
+#include "base/callback.h"
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "dart/runtime/include/dart_api.h"
 #include "sky/engine/tonic/dart_persistent_value.h"
 
 namespace blink {
+class DartState;
 
+// Schedules Dart timers on the current message loop. Deadlines are kept in a
+// min-heap, and only one delayed task is posted at a time, for the earliest
+// deadline. When the wakeup fires, every expired timer runs, and consecutive
+// timers whose closures belong to the same isolate share one isolate and API
+// scope.
+//
+// Timers never fire early. To coalesce wakeups, a timer may fire up to
+// |slack| late so that it can run with other timers whose deadlines fall
+// within the slack window.
 class DartTimerHeap {
  public:
   DartTimerHeap();
-  ~DartTimerHeap();
+  virtual ~DartTimerHeap();
 
   struct Task {
     DartPersistentValue closure;
@@ -28,14 +40,74 @@ class DartTimerHeap {
   int Add(std::unique_ptr<Task> task);
   void Remove(int id);
 
+  base::TimeDelta slack() const { return slack_; }
+  void set_slack(base::TimeDelta slack) { slack_ = slack; }
+
+ protected:
+  // The hooks below are virtual so that tests can run timers without a Dart
+  // VM and on a mock clock.
+
+  // Returns the current time.
+  virtual base::TimeTicks Now();
+
+  // Posts |wakeup| to run after |delay| on the current message loop.
+  virtual void PostWakeup(const base::Closure& wakeup, base::TimeDelta delay);
+
+  // Returns the isolate |task| runs in, or null if it has been shut down.
+  virtual DartState* GetDartState(const Task& task);
+
+  // Runs the expired timers |ids|, which all belong to |dart_state|, in
+  // order, by calling RunTimer() for each of them.
+  virtual void RunBatch(DartState* dart_state, const std::vector<int>& ids);
+
+  // Invokes the closure of |task|.
+  virtual void InvokeTimer(Task* task);
+
+  // Runs timer |id| unless it has been cancelled, and reschedules it if it
+  // repeats.
+  void RunTimer(int id);
+
  private:
-  void Schedule(int id, std::unique_ptr<Task> task);
-  void Run(int id);
+  struct Entry {
+    base::TimeTicks deadline;
+    // Orders timers with the same deadline by when they were scheduled, and
+    // identifies entries left behind by Remove() or rescheduling.
+    int64_t sequence;
+    int id;
+  };
+
+  struct ScheduledTask {
+    std::unique_ptr<Task> task;
+    int64_t sequence;
+  };
+
+  // Comparator for a min-heap on (deadline, sequence).
+  static bool Later(const Entry& a, const Entry& b);
+
+  void Schedule(int id, std::unique_ptr<Task> task, base::TimeTicks now);
+  bool IsLive(const Entry& entry) const;
+  void PopDeadEntries();
+  void CompactIfNeeded();
+
+  // Returns the latest deadline within |slack_| of the earliest one.
+  base::TimeTicks CoalescedDeadline() const;
+  void ScheduleWakeup();
+  void OnWakeup();
 
   int next_timer_id_;
-  std::unordered_map<int, std::unique_ptr<Task>> heap_;
+  int64_t next_sequence_;
+  base::TimeDelta slack_;
+
+  std::unordered_map<int, ScheduledTask> tasks_;
+  std::vector<Entry> heap_;
+
+  // The timer currently being run by OnWakeup(), which has already been
+  // taken out of |tasks_|.
+  int running_id_;
+  bool running_removed_;
 
-  base::WeakPtrFactory<DartTimerHeap> weak_factory_;
+  base::TimeTicks wakeup_time_;
+  base::WeakPtrFactory<DartTimerHeap> wakeup_weak_factory_;
 };
 
 }
@@ -0,0 +1,289 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/engine/tonic/dart_timer_heap.h"
+
+#include <map>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "base/test/test_mock_time_task_runner.h"
+#include "sky/engine/tonic/dart_state.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace blink {
+namespace {
+
+base::TimeDelta Ms(int64_t milliseconds) {
+  return base::TimeDelta::FromMilliseconds(milliseconds);
+}
+
+// Runs timers without a Dart VM, on the mock clock of |task_runner|. Each
+// timer is given the isolate it belongs to, and running it calls a closure.
+class TestTimerHeap : public DartTimerHeap {
+ public:
+  struct Batch {
+    DartState* dart_state;
+    std::vector<int> ids;
+  };
+
+  explicit TestTimerHeap(
+      const scoped_refptr<base::TestMockTimeTaskRunner>& task_runner)
+      : task_runner_(task_runner) {}
+  ~TestTimerHeap() override {}
+
+  const std::vector<Batch>& batches() const { return batches_; }
+  // The delay of every wakeup posted so far, including ones that were later
+  // replaced by an earlier wakeup.
+  const std::vector<base::TimeDelta>& wakeup_delays() const {
+    return wakeup_delays_;
+  }
+
+  int AddTimer(DartState* dart_state,
+               const base::Closure& callback,
+               base::TimeDelta delay = base::TimeDelta(),
+               bool repeating = false) {
+    std::unique_ptr<Task> task(new Task);
+    task->delay = delay;
+    task->repeating = repeating;
+    dart_states_[task.get()] = dart_state;
+    callbacks_[task.get()] = callback;
+    return Add(std::move(task));
+  }
+
+ protected:
+  // DartTimerHeap implementation:
+  base::TimeTicks Now() override { return task_runner_->NowTicks(); }
+  void PostWakeup(const base::Closure& wakeup, base::TimeDelta delay) override {
+    wakeup_delays_.push_back(delay);
+    task_runner_->PostDelayedTask(FROM_HERE, wakeup, delay);
+  }
+  DartState* GetDartState(const Task& task) override {
+    return dart_states_[&task];
+  }
+  void RunBatch(DartState* dart_state, const std::vector<int>& ids) override {
+    Batch batch;
+    batch.dart_state = dart_state;
+    batch.ids = ids;
+    batches_.push_back(batch);
+    for (int id : ids)
+      RunTimer(id);
+  }
+  void InvokeTimer(Task* task) override { callbacks_[task].Run(); }
+
+ private:
+  scoped_refptr<base::TestMockTimeTaskRunner> task_runner_;
+  std::map<const Task*, DartState*> dart_states_;
+  std::map<const Task*, base::Closure> callbacks_;
+  std::vector<Batch> batches_;
+  std::vector<base::TimeDelta> wakeup_delays_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestTimerHeap);
+};
+
+void Record(std::vector<int>* log, int value) {
+  log->push_back(value);
+}
+
+void Cancel(DartTimerHeap* heap, const int* id) {
+  heap->Remove(*id);
+}
+
+void CancelOnThirdRun(DartTimerHeap* heap, const int* id, int* runs) {
+  if (++*runs == 3)
+    heap->Remove(*id);
+}
+
+void RecordRunTimeAndCancelOnThirdRun(
+    base::TestMockTimeTaskRunner* task_runner,
+    std::vector<base::TimeDelta>* run_times,
+    DartTimerHeap* heap,
+    const int* id) {
+  run_times->push_back(task_runner->NowTicks() - base::TimeTicks());
+  if (run_times->size() == 3)
+    heap->Remove(*id);
+}
+
+class DartTimerHeapTest : public testing::Test {
+ protected:
+  DartTimerHeapTest()
+      : task_runner_(new base::TestMockTimeTaskRunner), heap_(task_runner_) {}
+
+  void RunUntilIdle() { task_runner_->RunUntilIdle(); }
+
+  base::MessageLoop message_loop_;
+  scoped_refptr<base::TestMockTimeTaskRunner> task_runner_;
+  DartState first_state_;
+  DartState second_state_;
+  TestTimerHeap heap_;
+  std::vector<int> log_;
+};
+
+TEST_F(DartTimerHeapTest, BatchesConsecutiveTimersOfOneIsolate) {
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 1));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 2));
+  heap_.AddTimer(&second_state_, base::Bind(&Record, &log_, 3));
+  RunUntilIdle();
+
+  EXPECT_EQ(std::vector<int>({1, 2, 3}), log_);
+  ASSERT_EQ(2u, heap_.batches().size());
+  EXPECT_EQ(&first_state_, heap_.batches()[0].dart_state);
+  EXPECT_EQ(2u, heap_.batches()[0].ids.size());
+  EXPECT_EQ(&second_state_, heap_.batches()[1].dart_state);
+  EXPECT_EQ(1u, heap_.batches()[1].ids.size());
+}
+
+TEST_F(DartTimerHeapTest, RunsEachTimerInItsOwnIsolate) {
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 1));
+  heap_.AddTimer(&second_state_, base::Bind(&Record, &log_, 2));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 3));
+  RunUntilIdle();
+
+  // Deadline order wins over grouping by isolate.
+  EXPECT_EQ(std::vector<int>({1, 2, 3}), log_);
+  ASSERT_EQ(3u, heap_.batches().size());
+  EXPECT_EQ(&first_state_, heap_.batches()[0].dart_state);
+  EXPECT_EQ(&second_state_, heap_.batches()[1].dart_state);
+  EXPECT_EQ(&first_state_, heap_.batches()[2].dart_state);
+}
+
+TEST_F(DartTimerHeapTest, DropsTimersOfShutDownIsolates) {
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 1));
+  heap_.AddTimer(nullptr, base::Bind(&Record, &log_, 2));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 3));
+  RunUntilIdle();
+
+  EXPECT_EQ(std::vector<int>({1, 3}), log_);
+  ASSERT_EQ(1u, heap_.batches().size());
+  EXPECT_EQ(2u, heap_.batches()[0].ids.size());
+}
+
+TEST_F(DartTimerHeapTest, SkipsTimersCancelledEarlierInTheBatch) {
+  int cancelled = 0;
+  heap_.AddTimer(&first_state_, base::Bind(&Cancel, &heap_, &cancelled));
+  cancelled = heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 1));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 2));
+  RunUntilIdle();
+
+  EXPECT_EQ(std::vector<int>({2}), log_);
+}
+
+TEST_F(DartTimerHeapTest, ReschedulesRepeatingTimers) {
+  int id = 0;
+  int runs = 0;
+  id = heap_.AddTimer(&first_state_,
+                      base::Bind(&CancelOnThirdRun, &heap_, &id, &runs),
+                      base::TimeDelta(), true);
+  RunUntilIdle();
+
+  EXPECT_EQ(3, runs);
+  EXPECT_EQ(3u, heap_.batches().size());
+}
+
+TEST_F(DartTimerHeapTest, RunsTimersInDeadlineOrder) {
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 30), Ms(30));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 10), Ms(10));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 20), Ms(20));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 5), Ms(5));
+
+  task_runner_->FastForwardBy(Ms(4));
+  EXPECT_TRUE(log_.empty());
+  task_runner_->FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(std::vector<int>({5, 10, 20, 30}), log_);
+  // The deadlines are further apart than the slack.
+  EXPECT_EQ(4u, heap_.batches().size());
+}
+
+TEST_F(DartTimerHeapTest, PostsOneWakeupForTheEarliestDeadline) {
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 30), Ms(30));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 20), Ms(20));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 40), Ms(40));
+
+  // The second timer moves the wakeup earlier. The third doesn't need one.
+  ASSERT_EQ(2u, heap_.wakeup_delays().size());
+  EXPECT_EQ(Ms(30), heap_.wakeup_delays()[0]);
+  EXPECT_EQ(Ms(20), heap_.wakeup_delays()[1]);
+
+  task_runner_->FastForwardBy(Ms(20));
+  EXPECT_EQ(std::vector<int>({20}), log_);
+  // The next wakeup is posted once the first one has run.
+  ASSERT_EQ(3u, heap_.wakeup_delays().size());
+  EXPECT_EQ(Ms(10), heap_.wakeup_delays()[2]);
+
+  // The replaced 30ms wakeup was cancelled, so 30 runs only once.
+  task_runner_->FastForwardBy(Ms(10));
+  EXPECT_EQ(std::vector<int>({20, 30}), log_);
+  task_runner_->FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(std::vector<int>({20, 30, 40}), log_);
+  EXPECT_EQ(4u, heap_.wakeup_delays().size());
+  EXPECT_EQ(3u, heap_.batches().size());
+}
+
+TEST_F(DartTimerHeapTest, CoalescesTimersWithinTheSlack) {
+  heap_.set_slack(Ms(5));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 13), Ms(13));
+  // The pending wakeup is within the slack of this deadline, so it is kept.
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 10), Ms(10));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 20), Ms(20));
+  ASSERT_EQ(1u, heap_.wakeup_delays().size());
+  EXPECT_EQ(Ms(13), heap_.wakeup_delays()[0]);
+
+  task_runner_->FastForwardBy(Ms(12));
+  EXPECT_TRUE(log_.empty());
+  task_runner_->FastForwardBy(Ms(1));
+  EXPECT_EQ(std::vector<int>({10, 13}), log_);
+  ASSERT_EQ(1u, heap_.batches().size());
+  EXPECT_EQ(2u, heap_.batches()[0].ids.size());
+
+  // 20 is past the slack window of 10, so it gets a wakeup of its own.
+  task_runner_->FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(std::vector<int>({10, 13, 20}), log_);
+  EXPECT_EQ(2u, heap_.batches().size());
+}
+
+TEST_F(DartTimerHeapTest, CoalescedWakeupWaitsForTheLatestDeadlineInTheSlack) {
+  heap_.set_slack(Ms(5));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 1), Ms(1));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 12), Ms(12));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 14), Ms(14));
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 18), Ms(18));
+
+  task_runner_->FastForwardBy(Ms(1));
+  EXPECT_EQ(std::vector<int>({1}), log_);
+  // After the first wakeup, the next one covers 12 and 14 but not 18.
+  EXPECT_EQ(Ms(13), heap_.wakeup_delays().back());
+
+  task_runner_->FastForwardBy(Ms(13));
+  EXPECT_EQ(std::vector<int>({1, 12, 14}), log_);
+  task_runner_->FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(std::vector<int>({1, 12, 14, 18}), log_);
+  EXPECT_EQ(3u, heap_.batches().size());
+}
+
+TEST_F(DartTimerHeapTest, ReschedulesRepeatingTimersFromWhenTheyRan) {
+  std::vector<base::TimeDelta> run_times;
+  int id = 0;
+  id = heap_.AddTimer(&first_state_,
+                      base::Bind(&RecordRunTimeAndCancelOnThirdRun,
+                                 base::Unretained(task_runner_.get()),
+                                 &run_times, &heap_, &id),
+                      Ms(10), true);
+  heap_.AddTimer(&first_state_, base::Bind(&Record, &log_, 15), Ms(15));
+
+  task_runner_->FastForwardBy(Ms(10));
+  EXPECT_EQ(std::vector<base::TimeDelta>({Ms(10)}), run_times);
+  // The repeat goes back into the heap behind the 15ms timer.
+  task_runner_->FastForwardBy(Ms(5));
+  EXPECT_EQ(std::vector<int>({15}), log_);
+  EXPECT_EQ(1u, run_times.size());
+
+  task_runner_->FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(std::vector<base::TimeDelta>({Ms(10), Ms(20), Ms(30)}),
+            run_times);
+  EXPECT_EQ(Ms(30), task_runner_->NowTicks() - base::TimeTicks());
+}
+
+}  // namespace
+}  // namespace blink
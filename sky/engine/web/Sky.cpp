@@ -37,6 +37,7 @@
 #include "sky/engine/core/dom/Microtask.h"
 #include "sky/engine/core/frame/Settings.h"
 #include "sky/engine/core/Init.h"
+#include "sky/engine/core/loader/CanvasImageDecoder.h"
 #include "sky/engine/core/page/Page.h"
 #include "sky/engine/core/script/dart_init.h"
 #include "sky/engine/platform/LayoutTestSupport.h"
@@ -144,10 +145,17 @@ void initialize(Platform* platform)
     addMessageLoopObservers();
 }
 
+std::string dartBuildIdentity()
+{
+    return DartBuildIdentity();
+}
+
 void shutdown()
 {
     removeMessageLoopObservers();
 
+    CanvasImageDecoder::ShutdownDecodingThreads();
+
     // FIXME: Shutdown dart?
 
     CoreInitializer::shutdown();
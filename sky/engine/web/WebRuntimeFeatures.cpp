@@ -180,4 +180,9 @@ void WebRuntimeFeatures::enableDartCheckedMode(bool enable)
     RuntimeEnabledFeatures::setDartCheckedModeEnabled(enable);
 }
 
+void WebRuntimeFeatures::enableDartLibraryPrefetch(bool enable)
+{
+    RuntimeEnabledFeatures::setDartLibraryPrefetchEnabled(enable);
+}
+
 } // namespace blink
@@ -0,0 +1,19 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// The timing loop shared by the *_benchmark.dart examples in this directory.
+
+/// Calls [body] [warmUpIterations] times without timing it, so that the code
+/// is optimized and any caches are filled, then [iterations] times under a
+/// stopwatch. Returns the mean time per timed call in microseconds.
+double timeIterations(int iterations, void body(), { int warmUpIterations: 3 }) {
+  for (int i = 0; i < warmUpIterations; ++i)
+    body();
+
+  Stopwatch watch = new Stopwatch()..start();
+  for (int i = 0; i < iterations; ++i)
+    body();
+  watch.stop();
+  return watch.elapsedMicroseconds / iterations;
+}
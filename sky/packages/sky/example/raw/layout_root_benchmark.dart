@@ -0,0 +1,62 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how fast LayoutRoots can be created and laid out for the kind of
+// small subtrees the rendering library builds for paragraphs. Results are
+// printed to the console.
+
+import 'dart:sky';
+
+import 'benchmark_timer.dart';
+
+const int kRootCount = 200;
+const int kIterations = 20;
+
+Element buildParagraph(Document document, int index) {
+  Element block = document.createElement('p');
+  block.style['font-size'] = '14px';
+  block.appendChild(document.createText('Paragraph $index says '));
+  Element bold = document.createElement('t');
+  bold.style['font-weight'] = 'bold';
+  bold.appendChild(document.createText('hello'));
+  block.appendChild(bold);
+  block.appendChild(document.createText(' to the world.'));
+  return block;
+}
+
+void printPerRoot(String name, double microsPerPass) {
+  double microsPerRoot = microsPerPass / kRootCount;
+  print('$name: ${microsPerRoot.toStringAsFixed(1)}us per root');
+}
+
+void main() {
+  // Creating a root, attaching a subtree and laying it out for the first
+  // time, as the rendering library does for each new paragraph.
+  printPerRoot('create and layout', timeIterations(kIterations, () {
+    for (int i = 0; i < kRootCount; ++i) {
+      Document document = new Document();
+      LayoutRoot root = new LayoutRoot();
+      root.rootElement = buildParagraph(document, i);
+      root.maxWidth = 300.0;
+      root.layout();
+    }
+  }));
+
+  // Laying out existing roots again at alternating widths, as happens when
+  // the constraints change from frame to frame.
+  List<LayoutRoot> roots = <LayoutRoot>[];
+  for (int i = 0; i < kRootCount; ++i) {
+    LayoutRoot root = new LayoutRoot();
+    root.rootElement = buildParagraph(new Document(), i);
+    roots.add(root);
+  }
+  int pass = 0;
+  printPerRoot('relayout', timeIterations(kIterations, () {
+    double width = pass++ % 2 == 0 ? 200.0 : 300.0;
+    for (LayoutRoot root in roots) {
+      root.maxWidth = width;
+      root.layout();
+    }
+  }));
+}
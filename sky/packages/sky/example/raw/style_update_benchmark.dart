@@ -0,0 +1,76 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares updating inline styles with strings, which C++ has to tokenize and
+// parse, against the typed setters on CSSStyleDeclaration, which hand the
+// values to the property parser directly. Results are printed to the console.
+//
+// Lengths, numbers and colors get a new value on every update so that the
+// parsed value cache can't hide the cost of parsing the strings. Keywords
+// only have a few values, so the string keyword case mostly measures cache
+// hits.
+
+import 'dart:sky';
+
+import 'benchmark_timer.dart';
+
+const int kElementCount = 10000;
+const int kIterations = 10;
+
+void updateAll(String name, List<Element> elements, void update(Element element, int value)) {
+  // Counts every update, including the warm-up ones, so no value repeats.
+  int value = 0;
+  double microsPerPass = timeIterations(kIterations, () {
+    for (Element element in elements)
+      update(element, ++value);
+  });
+  print('$name: ${microsPerPass.toStringAsFixed(1)}us per '
+        '$kElementCount elements');
+}
+
+void main() {
+  Document document = new Document();
+  Element root = document.createElement('div');
+  document.appendChild(root);
+  List<Element> elements = <Element>[];
+  for (int i = 0; i < kElementCount; ++i) {
+    Element element = document.createElement('div');
+    root.appendChild(element);
+    elements.add(element);
+  }
+
+  updateAll('string lengths', elements, (Element element, int value) {
+    element.style['width'] = '${value}px';
+    element.style['height'] = '${value / 1000.0}%';
+  });
+  updateAll('typed lengths', elements, (Element element, int value) {
+    element.style.setLength('width', value.toDouble(), LengthUnit.px);
+    element.style.setLength('height', value / 1000.0, LengthUnit.percent);
+  });
+
+  updateAll('string numbers', elements, (Element element, int value) {
+    element.style['opacity'] = '${value / 1000000.0}';
+    element.style['flex-grow'] = '$value';
+  });
+  updateAll('typed numbers', elements, (Element element, int value) {
+    element.style.setNumber('opacity', value / 1000000.0);
+    element.style.setNumber('flex-grow', value.toDouble());
+  });
+
+  updateAll('string colors', elements, (Element element, int value) {
+    element.style['background-color'] =
+        'rgba(${value & 0xFF}, ${(value >> 8) & 0xFF}, ${(value >> 16) & 0xFF}, 1)';
+  });
+  updateAll('typed colors', elements, (Element element, int value) {
+    element.style.setColor('background-color',
+        new Color.fromARGB(0xFF, value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF));
+  });
+
+  updateAll('string keywords', elements, (Element element, int value) {
+    element.style['display'] = value % 2 == 0 ? 'flex' : 'paragraph';
+  });
+  updateAll('typed keywords', elements, (Element element, int value) {
+    element.style.setKeyword('display', value % 2 == 0 ? 'flex' : 'paragraph');
+  });
+}
@@ -338,21 +338,26 @@ abstract class RenderObject extends AbstractNode implements HitTestTarget {
     }
   }
 
-  static void flushPaint() {
+  // Returns whether any node was repainted.
+  static bool flushPaint() {
     sky.tracing.begin('RenderObject.flushPaint');
     _debugDoingPaint = true;
+    bool didPaint = false;
     try {
       List<RenderObject> dirtyNodes = _nodesNeedingPaint;
       _nodesNeedingPaint = new List<RenderObject>();
       for (RenderObject node in dirtyNodes..sort((a, b) => a.depth - b.depth)) {
-        if (node._needsPaint && node.attached)
+        if (node._needsPaint && node.attached) {
           node._updatePaintingCanvas();
+          didPaint = true;
+        }
       };
       assert(_nodesNeedingPaint.length == 0);
     } finally {
       _debugDoingPaint = false;
       sky.tracing.end('RenderObject.flushPaint');
     }
+    return didPaint;
   }
 
   void _updatePaintingCanvas() {
@@ -71,8 +71,10 @@ class SkyBinding {
   }
   void beginFrame(double timeStamp) {
     RenderObject.flushLayout();
-    RenderObject.flushPaint();
-    _renderView.paintFrame();
+    // Keep the previous frame's picture when nothing was repainted, so that
+    // the compositor sees the same picture and can reuse its cached raster.
+    if (RenderObject.flushPaint())
+      _renderView.paintFrame();
   }
 
   final List<EventListener> _eventListeners = new List<EventListener>();
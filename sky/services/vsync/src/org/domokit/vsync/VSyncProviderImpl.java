@@ -4,7 +4,10 @@
 
 package org.domokit.vsync;
 
+import android.content.Context;
 import android.view.Choreographer;
+import android.view.Display;
+import android.view.WindowManager;
 
 import org.chromium.mojo.system.MessagePipeHandle;
 import org.chromium.mojo.system.MojoException;
@@ -14,13 +17,23 @@ import org.chromium.mojom.vsync.VSyncProvider;
  * Android implementation of VSyncProvider.
  */
 public class VSyncProviderImpl implements VSyncProvider, Choreographer.FrameCallback {
+    private static final long DEFAULT_FRAME_INTERVAL_MICROS = 16667;
+
     private Choreographer mChoreographer;
     private AwaitVSyncResponse mCallback;
     private MessagePipeHandle mPipe;
+    private long mFrameIntervalMicros;
 
-    public VSyncProviderImpl(MessagePipeHandle pipe) {
+    public VSyncProviderImpl(Context context, MessagePipeHandle pipe) {
         mPipe = pipe;
         mChoreographer = Choreographer.getInstance();
+
+        WindowManager windowManager =
+                (WindowManager) context.getSystemService(Context.WINDOW_SERVICE);
+        Display display = windowManager.getDefaultDisplay();
+        float refreshRate = display.getRefreshRate();
+        mFrameIntervalMicros = refreshRate > 0
+                ? (long) (1000000 / refreshRate) : DEFAULT_FRAME_INTERVAL_MICROS;
     }
 
     @Override
@@ -39,6 +52,11 @@ public class VSyncProviderImpl implements VSyncProvider, Choreographer.FrameCall
         mChoreographer.postFrameCallback(this);
     }
 
+    @Override
+    public void getFrameInterval(GetFrameIntervalResponse callback) {
+        callback.call(mFrameIntervalMicros);
+    }
+
     @Override
     public void doFrame(long frameTimeNanos) {
         mCallback.call(frameTimeNanos / 1000);
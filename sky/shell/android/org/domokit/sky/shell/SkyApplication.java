@@ -103,7 +103,7 @@ public class SkyApplication extends BaseChromiumApplication {
         registry.register(VSyncProvider.MANAGER.getName(), new ServiceFactory() {
             @Override
             public void connectToService(Context context, Core core, MessagePipeHandle pipe) {
-                VSyncProvider.MANAGER.bind(new VSyncProviderImpl(pipe), pipe);
+                VSyncProvider.MANAGER.bind(new VSyncProviderImpl(context, pipe), pipe);
             }
         });
     }
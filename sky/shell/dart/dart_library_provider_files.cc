@@ -73,12 +73,21 @@ Dart_Handle DartLibraryProviderFiles::CanonicalizeURL(Dart_Handle library,
   std::string string = blink::StdStringFromDart(url);
   if (base::StartsWithASCII(string, "dart:", true))
     return url;
-  if (base::StartsWithASCII(string, "package:", true))
-    return blink::StdStringToDart(CanonicalizePackageURL(string));
-  base::FilePath base_path(blink::StdStringFromDart(Dart_LibraryUrl(library)));
-  base::FilePath resolved_path = base_path.DirName().Append(string);
+  return blink::StdStringToDart(ResolveURL(
+      blink::StdStringFromDart(Dart_LibraryUrl(library)), string));
+}
+
+std::string DartLibraryProviderFiles::ResolveURL(
+    const std::string& library_url,
+    const std::string& url) {
+  if (base::StartsWithASCII(url, "dart:", true))
+    return url;
+  if (base::StartsWithASCII(url, "package:", true))
+    return CanonicalizePackageURL(url);
+  base::FilePath base_path(library_url);
+  base::FilePath resolved_path = base_path.DirName().Append(url);
   base::FilePath normalized_path = SimplifyPath(resolved_path);
-  return blink::StdStringToDart(normalized_path.AsUTF8Unsafe());
+  return normalized_path.AsUTF8Unsafe();
 }
 
 }  // namespace shell
@@ -21,6 +21,8 @@ class DartLibraryProviderFiles : public blink::DartLibraryProvider {
   void GetLibraryAsStream(const std::string& name,
                           blink::DataPipeConsumerCallback callback) override;
   Dart_Handle CanonicalizeURL(Dart_Handle library, Dart_Handle url) override;
+  std::string ResolveURL(const std::string& library_url,
+                         const std::string& url) override;
 
  private:
   std::string CanonicalizePackageURL(std::string url);
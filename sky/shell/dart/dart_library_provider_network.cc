@@ -76,12 +76,21 @@ Dart_Handle DartLibraryProviderNetwork::CanonicalizeURL(Dart_Handle library,
   std::string string = blink::StdStringFromDart(url);
   if (base::StartsWithASCII(string, "dart:", true))
     return url;
+  return blink::StdStringToDart(ResolveURL(
+      blink::StdStringFromDart(Dart_LibraryUrl(library)), string));
+}
+
+std::string DartLibraryProviderNetwork::ResolveURL(
+    const std::string& library_url,
+    const std::string& url) {
+  if (base::StartsWithASCII(url, "dart:", true))
+    return url;
+  std::string string = url;
   // TODO(abarth): The package root should be configurable.
   if (base::StartsWithASCII(string, "package:", true))
     base::ReplaceFirstSubstringAfterOffset(&string, 0, "package:", "/packages/");
-  GURL library_url(blink::StdStringFromDart(Dart_LibraryUrl(library)));
-  GURL resolved_url = library_url.Resolve(string);
-  return blink::StdStringToDart(resolved_url.spec());
+  GURL resolved_url = GURL(library_url).Resolve(string);
+  return resolved_url.spec();
 }
 
 }  // namespace shell
@@ -25,6 +25,8 @@ class DartLibraryProviderNetwork : public blink::DartLibraryProvider {
   void GetLibraryAsStream(const std::string& name,
                           blink::DataPipeConsumerCallback callback) override;
   Dart_Handle CanonicalizeURL(Dart_Handle library, Dart_Handle url) override;
+  std::string ResolveURL(const std::string& library_url,
+                         const std::string& url) override;
 
  private:
   class Job;
@@ -7,9 +7,8 @@
 #include "base/trace_event/trace_event.h"
 #include "sky/shell/gpu/ganesh_context.h"
 #include "sky/shell/gpu/ganesh_surface.h"
-#include "sky/shell/gpu/picture_serializer.h"
 #include "third_party/skia/include/core/SkCanvas.h"
-#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkSurface.h"
 #include "ui/gl/gl_bindings.h"
 #include "ui/gl/gl_context.h"
 #include "ui/gl/gl_share_group.h"
@@ -17,17 +16,11 @@
 
 namespace sky {
 namespace shell {
-namespace {
-
-gfx::Size GetSize(SkPicture* picture) {
-  const SkRect& rect = picture->cullRect();
-  return gfx::Size(rect.width(), rect.height());
-}
-
-}  // namespace
 
 Rasterizer::Rasterizer()
-    : share_group_(new gfx::GLShareGroup()), weak_factory_(this) {
+    : share_group_(new gfx::GLShareGroup()),
+      headless_(false),
+      weak_factory_(this) {
 }
 
 Rasterizer::~Rasterizer() {
@@ -38,40 +31,65 @@ base::WeakPtr<Rasterizer> Rasterizer::GetWeakPtr() {
 }
 
 void Rasterizer::OnAcceleratedWidgetAvailable(gfx::AcceleratedWidget widget) {
+  if (widget == gfx::kNullAcceleratedWidget) {
+    headless_ = true;
+    return;
+  }
   surface_ = gfx::GLSurface::CreateViewGLSurface(widget,
                                                  gfx::SurfaceConfiguration());
   CHECK(surface_) << "GLSurface required.";
 }
 
-void Rasterizer::Draw(skia::RefPtr<SkPicture> picture) {
+compositor::PaintContext::FrameStats Rasterizer::Draw(
+    scoped_ptr<compositor::LayerTree> layer_tree) {
   TRACE_EVENT0("sky", "Rasterizer::Draw");
 
-  if (!surface_)
-    return;
+  const SkISize& frame_size = layer_tree->frame_size();
+  gfx::Size size(frame_size.width(), frame_size.height());
+  if (size.IsEmpty() || (!surface_ && !headless_))
+    return compositor::PaintContext::FrameStats();
 
-  gfx::Size size = GetSize(picture.get());
-  if (size.IsEmpty())
-    return;
+  if (headless_) {
+    EnsureBitmapSurface(size);
+    return DrawLayerTree(layer_tree.get(), bitmap_surface_->getCanvas(),
+                         nullptr);
+  }
 
   EnsureGLContext();
   CHECK(context_->MakeCurrent(surface_.get()));
   EnsureGaneshSurface(surface_->GetBackingFrameBufferObject(), size);
 
-  DrawPicture(picture.get());
+  compositor::PaintContext::FrameStats stats = DrawLayerTree(
+      layer_tree.get(), ganesh_surface_->canvas(), ganesh_context_->gr());
   surface_->SwapBuffers();
-
-  // SerializePicture("/data/data/org.domokit.sky.demo/cache/layer0.skp", picture.get());
+  return stats;
 }
 
-void Rasterizer::DrawPicture(SkPicture* picture) {
-  TRACE_EVENT0("sky", "Rasterizer::DrawPicture");
-  SkCanvas* canvas = ganesh_surface_->canvas();
-  canvas->drawPicture(picture);
+compositor::PaintContext::FrameStats Rasterizer::DrawLayerTree(
+    compositor::LayerTree* layer_tree,
+    SkCanvas* canvas,
+    GrContext* gr_context) {
+  TRACE_EVENT0("sky", "Rasterizer::DrawLayerTree");
+  compositor::PaintContext::FrameStats stats;
+  {
+    compositor::PaintContext::ScopedFrame frame(paint_context_, gr_context,
+                                                *canvas);
+    canvas->clear(SK_ColorBLACK);
+    layer_tree->Raster(frame);
+    stats = frame.stats();
+  }
   canvas->flush();
+  return stats;
 }
 
 void Rasterizer::OnOutputSurfaceDestroyed() {
+  if (headless_) {
+    headless_ = false;
+    bitmap_surface_.clear();
+    return;
+  }
   CHECK(context_->MakeCurrent(surface_.get()));
+  paint_context_.raster_cache().Clear();
   ganesh_surface_.reset();
   ganesh_context_.reset();
   context_ = nullptr;
@@ -95,5 +113,14 @@ void Rasterizer::EnsureGaneshSurface(intptr_t window_fbo,
       new GaneshSurface(window_fbo, ganesh_context_.get(), size));
 }
 
+void Rasterizer::EnsureBitmapSurface(const gfx::Size& size) {
+  if (bitmap_surface_ && bitmap_surface_->width() == size.width() &&
+      bitmap_surface_->height() == size.height())
+    return;
+  bitmap_surface_ = skia::AdoptRef(SkSurface::NewRasterN32Premul(
+      size.width(), size.height()));
+  CHECK(bitmap_surface_) << "Bitmap surface required.";
+}
+
 }  // namespace shell
 }  // namespace sky
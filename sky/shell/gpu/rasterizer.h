@@ -8,11 +8,14 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "skia/ext/refptr.h"
+#include "sky/compositor/paint_context.h"
 #include "sky/shell/gpu_delegate.h"
 #include "ui/gfx/geometry/size.h"
 #include "ui/gfx/native_widget_types.h"
 
-class SkPicture;
+class GrContext;
+class SkCanvas;
+class SkSurface;
 
 namespace gfx {
 class GLContext;
@@ -34,12 +37,17 @@ class Rasterizer : public GPUDelegate {
 
   void OnAcceleratedWidgetAvailable(gfx::AcceleratedWidget widget) override;
   void OnOutputSurfaceDestroyed() override;
-  void Draw(skia::RefPtr<SkPicture> picture) override;
+  compositor::PaintContext::FrameStats Draw(
+      scoped_ptr<compositor::LayerTree> layer_tree) override;
 
  private:
   void EnsureGLContext();
   void EnsureGaneshSurface(intptr_t window_fbo, const gfx::Size& size);
-  void DrawPicture(SkPicture* picture);
+  void EnsureBitmapSurface(const gfx::Size& size);
+  compositor::PaintContext::FrameStats DrawLayerTree(
+      compositor::LayerTree* layer_tree,
+      SkCanvas* canvas,
+      GrContext* gr_context);
 
   scoped_refptr<gfx::GLShareGroup> share_group_;
   scoped_refptr<gfx::GLSurface> surface_;
@@ -48,6 +56,12 @@ class Rasterizer : public GPUDelegate {
   scoped_ptr<GaneshContext> ganesh_context_;
   scoped_ptr<GaneshSurface> ganesh_surface_;
 
+  // Without a window, frames are drawn into this offscreen bitmap instead.
+  bool headless_;
+  skia::RefPtr<SkSurface> bitmap_surface_;
+
+  compositor::PaintContext paint_context_;
+
   base::WeakPtrFactory<Rasterizer> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(Rasterizer);
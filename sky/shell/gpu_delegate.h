@@ -5,11 +5,10 @@
 #ifndef SKY_SHELL_GPU_DELEGATE_H_
 #define SKY_SHELL_GPU_DELEGATE_H_
 
-#include "skia/ext/refptr.h"
+#include "base/memory/scoped_ptr.h"
+#include "sky/compositor/layer_tree.h"
 #include "ui/gfx/native_widget_types.h"
 
-class SkPicture;
-
 namespace sky {
 namespace shell {
 
@@ -17,7 +16,9 @@ class GPUDelegate {
  public:
   virtual void OnAcceleratedWidgetAvailable(gfx::AcceleratedWidget widget) = 0;
   virtual void OnOutputSurfaceDestroyed() = 0;
-  virtual void Draw(skia::RefPtr<SkPicture> picture) = 0;
+  // Draws |layer_tree| and returns what it drew.
+  virtual compositor::PaintContext::FrameStats Draw(
+      scoped_ptr<compositor::LayerTree> layer_tree) = 0;
 
  protected:
   virtual ~GPUDelegate();
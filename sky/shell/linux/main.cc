@@ -11,12 +11,15 @@
 #include "base/i18n/icu_util.h"
 #include "base/logging.h"
 #include "base/message_loop/message_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "sky/engine/public/web/WebRuntimeFeatures.h"
+#include "sky/shell/linux/vsync_provider_linux.h"
 #include "sky/shell/platform_view.h"
 #include "sky/shell/service_provider.h"
 #include "sky/shell/shell.h"
 #include "sky/shell/shell_view.h"
 #include "sky/shell/switches.h"
+#include "sky/shell/testing/frame_benchmark.h"
 #include "sky/shell/testing/test_runner.h"
 
 namespace sky {
@@ -28,16 +31,91 @@ void Usage() {
             << " --" << switches::kNonInteractive
             << " --" << switches::kPackageRoot << "=PACKAGE_ROOT"
             << " --" << switches::kSnapshot << "=SNAPSHOT"
+            << " [ --" << switches::kDartLibraryPrefetch << " ]"
+            << " [ --" << switches::kDartSnapshotCache << "=CACHE_DIR ]"
+            << " [ --" << switches::kFrameBenchmark << "[=OUTPUT_JSON]"
+            << " [ --" << switches::kFrameBenchmarkFrames << "=FRAMES ]"
+            << " [ --" << switches::kFrameBenchmarkInput << "=RECORDING ] ]"
+            << " [ --" << switches::kRecordInput << "=RECORDING ]"
+            << " [ --" << switches::kVSync << "=timer|virtual ]"
             << " [ MAIN_DART ]" << std::endl;
 }
 
-void Init() {
+const int kDefaultBenchmarkFrames = 240;
+
+void DidFinishFrameBenchmark(int* exit_code, bool success) {
+  *exit_code = success ? 0 : 1;
+  base::MessageLoop::current()->Quit();
+}
+
+void StartFrameBenchmark(int* exit_code) {
   base::CommandLine& command_line = *base::CommandLine::ForCurrentProcess();
+
+  FrameBenchmark::Config config;
+  config.package_root =
+      command_line.GetSwitchValueASCII(switches::kPackageRoot);
+  if (command_line.HasSwitch(switches::kSnapshot)) {
+    config.main = command_line.GetSwitchValueASCII(switches::kSnapshot);
+    config.is_snapshot = true;
+  } else {
+    auto args = command_line.GetArgs();
+    if (args.empty()) {
+      Usage();
+      exit(1);
+    }
+    config.main = args[0];
+  }
+  config.output_path =
+      command_line.GetSwitchValuePath(switches::kFrameBenchmark);
+  config.input_path =
+      command_line.GetSwitchValuePath(switches::kFrameBenchmarkInput);
+  config.frame_count = kDefaultBenchmarkFrames;
+  if (command_line.HasSwitch(switches::kFrameBenchmarkFrames) &&
+      !base::StringToInt(
+          command_line.GetSwitchValueASCII(switches::kFrameBenchmarkFrames),
+          &config.frame_count)) {
+    Usage();
+    exit(1);
+  }
+
+  // Lives until the process exits, since the engine keeps running after the
+  // benchmark is done.
+  FrameBenchmark* benchmark = new FrameBenchmark(config);
+  benchmark->Start(base::Bind(&DidFinishFrameBenchmark, exit_code));
+}
+
+void ConfigureVSync() {
+  base::CommandLine& command_line = *base::CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(switches::kVSync))
+    return;
+  std::string clock = command_line.GetSwitchValueASCII(switches::kVSync);
+  if (clock == "timer") {
+    VSyncProviderLinux::Shared().set_clock(VSyncProviderLinux::Clock::kTimer);
+  } else if (clock == "virtual") {
+    VSyncProviderLinux::Shared().set_clock(
+        VSyncProviderLinux::Clock::kVirtual);
+  } else {
+    Usage();
+    exit(1);
+  }
+}
+
+void Init(int* exit_code) {
+  base::CommandLine& command_line = *base::CommandLine::ForCurrentProcess();
+  ConfigureVSync();
   blink::WebRuntimeFeatures::enableObservatory(
       !command_line.HasSwitch(switches::kNonInteractive));
+  blink::WebRuntimeFeatures::enableDartLibraryPrefetch(
+      command_line.HasSwitch(switches::kDartLibraryPrefetch));
 
   Shell::Init(make_scoped_ptr(new ServiceProviderContext(
       base::MessageLoop::current()->task_runner())));
+
+  if (command_line.HasSwitch(switches::kFrameBenchmark)) {
+    StartFrameBenchmark(exit_code);
+    return;
+  }
+
   // Explicitly boot the shared test runner.
   TestRunner& runner = TestRunner::Shared();
 
@@ -82,8 +160,9 @@ int main(int argc, const char* argv[]) {
 
   base::i18n::InitializeICU();
 
-  message_loop.PostTask(FROM_HERE, base::Bind(&sky::shell::Init));
+  int exit_code = 0;
+  message_loop.PostTask(FROM_HERE, base::Bind(&sky::shell::Init, &exit_code));
   message_loop.Run();
 
-  return 0;
+  return exit_code;
 }
@@ -8,6 +8,7 @@
 #include "base/location.h"
 #include "base/single_thread_task_runner.h"
 #include "mojo/public/cpp/application/service_provider_impl.h"
+#include "sky/shell/linux/vsync_provider_linux.h"
 #include "sky/shell/service_provider.h"
 #include "sky/shell/testing/test_runner.h"
 
@@ -22,6 +23,7 @@ static void CreateServiceProviderImpl(
     mojo::InterfaceRequest<mojo::ServiceProvider> request) {
   g_service_provider.Get().reset(new mojo::ServiceProviderImpl(request.Pass()));
   g_service_provider.Get()->AddService(&TestRunner::Shared());
+  g_service_provider.Get()->AddService(&VSyncProviderLinux::Shared());
 }
 
 }  // namespace
@@ -0,0 +1,95 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/shell/linux/vsync_provider_linux.h"
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "base/trace_event/trace_event.h"
+
+namespace sky {
+namespace shell {
+namespace {
+
+const int64_t kVSyncIntervalMicroseconds = 16667;
+
+static VSyncProviderLinux* g_vsync_provider = nullptr;
+
+}  // namespace
+
+VSyncProviderLinux::VSyncProviderLinux()
+    : clock_(Clock::kTimer),
+      phase_(base::TimeTicks::Now()),
+      virtual_time_(phase_),
+      tick_scheduled_(false),
+      weak_factory_(this) {
+}
+
+VSyncProviderLinux::~VSyncProviderLinux() {
+}
+
+VSyncProviderLinux& VSyncProviderLinux::Shared() {
+  if (!g_vsync_provider)
+    g_vsync_provider = new VSyncProviderLinux();
+  return *g_vsync_provider;
+}
+
+void VSyncProviderLinux::Create(
+    mojo::ApplicationConnection* app,
+    mojo::InterfaceRequest<vsync::VSyncProvider> request) {
+  bindings_.AddBinding(this, request.Pass());
+}
+
+void VSyncProviderLinux::AwaitVSync(const AwaitVSyncCallback& callback) {
+  callbacks_.push_back(callback);
+  ScheduleTick();
+}
+
+void VSyncProviderLinux::GetFrameInterval(
+    const GetFrameIntervalCallback& callback) {
+  callback.Run(kVSyncIntervalMicroseconds);
+}
+
+void VSyncProviderLinux::ScheduleTick() {
+  if (tick_scheduled_)
+    return;
+  tick_scheduled_ = true;
+
+  base::TimeDelta interval =
+      base::TimeDelta::FromMicroseconds(kVSyncIntervalMicroseconds);
+  if (clock_ == Clock::kVirtual) {
+    virtual_time_ += interval;
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE, base::Bind(&VSyncProviderLinux::Tick,
+                              weak_factory_.GetWeakPtr(), virtual_time_));
+    return;
+  }
+
+  // Wait for the next multiple of the interval, so that ticks stay on a
+  // fixed grid however late the callers ask for them.
+  base::TimeTicks now = base::TimeTicks::Now();
+  int64_t intervals_elapsed = (now - phase_) / interval;
+  base::TimeTicks time = phase_ + interval * (intervals_elapsed + 1);
+  base::MessageLoop::current()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&VSyncProviderLinux::Tick, weak_factory_.GetWeakPtr(), time),
+      time - now);
+}
+
+void VSyncProviderLinux::Tick(base::TimeTicks time) {
+  TRACE_EVENT1("sky", "VSyncProviderLinux::Tick", "callbacks",
+               static_cast<int>(callbacks_.size()));
+  tick_scheduled_ = false;
+
+  std::vector<AwaitVSyncCallback> callbacks;
+  callbacks.swap(callbacks_);
+  for (const auto& callback : callbacks)
+    callback.Run(time.ToInternalValue());
+
+  if (!tick_callback_.is_null())
+    tick_callback_.Run(time);
+}
+
+}  // namespace shell
+}  // namespace sky
@@ -0,0 +1,80 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_SHELL_LINUX_VSYNC_PROVIDER_LINUX_H_
+#define SKY_SHELL_LINUX_VSYNC_PROVIDER_LINUX_H_
+
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "mojo/common/binding_set.h"
+#include "mojo/public/cpp/application/interface_factory_impl.h"
+#include "sky/services/vsync/vsync.mojom.h"
+
+namespace sky {
+namespace shell {
+
+// There is no display to synchronize with on Linux, so this stands in for one
+// by ticking at a fixed interval. Every engine waiting for vsync is answered
+// on the same tick. Lives on the platform thread.
+class VSyncProviderLinux : public mojo::InterfaceFactory<vsync::VSyncProvider>,
+                           public vsync::VSyncProvider {
+ public:
+  enum class Clock {
+    // Ticks on multiples of the interval in real time, like a display would.
+    kTimer,
+    // Ticks as soon as anyone waits, advancing a virtual time by exactly one
+    // interval per tick. Frames run as fast as they can while seeing the
+    // same frame times from run to run. The engine doesn't record the stage
+    // timings measured against the vsync time stamp (vsync latency and total)
+    // in this mode.
+    kVirtual,
+  };
+
+  static VSyncProviderLinux& Shared();
+
+  void set_clock(Clock clock) { clock_ = clock; }
+  Clock clock() const { return clock_; }
+
+  // Runs after each tick has been delivered, with the tick's time stamp. Lets
+  // a benchmark step its input in lock step with the virtual clock.
+  void set_tick_callback(const base::Callback<void(base::TimeTicks)>& callback) {
+    tick_callback_ = callback;
+  }
+
+  // mojo::InterfaceFactory<vsync::VSyncProvider> implementation:
+  void Create(mojo::ApplicationConnection* app,
+              mojo::InterfaceRequest<vsync::VSyncProvider> request) override;
+
+ private:
+  VSyncProviderLinux();
+  ~VSyncProviderLinux() override;
+
+  // vsync::VSyncProvider implementation:
+  void AwaitVSync(const AwaitVSyncCallback& callback) override;
+  void GetFrameInterval(const GetFrameIntervalCallback& callback) override;
+
+  void ScheduleTick();
+  void Tick(base::TimeTicks time);
+
+  Clock clock_;
+  base::TimeTicks phase_;
+  base::TimeTicks virtual_time_;
+  bool tick_scheduled_;
+  std::vector<AwaitVSyncCallback> callbacks_;
+  base::Callback<void(base::TimeTicks)> tick_callback_;
+  mojo::BindingSet<vsync::VSyncProvider> bindings_;
+
+  base::WeakPtrFactory<VSyncProviderLinux> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(VSyncProviderLinux);
+};
+
+}  // namespace shell
+}  // namespace sky
+
+#endif  // SKY_SHELL_LINUX_VSYNC_PROVIDER_LINUX_H_
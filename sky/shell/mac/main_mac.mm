@@ -41,6 +41,8 @@ void Init() {
   base::CommandLine& command_line = *base::CommandLine::ForCurrentProcess();
   blink::WebRuntimeFeatures::enableObservatory(
       !command_line.HasSwitch(switches::kNonInteractive));
+  blink::WebRuntimeFeatures::enableDartLibraryPrefetch(
+      command_line.HasSwitch(switches::kDartLibraryPrefetch));
 
   // Explicitly boot the shared test runner.
   TestRunner& runner = TestRunner::Shared();
@@ -31,6 +31,11 @@ void PlatformView::ConnectToEngine(
                             config_.ui_delegate, base::Passed(&request)));
 }
 
+void PlatformView::AttachHeadlessSurface() {
+  window_ = gfx::kNullAcceleratedWidget;
+  SurfaceWasCreated();
+}
+
 void PlatformView::SurfaceWasCreated() {
   config_.ui_task_runner->PostTask(
       FROM_HERE, base::Bind(&UIDelegate::OnAcceleratedWidgetAvailable,
@@ -28,6 +28,9 @@ class PlatformView {
 
   void ConnectToEngine(mojo::InterfaceRequest<SkyEngine> request);
 
+  // Lets the engine draw frames without a window, into an offscreen bitmap.
+  void AttachHeadlessSurface();
+
  protected:
   explicit PlatformView(const Config& config);
 
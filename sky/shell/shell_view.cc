@@ -5,10 +5,12 @@
 #include "sky/shell/shell_view.h"
 
 #include "base/bind.h"
+#include "base/command_line.h"
 #include "base/single_thread_task_runner.h"
 #include "sky/shell/gpu/rasterizer.h"
 #include "sky/shell/platform_view.h"
 #include "sky/shell/shell.h"
+#include "sky/shell/switches.h"
 #include "sky/shell/ui/engine.h"
 
 namespace sky {
@@ -39,6 +41,20 @@ void ShellView::CreateEngine() {
   config.service_provider_context = shell_.service_provider_context();
   config.gpu_task_runner = shell_.gpu_task_runner();
   config.gpu_delegate = rasterizer_->GetWeakPtr();
+  if (base::CommandLine::InitializedForCurrentProcess()) {
+    config.adaptive_frame_scheduling =
+        base::CommandLine::ForCurrentProcess()->HasSwitch(
+            switches::kAdaptiveFrameScheduling);
+    config.virtual_vsync =
+        base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+            switches::kVSync) == "virtual";
+    config.dart_snapshot_cache_path =
+        base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+            switches::kDartSnapshotCache);
+    config.input_event_recording_path =
+        base::CommandLine::ForCurrentProcess()->GetSwitchValuePath(
+            switches::kRecordInput);
+  }
   engine_.reset(new Engine(config));
 }
 
@@ -8,10 +8,18 @@ namespace sky {
 namespace shell {
 namespace switches {
 
+const char kAdaptiveFrameScheduling[] = "adaptive-frame-scheduling";
+const char kDartLibraryPrefetch[] = "dart-library-prefetch";
+const char kDartSnapshotCache[] = "dart-snapshot-cache";
+const char kFrameBenchmark[] = "frame-benchmark";
+const char kFrameBenchmarkFrames[] = "frame-benchmark-frames";
+const char kFrameBenchmarkInput[] = "frame-benchmark-input";
 const char kHelp[] = "help";
 const char kNonInteractive[] = "non-interactive";
 const char kPackageRoot[] = "package-root";
+const char kRecordInput[] = "record-input";
 const char kSnapshot[] = "snapshot";
+const char kVSync[] = "vsync";
 
 }  // namespace switches
 }  // namespace shell
@@ -9,10 +9,18 @@ namespace sky {
 namespace shell {
 namespace switches {
 
+extern const char kAdaptiveFrameScheduling[];
+extern const char kDartLibraryPrefetch[];
+extern const char kDartSnapshotCache[];
+extern const char kFrameBenchmark[];
+extern const char kFrameBenchmarkFrames[];
+extern const char kFrameBenchmarkInput[];
 extern const char kHelp[];
 extern const char kPackageRoot[];
 extern const char kNonInteractive[];
+extern const char kRecordInput[];
 extern const char kSnapshot[];
+extern const char kVSync[];
 
 }  // namespace switches
 }  // namespace shell
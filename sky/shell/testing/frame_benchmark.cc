@@ -0,0 +1,264 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/shell/testing/frame_benchmark.h"
+
+#include <iostream>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/message_loop/message_loop.h"
+#include "base/process/process_metrics.h"
+#include "base/values.h"
+#include "sky/shell/linux/vsync_provider_linux.h"
+#include "sky/shell/platform_view.h"
+#include "sky/shell/shell.h"
+#include "sky/shell/shell_view.h"
+
+namespace sky {
+namespace shell {
+namespace {
+
+const int kViewportWidth = 800;
+const int kViewportHeight = 600;
+
+const int64_t kFrameIntervalMicroseconds = 16667;
+
+// Each drag presses near the bottom of the view, moves to near the top over
+// this many frames and lifts.
+const int kDragFrames = 60;
+
+// How long to wait after the last input for the frames it caused to finish.
+const int64_t kSettleMilliseconds = 500;
+
+// Covers the whole process, not any one stage of the frame.
+size_t ProcessResidentBytes() {
+  scoped_ptr<base::ProcessMetrics> metrics(
+      base::ProcessMetrics::CreateProcessMetrics(
+          base::GetCurrentProcessHandle()));
+  return metrics->GetWorkingSetSize();
+}
+
+}  // namespace
+
+FrameBenchmark::Config::Config() : is_snapshot(false), frame_count(0) {
+}
+
+FrameBenchmark::Config::~Config() {
+}
+
+FrameBenchmark::FrameBenchmark(const Config& config)
+    : config_(config),
+      tick_count_(0),
+      resident_bytes_at_start_(0),
+      weak_factory_(this) {
+}
+
+FrameBenchmark::~FrameBenchmark() {
+}
+
+void FrameBenchmark::Start(const DoneCallback& done) {
+  done_ = done;
+  shell_view_.reset(new ShellView(Shell::Shared()));
+  shell_view_->view()->ConnectToEngine(GetProxy(&sky_engine_));
+
+  ViewportMetricsPtr metrics = ViewportMetrics::New();
+  metrics->physical_width = kViewportWidth;
+  metrics->physical_height = kViewportHeight;
+  sky_engine_->OnViewportMetricsChanged(metrics.Pass());
+
+  if (config_.is_snapshot)
+    sky_engine_->RunFromSnapshot(config_.main);
+  else
+    sky_engine_->RunFromFile(config_.main, config_.package_root);
+
+  shell_view_->view()->AttachHeadlessSurface();
+  sky_engine_->OnActivityResumed();
+
+  resident_bytes_at_start_ = ProcessResidentBytes();
+  if (!config_.input_path.empty()) {
+    StartReplay();
+    return;
+  }
+  VSyncProviderLinux& vsync_provider = VSyncProviderLinux::Shared();
+  if (vsync_provider.clock() == VSyncProviderLinux::Clock::kVirtual) {
+    // Step the drag once per virtual frame instead of in real time, so that
+    // the frames run back to back and every run sees the same input.
+    vsync_provider.set_tick_callback(base::Bind(
+        &FrameBenchmark::OnVSyncTick, weak_factory_.GetWeakPtr()));
+    Step(base::TimeTicks::Now());
+    return;
+  }
+  timer_.Start(FROM_HERE,
+               base::TimeDelta::FromMicroseconds(kFrameIntervalMicroseconds),
+               this, &FrameBenchmark::Tick);
+}
+
+void FrameBenchmark::Tick() {
+  Step(base::TimeTicks::Now());
+}
+
+void FrameBenchmark::OnVSyncTick(base::TimeTicks time) {
+  Step(time);
+}
+
+void FrameBenchmark::Step(base::TimeTicks time) {
+  if (tick_count_ == config_.frame_count) {
+    timer_.Stop();
+    ScheduleFinish();
+    return;
+  }
+
+  int step = tick_count_ % kDragFrames;
+  float x = kViewportWidth / 2.0f;
+  float y = kViewportHeight * (0.8f - 0.6f * step / (kDragFrames - 1));
+  if (step == 0)
+    DispatchPointerEvent(EVENT_TYPE_POINTER_DOWN, x, y, time);
+  else if (step == kDragFrames - 1)
+    DispatchPointerEvent(EVENT_TYPE_POINTER_UP, x, y, time);
+  else
+    DispatchPointerEvent(EVENT_TYPE_POINTER_MOVE, x, y, time);
+  ++tick_count_;
+}
+
+void FrameBenchmark::DispatchPointerEvent(EventType type,
+                                          float x,
+                                          float y,
+                                          base::TimeTicks time) {
+  InputEventPtr event = InputEvent::New();
+  event->type = type;
+  event->time_stamp = (time - base::TimeTicks()).InMilliseconds();
+  event->pointer_data = PointerData::New();
+  event->pointer_data->pointer = 0;
+  event->pointer_data->kind = POINTER_KIND_TOUCH;
+  event->pointer_data->x = x;
+  event->pointer_data->y = y;
+  event->pointer_data->pressure = 1.0f;
+  event->pointer_data->pressure_max = 1.0f;
+  sky_engine_->OnInputEvent(event.Pass());
+}
+
+void FrameBenchmark::StartReplay() {
+  if (!ReadInputEventRecording(config_.input_path, &recorded_events_)) {
+    LOG(ERROR) << "Failed to read recorded input from "
+               << config_.input_path.value();
+    Done(false);
+    return;
+  }
+  if (recorded_events_.empty()) {
+    ScheduleFinish();
+    return;
+  }
+  for (size_t i = 0; i < recorded_events_.size(); ++i) {
+    base::MessageLoop::current()->PostDelayedTask(
+        FROM_HERE, base::Bind(&FrameBenchmark::DispatchRecordedEvent,
+                              weak_factory_.GetWeakPtr(), i),
+        recorded_events_[i]->offset);
+  }
+}
+
+void FrameBenchmark::DispatchRecordedEvent(size_t index) {
+  InputEventPtr event = recorded_events_[index]->event.Clone();
+  event->time_stamp =
+      (base::TimeTicks::Now() - base::TimeTicks()).InMilliseconds();
+  sky_engine_->OnInputEvent(event.Pass());
+  ++tick_count_;
+  if (index + 1 == recorded_events_.size())
+    ScheduleFinish();
+}
+
+void FrameBenchmark::ScheduleFinish() {
+  VSyncProviderLinux::Shared().set_tick_callback(
+      base::Callback<void(base::TimeTicks)>());
+  base::MessageLoop::current()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&FrameBenchmark::Finish, weak_factory_.GetWeakPtr()),
+      base::TimeDelta::FromMilliseconds(kSettleMilliseconds));
+}
+
+void FrameBenchmark::Finish() {
+  // The engine writes the timings to a file off the UI thread, so have it
+  // write them to a temporary file and add our own numbers once it is done.
+  base::FilePath path;
+  if (!base::CreateTemporaryFile(&path)) {
+    LOG(ERROR) << "Failed to create a file for the frame timings.";
+    Done(false);
+    return;
+  }
+  sky_engine_->DumpFrameTimings(
+      path.value(), base::Bind(&FrameBenchmark::DidDumpFrameTimings,
+                               weak_factory_.GetWeakPtr(), path));
+}
+
+void FrameBenchmark::DidDumpFrameTimings(const base::FilePath& path,
+                                         bool success) {
+  std::string json;
+  bool did_read = success && base::ReadFileToString(path, &json);
+  base::DeleteFile(path, false);
+  if (!did_read) {
+    LOG(ERROR) << "Failed to dump frame timings.";
+    Done(false);
+    return;
+  }
+  Done(WriteResults(json));
+}
+
+bool FrameBenchmark::WriteResults(const std::string& timings_json) {
+  scoped_ptr<base::Value> value = base::JSONReader::Read(timings_json);
+  base::DictionaryValue* results = nullptr;
+  if (!value || !value->GetAsDictionary(&results)) {
+    LOG(ERROR) << "Failed to parse frame timings.";
+    return false;
+  }
+
+  scoped_ptr<base::DictionaryValue> benchmark(new base::DictionaryValue);
+  benchmark->SetString("main", config_.main);
+  if (!config_.input_path.empty())
+    benchmark->SetString("input", config_.input_path.value());
+  benchmark->SetInteger("input_events", tick_count_);
+  benchmark->SetInteger("viewport_width", kViewportWidth);
+  benchmark->SetInteger("viewport_height", kViewportHeight);
+  benchmark->SetString("raster_cache", "software");
+  // The resident set of the whole process, including every engine thread,
+  // the Dart heap and the raster caches. It doesn't break down by stage.
+  benchmark->SetDouble("process_resident_bytes_at_start",
+                       resident_bytes_at_start_);
+  benchmark->SetDouble("process_resident_bytes_at_end",
+                       ProcessResidentBytes());
+  results->Set("benchmark", benchmark.Pass());
+
+  std::string json;
+  if (!base::JSONWriter::WriteWithOptions(
+          *results, base::JSONWriter::OPTIONS_PRETTY_PRINT, &json)) {
+    LOG(ERROR) << "Failed to serialize the results.";
+    return false;
+  }
+  if (config_.output_path.empty()) {
+    std::cout << json << std::endl;
+    return true;
+  }
+  if (base::WriteFile(config_.output_path, json.data(), json.size()) !=
+      static_cast<int>(json.size())) {
+    LOG(ERROR) << "Failed to write " << config_.output_path.value();
+    return false;
+  }
+  return true;
+}
+
+void FrameBenchmark::Done(bool success) {
+  timer_.Stop();
+  VSyncProviderLinux::Shared().set_tick_callback(
+      base::Callback<void(base::TimeTicks)>());
+  weak_factory_.InvalidateWeakPtrs();
+  DoneCallback done = done_;
+  done_.Reset();
+  if (!done.is_null())
+    done.Run(success);
+}
+
+}  // namespace shell
+}  // namespace sky
@@ -0,0 +1,95 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_SHELL_TESTING_FRAME_BENCHMARK_H_
+#define SKY_SHELL_TESTING_FRAME_BENCHMARK_H_
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "sky/services/engine/sky_engine.mojom.h"
+#include "sky/shell/ui/input_event_recorder.h"
+
+namespace sky {
+namespace shell {
+class ShellView;
+
+// Runs a Dart app headless, drawing into an offscreen bitmap, while feeding it
+// either a scripted drag gesture, one event per frame interval, or input
+// recorded with --record-input at its recorded times. With --vsync=virtual the
+// scripted drag advances once per virtual frame instead. When the input is done
+// it writes the engine's frame timings as JSON, with percentiles for each
+// stage and the picture op counts of every frame, and reports whether that
+// worked.
+//
+// There is no GrContext headless, so the raster cache counts in the results
+// are for pictures cached in software.
+class FrameBenchmark {
+ public:
+  typedef base::Callback<void(bool success)> DoneCallback;
+
+  struct Config {
+    Config();
+    ~Config();
+
+    std::string main;
+    std::string package_root;
+    bool is_snapshot;
+
+    // How many frame intervals to feed the scripted drag for.
+    int frame_count;
+    // Recorded input to replay instead of the scripted drag.
+    base::FilePath input_path;
+    // Where to write the results. Empty writes them to stdout.
+    base::FilePath output_path;
+  };
+
+  explicit FrameBenchmark(const Config& config);
+  ~FrameBenchmark();
+
+  // Calls |done| once the results are written, or as soon as the run fails.
+  void Start(const DoneCallback& done);
+
+ private:
+  void Tick();
+  void OnVSyncTick(base::TimeTicks time);
+  void Step(base::TimeTicks time);
+  void DispatchPointerEvent(EventType type,
+                            float x,
+                            float y,
+                            base::TimeTicks time);
+  void StartReplay();
+  void DispatchRecordedEvent(size_t index);
+  void ScheduleFinish();
+  void Finish();
+  void DidDumpFrameTimings(const base::FilePath& path, bool success);
+  bool WriteResults(const std::string& timings_json);
+  void Done(bool success);
+
+  Config config_;
+  DoneCallback done_;
+  scoped_ptr<ShellView> shell_view_;
+  SkyEnginePtr sky_engine_;
+
+  base::RepeatingTimer<FrameBenchmark> timer_;
+  int tick_count_;
+  ScopedVector<RecordedInputEvent> recorded_events_;
+  size_t resident_bytes_at_start_;
+
+  base::WeakPtrFactory<FrameBenchmark> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameBenchmark);
+};
+
+}  // namespace shell
+}  // namespace sky
+
+#endif  // SKY_SHELL_TESTING_FRAME_BENCHMARK_H_
@@ -6,49 +6,118 @@
 
 #include "base/bind.h"
 #include "base/message_loop/message_loop.h"
+#include "base/task_runner_util.h"
 #include "base/trace_event/trace_event.h"
 
 namespace sky {
 namespace shell {
+namespace {
 
-const int kPipelineDepth = 3;
+FrameTiming DrawAndMeasure(base::WeakPtr<GPUDelegate> gpu_delegate,
+                           scoped_ptr<compositor::LayerTree> layer_tree,
+                           FrameTiming timing) {
+  if (!gpu_delegate)
+    return timing;
+  base::TimeTicks start = base::TimeTicks::Now();
+  compositor::PaintContext::FrameStats stats =
+      gpu_delegate->Draw(layer_tree.Pass());
+  timing.stages[kFrameStageRaster] = base::TimeTicks::Now() - start;
+  timing.picture_count = stats.picture_count;
+  timing.cached_picture_count = stats.cached_picture_count;
+  timing.picture_op_count = stats.picture_op_count;
+  return timing;
+}
+
+}  // namespace
+
+const int kMinPipelineDepth = 1;
+const int kDefaultPipelineDepth = 2;
+const int kMaxPipelineDepth = 3;
+
+// Adaptive scheduling waits for this many frames before trusting the timing
+// histograms.
+const size_t kMinFramesForAdaptiveScheduling = 10;
+
+// Slack left between the predicted end of a stage and its deadline.
+const int64_t kFrameDeadlineMarginMicroseconds = 2000;
+
+// The percentile of recent stage durations used to predict the next frame.
+const double kPredictionPercentile = 90;
 
-Animator::Animator(const Engine::Config& config, Engine* engine)
+Animator::Animator(const Engine::Config& config, AnimatorDelegate* delegate)
     : config_(config),
-      engine_(engine),
+      delegate_(delegate),
       outstanding_requests_(0),
       did_defer_frame_request_(false),
       engine_requested_frame_(false),
       paused_(false),
+      awaiting_vsync_(false),
+      pipeline_depth_(kDefaultPipelineDepth),
+      frame_number_(0),
+      pending_frame_deferred_(false),
+      begin_frame_weak_factory_(this),
       weak_factory_(this) {
+  // Virtual vsyncs come as soon as the previous frame is done, so there is no
+  // deadline to schedule against.
+  if (config_.virtual_vsync)
+    config_.adaptive_frame_scheduling = false;
 }
 
 Animator::~Animator() {
 }
 
+void Animator::set_vsync_provider(vsync::VSyncProviderPtr vsync_provider) {
+  vsync_provider_ = vsync_provider.Pass();
+  if (!vsync_provider_)
+    return;
+  vsync_provider_->GetFrameInterval(
+      base::Bind(&Animator::OnFrameInterval, weak_factory_.GetWeakPtr()));
+}
+
+void Animator::OnFrameInterval(int64_t interval) {
+  if (interval > 0) {
+    frame_timing_.set_frame_interval(
+        base::TimeDelta::FromMicroseconds(interval));
+  }
+}
+
 void Animator::RequestFrame() {
   if (engine_requested_frame_)
     return;
   TRACE_EVENT_ASYNC_BEGIN0("sky", "Frame request pending", this);
   engine_requested_frame_ = true;
+  frame_request_time_ = base::TimeTicks::Now();
 
   DCHECK(!did_defer_frame_request_);
   outstanding_requests_++;
-  if (outstanding_requests_ >= kPipelineDepth) {
+  if (outstanding_requests_ > pipeline_depth_) {
     did_defer_frame_request_ = true;
+    pending_frame_deferred_ = true;
     return;
   }
 
   if (!AwaitVSync()) {
     base::MessageLoop::current()->PostTask(
         FROM_HERE,
-        base::Bind(&Animator::BeginFrame, weak_factory_.GetWeakPtr(), 0));
+        base::Bind(&Animator::BeginFrame,
+                   begin_frame_weak_factory_.GetWeakPtr(), 0));
   }
 }
 
 void Animator::Stop() {
   paused_ = true;
+  // Drop the pending frame request. Its BeginFrame may already be posted or
+  // waiting out the BeginFrame delay, so cancel that too. A parked vsync
+  // callback sees that there is no request and does nothing.
+  begin_frame_weak_factory_.InvalidateWeakPtrs();
+  if (!engine_requested_frame_)
+    return;
+  TRACE_EVENT_ASYNC_END0("sky", "Frame request pending", this);
   engine_requested_frame_ = false;
+  did_defer_frame_request_ = false;
+  pending_frame_deferred_ = false;
+  DCHECK(outstanding_requests_ > 0);
+  --outstanding_requests_;
 }
 
 void Animator::Start() {
@@ -62,27 +131,50 @@ void Animator::BeginFrame(int64_t time_stamp) {
   engine_requested_frame_ = false;
 
   DCHECK(outstanding_requests_ > 0);
-  DCHECK(outstanding_requests_ <= kPipelineDepth) << outstanding_requests_;
+  DCHECK(outstanding_requests_ <= kMaxPipelineDepth) << outstanding_requests_;
 
+  base::TimeTicks begin_time = base::TimeTicks::Now();
   base::TimeTicks frame_time = time_stamp ?
-      base::TimeTicks::FromInternalValue(time_stamp) : base::TimeTicks::Now();
+      base::TimeTicks::FromInternalValue(time_stamp) : begin_time;
 
-  engine_->BeginFrame(frame_time);
-  skia::RefPtr<SkPicture> picture = engine_->Paint();
+  FrameTiming timing;
+  timing.frame_number = ++frame_number_;
+  timing.vsync_time = time_stamp ? frame_time : frame_request_time_;
+  if (!config_.virtual_vsync)
+    timing.stages[kFrameStageVSyncLatency] = begin_time - timing.vsync_time;
+  timing.deferred = pending_frame_deferred_;
+  pending_frame_deferred_ = false;
 
-  config_.gpu_task_runner->PostTaskAndReply(
-      FROM_HERE,
-      base::Bind(&GPUDelegate::Draw, config_.gpu_delegate, picture),
+  delegate_->BeginFrame(frame_time);
+  base::TimeTicks build_end_time = base::TimeTicks::Now();
+  timing.stages[kFrameStageBuild] = build_end_time - begin_time;
+
+  scoped_ptr<compositor::LayerTree> layer_tree = delegate_->Paint();
+  timing.stages[kFrameStagePaint] = base::TimeTicks::Now() - build_end_time;
+
+  base::PostTaskAndReplyWithResult(
+      config_.gpu_task_runner.get(), FROM_HERE,
+      base::Bind(&DrawAndMeasure, config_.gpu_delegate,
+                 base::Passed(&layer_tree), timing),
       base::Bind(&Animator::OnFrameComplete, weak_factory_.GetWeakPtr()));
 }
 
-void Animator::OnFrameComplete() {
+void Animator::OnFrameComplete(const FrameTiming& timing) {
+  FrameTiming completed = timing;
+  if (!config_.virtual_vsync) {
+    completed.stages[kFrameStageTotal] =
+        base::TimeTicks::Now() - completed.vsync_time;
+  }
+  frame_timing_.AddFrame(completed);
+  if (config_.adaptive_frame_scheduling)
+    UpdateSchedule();
+
   DCHECK(outstanding_requests_ > 0);
   --outstanding_requests_;
   if (paused_)
     return;
 
-  if (did_defer_frame_request_) {
+  if (did_defer_frame_request_ && outstanding_requests_ <= pipeline_depth_) {
     did_defer_frame_request_ = false;
 
     if (!AwaitVSync())
@@ -93,10 +185,84 @@ void Animator::OnFrameComplete() {
 bool Animator::AwaitVSync() {
   if (!vsync_provider_)
     return false;
+  // The provider takes one callback at a time. One parked before a Stop() and
+  // Start() serves the new request.
+  if (awaiting_vsync_)
+    return true;
+  awaiting_vsync_ = true;
   vsync_provider_->AwaitVSync(
-      base::Bind(&Animator::BeginFrame, weak_factory_.GetWeakPtr()));
+      base::Bind(&Animator::OnVSync, weak_factory_.GetWeakPtr()));
   return true;
 }
 
+void Animator::OnVSync(int64_t time_stamp) {
+  awaiting_vsync_ = false;
+  // The request was dropped by Stop(), or deferred again after a restart.
+  if (!engine_requested_frame_ || did_defer_frame_request_)
+    return;
+
+  if (begin_frame_delay_ <= base::TimeDelta()) {
+    BeginFrame(time_stamp);
+    return;
+  }
+
+  base::TimeTicks vsync_time = base::TimeTicks::FromInternalValue(time_stamp);
+  base::TimeDelta delay =
+      vsync_time + begin_frame_delay_ - base::TimeTicks::Now();
+  if (delay <= base::TimeDelta()) {
+    BeginFrame(time_stamp);
+    return;
+  }
+
+  base::MessageLoop::current()->PostDelayedTask(
+      FROM_HERE,
+      base::Bind(&Animator::BeginFrame, begin_frame_weak_factory_.GetWeakPtr(),
+                 time_stamp),
+      delay);
+}
+
+void Animator::UpdateSchedule() {
+  if (frame_timing_.histogram(kFrameStageTotal).count() <
+      kMinFramesForAdaptiveScheduling)
+    return;
+
+  base::TimeDelta ui_time =
+      frame_timing_.histogram(kFrameStageBuild)
+          .Percentile(kPredictionPercentile) +
+      frame_timing_.histogram(kFrameStagePaint)
+          .Percentile(kPredictionPercentile);
+  base::TimeDelta gpu_time = frame_timing_.histogram(kFrameStageRaster)
+                                 .Percentile(kPredictionPercentile);
+  base::TimeDelta budget =
+      frame_timing_.frame_interval() -
+      base::TimeDelta::FromMicroseconds(kFrameDeadlineMarginMicroseconds);
+
+  int depth;
+  base::TimeDelta delay;
+  if (ui_time + gpu_time <= budget) {
+    // The whole frame fits in one interval. Run the stages back to back and
+    // start late enough that raster finishes just before the next vsync.
+    depth = kMinPipelineDepth;
+    delay = budget - (ui_time + gpu_time);
+  } else if (ui_time <= budget && gpu_time <= budget) {
+    // Each stage fits in an interval on its own, so overlap raster of one
+    // frame with the build of the next and delay the build to end just
+    // before the next vsync.
+    depth = kDefaultPipelineDepth;
+    delay = budget - ui_time;
+  } else {
+    // At least one stage is over budget. Keep the GPU thread fed.
+    depth = kMaxPipelineDepth;
+  }
+
+  if (depth != pipeline_depth_ || delay != begin_frame_delay_) {
+    TRACE_EVENT_INSTANT2("sky", "Animator::UpdateSchedule",
+                         TRACE_EVENT_SCOPE_THREAD, "depth", depth,
+                         "delay_us", delay.InMicroseconds());
+  }
+  pipeline_depth_ = depth;
+  begin_frame_delay_ = delay;
+}
+
 }  // namespace shell
 }  // namespace sky
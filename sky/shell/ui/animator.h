@@ -7,14 +7,16 @@
 
 #include "base/memory/weak_ptr.h"
 #include "sky/services/vsync/vsync.mojom.h"
+#include "sky/shell/ui/animator_delegate.h"
 #include "sky/shell/ui/engine.h"
+#include "sky/shell/ui/frame_timing.h"
 
 namespace sky {
 namespace shell {
 
 class Animator {
  public:
-  explicit Animator(const Engine::Config& config, Engine* engine);
+  Animator(const Engine::Config& config, AnimatorDelegate* delegate);
   ~Animator();
 
   void RequestFrame();
@@ -22,23 +24,49 @@ class Animator {
   void Start();
   void Stop();
 
-  void set_vsync_provider(vsync::VSyncProviderPtr vsync_provider) {
-    vsync_provider_ = vsync_provider.Pass();
-  }
+  // Also asks |vsync_provider| for the frame interval that frame timings and
+  // adaptive scheduling are measured against.
+  void set_vsync_provider(vsync::VSyncProviderPtr vsync_provider);
+
+  const FrameTimingRecorder& frame_timing() const { return frame_timing_; }
 
  private:
+  void OnVSync(int64_t time_stamp);
+  void OnFrameInterval(int64_t interval);
   void BeginFrame(int64_t time_stamp);
-  void OnFrameComplete();
+  void OnFrameComplete(const FrameTiming& timing);
   bool AwaitVSync();
 
+  // Picks the pipeline depth and BeginFrame delay from recent frame timings.
+  // Only used when adaptive frame scheduling is enabled.
+  void UpdateSchedule();
+
   Engine::Config config_;
-  Engine* engine_;
+  AnimatorDelegate* delegate_;
   vsync::VSyncProviderPtr vsync_provider_;
   int outstanding_requests_;
   bool did_defer_frame_request_;
   bool engine_requested_frame_;
   bool paused_;
+  bool awaiting_vsync_;
+
+  // The maximum number of frames that can be between BeginFrame and the end
+  // of raster at any one time.
+  int pipeline_depth_;
+  // How long to wait after vsync before starting BeginFrame so that the frame
+  // finishes just ahead of its deadline.
+  base::TimeDelta begin_frame_delay_;
+
+  FrameTimingRecorder frame_timing_;
+  int64_t frame_number_;
+  // When the pending frame was requested, used to measure frame latency when
+  // there is no vsync time stamp.
+  base::TimeTicks frame_request_time_;
+  bool pending_frame_deferred_;
 
+  // Vends the weak pointers bound into posted BeginFrame tasks, so that
+  // Stop() can cancel them.
+  base::WeakPtrFactory<Animator> begin_frame_weak_factory_;
   base::WeakPtrFactory<Animator> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(Animator);
@@ -0,0 +1,28 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_SHELL_UI_ANIMATOR_DELEGATE_H_
+#define SKY_SHELL_UI_ANIMATOR_DELEGATE_H_
+
+#include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
+#include "sky/compositor/layer_tree.h"
+
+namespace sky {
+namespace shell {
+
+// Builds the frames that the Animator schedules. Implemented by Engine.
+class AnimatorDelegate {
+ public:
+  virtual void BeginFrame(base::TimeTicks frame_time) = 0;
+  virtual scoped_ptr<compositor::LayerTree> Paint() = 0;
+
+ protected:
+  virtual ~AnimatorDelegate() {}
+};
+
+}  // namespace shell
+}  // namespace sky
+
+#endif  // SKY_SHELL_UI_ANIMATOR_DELEGATE_H_
@@ -0,0 +1,197 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/shell/ui/animator.h"
+
+#include <vector>
+
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "mojo/common/message_pump_mojo.h"
+#include "mojo/public/cpp/bindings/binding.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace sky {
+namespace shell {
+namespace {
+
+const int64_t kFrameIntervalMicroseconds = 8333;
+
+class FakeAnimatorDelegate : public AnimatorDelegate {
+ public:
+  FakeAnimatorDelegate() : begin_frame_count_(0) {}
+  ~FakeAnimatorDelegate() override {}
+
+  int begin_frame_count() const { return begin_frame_count_; }
+
+  // AnimatorDelegate implementation:
+  void BeginFrame(base::TimeTicks frame_time) override { ++begin_frame_count_; }
+  scoped_ptr<compositor::LayerTree> Paint() override {
+    return make_scoped_ptr(new compositor::LayerTree());
+  }
+
+ private:
+  int begin_frame_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeAnimatorDelegate);
+};
+
+// Parks AwaitVSync callbacks until the test calls Tick().
+class FakeVSyncProvider : public vsync::VSyncProvider {
+ public:
+  explicit FakeVSyncProvider(
+      mojo::InterfaceRequest<vsync::VSyncProvider> request)
+      : binding_(this, request.Pass()) {}
+  ~FakeVSyncProvider() override {}
+
+  size_t parked_callback_count() const { return callbacks_.size(); }
+
+  void Tick() {
+    std::vector<AwaitVSyncCallback> callbacks;
+    callbacks.swap(callbacks_);
+    for (const auto& callback : callbacks)
+      callback.Run(base::TimeTicks::Now().ToInternalValue());
+  }
+
+  // vsync::VSyncProvider implementation:
+  void AwaitVSync(const AwaitVSyncCallback& callback) override {
+    callbacks_.push_back(callback);
+  }
+  void GetFrameInterval(const GetFrameIntervalCallback& callback) override {
+    callback.Run(kFrameIntervalMicroseconds);
+  }
+
+ private:
+  mojo::Binding<vsync::VSyncProvider> binding_;
+  std::vector<AwaitVSyncCallback> callbacks_;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeVSyncProvider);
+};
+
+class AnimatorTest : public testing::Test {
+ protected:
+  AnimatorTest() : loop_(mojo::common::MessagePumpMojo::Create()) {
+    // With no GPU delegate raster is skipped, so the whole pipeline runs on
+    // the test's message loop.
+    config_.gpu_task_runner = loop_.task_runner();
+  }
+
+  void CreateAnimator(bool with_vsync_provider) {
+    animator_.reset(new Animator(config_, &delegate_));
+    if (!with_vsync_provider)
+      return;
+    vsync::VSyncProviderPtr vsync_provider;
+    vsync_provider_.reset(
+        new FakeVSyncProvider(mojo::GetProxy(&vsync_provider)));
+    animator_->set_vsync_provider(vsync_provider.Pass());
+  }
+
+  // Requests a frame and runs it to completion.
+  void RunFrame() {
+    animator_->RequestFrame();
+    loop_.RunUntilIdle();
+    if (vsync_provider_) {
+      vsync_provider_->Tick();
+      loop_.RunUntilIdle();
+    }
+  }
+
+  void RunFor(base::TimeDelta delay) {
+    base::RunLoop run_loop;
+    loop_.task_runner()->PostDelayedTask(FROM_HERE, run_loop.QuitClosure(),
+                                        delay);
+    run_loop.Run();
+  }
+
+  base::MessageLoop loop_;
+  Engine::Config config_;
+  FakeAnimatorDelegate delegate_;
+  scoped_ptr<FakeVSyncProvider> vsync_provider_;
+  scoped_ptr<Animator> animator_;
+};
+
+TEST_F(AnimatorTest, RunsRequestedFrame) {
+  CreateAnimator(false);
+  RunFrame();
+  EXPECT_EQ(1, delegate_.begin_frame_count());
+  EXPECT_EQ(1, animator_->frame_timing().frame_count());
+}
+
+TEST_F(AnimatorTest, StopCancelsPostedBeginFrame) {
+  CreateAnimator(false);
+  animator_->RequestFrame();
+  animator_->Stop();
+  loop_.RunUntilIdle();
+  EXPECT_EQ(0, delegate_.begin_frame_count());
+
+  animator_->Start();
+  loop_.RunUntilIdle();
+  EXPECT_EQ(1, delegate_.begin_frame_count());
+}
+
+TEST_F(AnimatorTest, StopIgnoresParkedVSync) {
+  CreateAnimator(true);
+  animator_->RequestFrame();
+  loop_.RunUntilIdle();
+  ASSERT_EQ(1u, vsync_provider_->parked_callback_count());
+
+  animator_->Stop();
+  vsync_provider_->Tick();
+  loop_.RunUntilIdle();
+  EXPECT_EQ(0, delegate_.begin_frame_count());
+
+  RunFrame();
+  EXPECT_EQ(1, delegate_.begin_frame_count());
+}
+
+TEST_F(AnimatorTest, RestartReusesParkedVSync) {
+  CreateAnimator(true);
+  animator_->RequestFrame();
+  loop_.RunUntilIdle();
+  animator_->Stop();
+  animator_->Start();
+  loop_.RunUntilIdle();
+  // The provider only takes one callback at a time.
+  EXPECT_EQ(1u, vsync_provider_->parked_callback_count());
+
+  vsync_provider_->Tick();
+  loop_.RunUntilIdle();
+  EXPECT_EQ(1, delegate_.begin_frame_count());
+}
+
+TEST_F(AnimatorTest, StopCancelsDelayedBeginFrame) {
+  config_.adaptive_frame_scheduling = true;
+  CreateAnimator(true);
+  // The fake frames take no time at all, so once there are enough timings
+  // the Animator delays BeginFrame until just before the deadline.
+  const int kWarmUpFrames = 10;
+  for (int i = 0; i < kWarmUpFrames; ++i)
+    RunFrame();
+  ASSERT_EQ(kWarmUpFrames, delegate_.begin_frame_count());
+
+  base::TimeDelta wait =
+      base::TimeDelta::FromMicroseconds(3 * kFrameIntervalMicroseconds);
+  RunFrame();
+  EXPECT_EQ(kWarmUpFrames, delegate_.begin_frame_count());
+  animator_->Stop();
+  RunFor(wait);
+  EXPECT_EQ(kWarmUpFrames, delegate_.begin_frame_count());
+
+  animator_->Start();
+  loop_.RunUntilIdle();
+  vsync_provider_->Tick();
+  RunFor(wait);
+  EXPECT_EQ(kWarmUpFrames + 1, delegate_.begin_frame_count());
+}
+
+TEST_F(AnimatorTest, UsesFrameIntervalFromVSyncProvider) {
+  CreateAnimator(true);
+  loop_.RunUntilIdle();
+  EXPECT_EQ(base::TimeDelta::FromMicroseconds(kFrameIntervalMicroseconds),
+            animator_->frame_timing().frame_interval());
+}
+
+}  // namespace
+}  // namespace shell
+}  // namespace sky
@@ -6,11 +6,13 @@
 
 #include "base/bind.h"
 #include "base/files/file_path.h"
+#include "base/task_runner_util.h"
 #include "base/threading/worker_pool.h"
 #include "base/trace_event/trace_event.h"
 #include "mojo/common/data_pipe_utils.h"
 #include "mojo/public/cpp/application/connect.h"
-#include "services/asset_bundle/asset_unpacker_job.h"
+#include "services/asset_bundle/zip_asset_bundle.h"
+#include "sky/compositor/picture_layer.h"
 #include "sky/engine/public/platform/WebInputEvent.h"
 #include "sky/engine/public/platform/sky_display_metrics.h"
 #include "sky/engine/public/platform/sky_display_metrics.h"
@@ -22,8 +24,6 @@
 #include "sky/shell/ui/input_event_converter.h"
 #include "sky/shell/ui/internals.h"
 #include "sky/shell/ui/platform_impl.h"
-#include "third_party/skia/include/core/SkCanvas.h"
-#include "third_party/skia/include/core/SkPictureRecorder.h"
 
 namespace sky {
 namespace shell {
@@ -35,6 +35,11 @@ namespace {
 void Ignored(bool) {
 }
 
+void DidDumpFrameTimings(const Engine::DumpFrameTimingsCallback& callback,
+                         bool success) {
+  callback.Run(success);
+}
+
 mojo::ScopedDataPipeConsumerHandle Fetch(const base::FilePath& path) {
   mojo::DataPipe pipe;
   auto runner = base::WorkerPool::GetTaskRunner(true);
@@ -47,9 +52,12 @@ PlatformImpl* g_platform_impl = nullptr;
 
 }  // namespace
 
-using mojo::asset_bundle::AssetUnpackerJob;
+using mojo::asset_bundle::ZipAssetBundle;
 
-Engine::Config::Config() {
+Engine::Config::Config()
+    : service_provider_context(nullptr),
+      adaptive_frame_scheduling(false),
+      virtual_vsync(false) {
 }
 
 Engine::Config::~Config() {
@@ -66,12 +74,23 @@ Engine::Engine(const Config& config)
       CreateServiceProvider(config.service_provider_context);
   mojo::ConnectToService(service_provider.get(), &network_service_);
 
-#if defined(OS_ANDROID)
-  // TODO(abarth): Implement VSyncProvider on other platforms.
+#if defined(OS_ANDROID) || defined(OS_LINUX)
   vsync::VSyncProviderPtr vsync_provider;
   mojo::ConnectToService(service_provider.get(), &vsync_provider);
   animator_->set_vsync_provider(vsync_provider.Pass());
 #endif
+
+  if (!config.dart_snapshot_cache_path.empty()) {
+    dart_snapshot_cache_.reset(new blink::DartSnapshotCache(
+        config.dart_snapshot_cache_path, blink::dartBuildIdentity(),
+        blink::DartSnapshotCache::kDefaultMaxSizeInBytes,
+        base::WorkerPool::GetTaskRunner(true)));
+  }
+
+  if (!config.input_event_recording_path.empty()) {
+    input_event_recorder_.reset(
+        new InputEventRecorder(config.input_event_recording_path));
+  }
 }
 
 Engine::~Engine() {
@@ -92,29 +111,38 @@ void Engine::Init() {
 void Engine::BeginFrame(base::TimeTicks frame_time) {
   TRACE_EVENT0("sky", "Engine::BeginFrame");
 
+  DispatchPendingInputEvents();
   if (sky_view_)
     sky_view_->BeginFrame(frame_time);
 }
 
-skia::RefPtr<SkPicture> Engine::Paint() {
+scoped_ptr<compositor::LayerTree> Engine::Paint() {
   TRACE_EVENT0("sky", "Engine::Paint");
 
-  SkRTreeFactory factory;
-  SkPictureRecorder recorder;
-  auto canvas = skia::SharePtr(recorder.beginRecording(
-      physical_size_.width(), physical_size_.height(), &factory,
-      SkPictureRecorder::kComputeSaveLayerInfo_RecordFlag));
+  scoped_ptr<compositor::LayerTree> layer_tree(new compositor::LayerTree());
+  layer_tree->set_frame_size(
+      SkISize::Make(physical_size_.width(), physical_size_.height()));
 
-  if (sky_view_) {
+  if (!sky_view_)
+    return layer_tree.Pass();
+
+  std::shared_ptr<compositor::Layer> root = sky_view_->GetRootLayer();
+  if (!root) {
     skia::RefPtr<SkPicture> picture = sky_view_->Paint();
-    canvas->clear(SK_ColorBLACK);
-    canvas->scale(display_metrics_.device_pixel_ratio,
-                  display_metrics_.device_pixel_ratio);
-    if (picture)
-      canvas->drawPicture(picture.get());
+    if (!picture)
+      return layer_tree.Pass();
+    std::unique_ptr<compositor::PictureLayer> picture_layer(
+        new compositor::PictureLayer());
+    picture_layer->set_picture(picture);
+    root = std::move(picture_layer);
   }
 
-  return skia::AdoptRef(recorder.endRecordingAsPicture());
+  layer_tree->set_root_transform(
+      SkMatrix::MakeScale(display_metrics_.device_pixel_ratio,
+                          display_metrics_.device_pixel_ratio));
+  layer_tree->set_root_layer(std::move(root));
+
+  return layer_tree.Pass();
 }
 
 void Engine::ConnectToEngine(mojo::InterfaceRequest<SkyEngine> request) {
@@ -155,18 +183,40 @@ void Engine::OnViewportMetricsChanged(ViewportMetricsPtr metrics) {
 
 void Engine::OnInputEvent(InputEventPtr event) {
   TRACE_EVENT0("sky", "Engine::OnInputEvent");
+  if (input_event_recorder_)
+    input_event_recorder_->Record(*event);
+
   scoped_ptr<blink::WebInputEvent> web_event =
       ConvertEvent(event, display_metrics_.device_pixel_ratio);
-  if (!web_event)
+  if (!web_event || !sky_view_)
     return;
-  if (sky_view_)
-    sky_view_->HandleInputEvent(*web_event);
+
+  // Events are dispatched together right before the next frame, so that
+  // several pointer moves in one frame cost a single dispatch.
+  input_event_queue_.Push(web_event.Pass());
+  if (input_event_queue_.full()) {
+    DispatchPendingInputEvents();
+    return;
+  }
+  ScheduleFrame();
+}
+
+void Engine::DispatchPendingInputEvents() {
+  if (input_event_queue_.empty())
+    return;
+  TRACE_EVENT0("sky", "Engine::DispatchPendingInputEvents");
+  ScopedVector<blink::WebInputEvent> events = input_event_queue_.Take();
+  if (!sky_view_)
+    return;
+  for (blink::WebInputEvent* event : events)
+    sky_view_->HandleInputEvent(*event);
 }
 
 void Engine::RunFromLibrary(const std::string& name) {
   sky_view_ = blink::SkyView::Create(this);
   sky_view_->RunFromLibrary(blink::WebString::fromUTF8(name),
-                            dart_library_provider_.get());
+                            dart_library_provider_.get(),
+                            dart_snapshot_cache_.get());
   sky_view_->SetDisplayMetrics(display_metrics_);
 }
 
@@ -198,10 +248,10 @@ void Engine::RunFromSnapshot(const mojo::String& path) {
 }
 
 void Engine::RunFromBundle(const mojo::String& path) {
-  AssetUnpackerJob* unpacker = new AssetUnpackerJob(
-      mojo::GetProxy(&root_bundle_), base::WorkerPool::GetTaskRunner(true));
   std::string path_str = path;
-  unpacker->Unpack(Fetch(base::FilePath(path_str)));
+  // Owned by its binding to |root_bundle_|.
+  new ZipAssetBundle(mojo::GetProxy(&root_bundle_), base::FilePath(path_str),
+                     base::WorkerPool::GetTaskRunner(true));
   root_bundle_->GetAsStream(kSnapshotKey,
                             base::Bind(&Engine::RunFromSnapshotStream,
                                        weak_factory_.GetWeakPtr(), path_str));
@@ -217,6 +267,38 @@ void Engine::OnActivityResumed() {
   StartAnimatorIfPossible();
 }
 
+void Engine::GetFrameTimingStats(
+    const GetFrameTimingStatsCallback& callback) {
+  const FrameTimingRecorder& recorder = animator_->frame_timing();
+  FrameTimingStatsPtr stats = FrameTimingStats::New();
+  stats->frame_count = recorder.frame_count();
+  stats->deferred_frame_count = recorder.deferred_frame_count();
+  stats->dropped_frame_count = recorder.dropped_frame_count();
+  stats->stages = mojo::Array<FrameStageTimingPtr>::New(kFrameStageCount);
+  for (int i = 0; i < kFrameStageCount; ++i) {
+    FrameStage stage = static_cast<FrameStage>(i);
+    const FrameStageHistogram& histogram = recorder.histogram(stage);
+    FrameStageTimingPtr timing = FrameStageTiming::New();
+    timing->stage = FrameStageName(stage);
+    timing->p50_ms = histogram.Percentile(50).InMillisecondsF();
+    timing->p90_ms = histogram.Percentile(90).InMillisecondsF();
+    timing->p99_ms = histogram.Percentile(99).InMillisecondsF();
+    timing->max_ms = histogram.Max().InMillisecondsF();
+    stats->stages[i] = timing.Pass();
+  }
+  callback.Run(stats.Pass());
+}
+
+void Engine::DumpFrameTimings(const mojo::String& path,
+                              const DumpFrameTimingsCallback& callback) {
+  std::string path_str = path;
+  base::PostTaskAndReplyWithResult(
+      base::WorkerPool::GetTaskRunner(true).get(), FROM_HERE,
+      base::Bind(&FrameTimingRecorder::WriteJSONToFile,
+                 base::FilePath(path_str), animator_->frame_timing().ToJSON()),
+      base::Bind(&DidDumpFrameTimings, callback));
+}
+
 void Engine::DidCreateIsolate(Dart_Isolate isolate) {
   Internals::Create(isolate,
                     CreateServiceProvider(config_.service_provider_context),
@@ -5,6 +5,7 @@
 #ifndef SKY_SHELL_UI_ENGINE_H_
 #define SKY_SHELL_UI_ENGINE_H_
 
+#include "base/files/file_path.h"
 #include "base/macros.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -16,13 +17,17 @@
 #include "mojo/services/navigation/public/interfaces/navigation.mojom.h"
 #include "mojo/services/network/public/interfaces/network_service.mojom.h"
 #include "skia/ext/refptr.h"
+#include "sky/compositor/layer_tree.h"
 #include "sky/engine/public/platform/ServiceProvider.h"
 #include "sky/engine/public/sky/sky_view.h"
 #include "sky/engine/public/sky/sky_view_client.h"
+#include "sky/engine/tonic/dart_snapshot_cache.h"
 #include "sky/shell/gpu_delegate.h"
 #include "sky/shell/service_provider.h"
+#include "sky/shell/ui/animator_delegate.h"
+#include "sky/shell/ui/input_event_queue.h"
+#include "sky/shell/ui/input_event_recorder.h"
 #include "sky/shell/ui_delegate.h"
-#include "third_party/skia/include/core/SkPicture.h"
 #include "ui/gfx/geometry/size.h"
 
 namespace sky {
@@ -31,6 +36,7 @@ namespace shell {
 class Animator;
 
 class Engine : public UIDelegate,
+               public AnimatorDelegate,
                public SkyEngine,
                public blink::ServiceProvider,
                public mojo::NavigatorHost,
@@ -44,6 +50,23 @@ class Engine : public UIDelegate,
 
     base::WeakPtr<GPUDelegate> gpu_delegate;
     scoped_refptr<base::SingleThreadTaskRunner> gpu_task_runner;
+
+    // Let the Animator choose pipeline depth and BeginFrame start time from
+    // recent frame timings instead of using a fixed pipeline depth.
+    bool adaptive_frame_scheduling;
+
+    // The vsync time stamps come from a virtual clock that doesn't follow real
+    // time. Disables adaptive scheduling and the stage timings measured
+    // against the time stamps.
+    bool virtual_vsync;
+
+    // Where to cache snapshots of Dart programs run from source. Empty
+    // disables the cache.
+    base::FilePath dart_snapshot_cache_path;
+
+    // Where to record the input events the engine receives. Empty disables
+    // recording.
+    base::FilePath input_event_recording_path;
   };
 
   explicit Engine(const Config& config);
@@ -53,8 +76,9 @@ class Engine : public UIDelegate,
 
   static void Init();
 
-  void BeginFrame(base::TimeTicks frame_time);
-  skia::RefPtr<SkPicture> Paint();
+  // AnimatorDelegate implementation:
+  void BeginFrame(base::TimeTicks frame_time) override;
+  scoped_ptr<compositor::LayerTree> Paint() override;
 
  private:
   // UIDelegate implementation:
@@ -75,6 +99,11 @@ class Engine : public UIDelegate,
   void OnActivityPaused() override;
   void OnActivityResumed() override;
 
+  void GetFrameTimingStats(
+      const GetFrameTimingStatsCallback& callback) override;
+  void DumpFrameTimings(const mojo::String& path,
+                        const DumpFrameTimingsCallback& callback) override;
+
   // SkyViewClient methods:
   void ScheduleFrame() override;
   void DidCreateIsolate(Dart_Isolate isolate) override;
@@ -95,14 +124,20 @@ class Engine : public UIDelegate,
   void StopAnimator();
   void StartAnimatorIfPossible();
 
+  void DispatchPendingInputEvents();
+
   Config config_;
   scoped_ptr<Animator> animator_;
 
   mojo::NetworkServicePtr network_service_;
   mojo::asset_bundle::AssetBundlePtr root_bundle_;
   scoped_ptr<blink::DartLibraryProvider> dart_library_provider_;
+  std::unique_ptr<blink::DartSnapshotCache> dart_snapshot_cache_;
   std::unique_ptr<blink::SkyView> sky_view_;
 
+  InputEventQueue input_event_queue_;
+  scoped_ptr<InputEventRecorder> input_event_recorder_;
+
   gfx::Size physical_size_;
   blink::SkyDisplayMetrics display_metrics_;
   mojo::Binding<SkyEngine> binding_;
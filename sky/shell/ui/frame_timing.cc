@@ -0,0 +1,226 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/shell/ui/frame_timing.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/files/file_util.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/values.h"
+
+namespace sky {
+namespace shell {
+namespace {
+
+// Buckets are kBucketSizeMicroseconds wide, with the last bucket collecting
+// everything beyond kBucketCount * kBucketSizeMicroseconds.
+const int64_t kBucketSizeMicroseconds = 250;
+const size_t kBucketCount = 400;
+
+const int64_t kDefaultFrameIntervalMicroseconds = 16667;
+
+const char* const kStageNames[kFrameStageCount] = {
+    "vsync_latency", "build", "paint", "raster", "total",
+};
+
+double ToMilliseconds(base::TimeDelta delta) {
+  return delta.InMillisecondsF();
+}
+
+}  // namespace
+
+const char* FrameStageName(FrameStage stage) {
+  return kStageNames[stage];
+}
+
+FrameTiming::FrameTiming()
+    : frame_number(0),
+      deferred(false),
+      picture_count(0),
+      cached_picture_count(0),
+      picture_op_count(0),
+      dropped_vsync_count(0) {
+}
+
+FrameStageHistogram::FrameStageHistogram()
+    : buckets_(kBucketCount + 1, 0), count_(0) {
+}
+
+FrameStageHistogram::~FrameStageHistogram() {
+}
+
+void FrameStageHistogram::Add(base::TimeDelta sample) {
+  ++buckets_[BucketFor(sample)];
+  ++count_;
+}
+
+void FrameStageHistogram::Remove(base::TimeDelta sample) {
+  size_t bucket = BucketFor(sample);
+  DCHECK(buckets_[bucket] > 0);
+  --buckets_[bucket];
+  --count_;
+}
+
+base::TimeDelta FrameStageHistogram::Percentile(double percentile) const {
+  if (!count_)
+    return base::TimeDelta();
+  size_t target = std::max<size_t>(
+      1, static_cast<size_t>(std::ceil(count_ * percentile / 100)));
+  size_t seen = 0;
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    seen += buckets_[i];
+    if (seen >= target)
+      return BucketUpperBound(i);
+  }
+  return BucketUpperBound(buckets_.size() - 1);
+}
+
+base::TimeDelta FrameStageHistogram::Max() const {
+  for (size_t i = buckets_.size(); i > 0; --i) {
+    if (buckets_[i - 1])
+      return BucketUpperBound(i - 1);
+  }
+  return base::TimeDelta();
+}
+
+size_t FrameStageHistogram::BucketFor(base::TimeDelta sample) {
+  int64_t micros = std::max<int64_t>(0, sample.InMicroseconds());
+  return std::min<size_t>(micros / kBucketSizeMicroseconds, kBucketCount);
+}
+
+base::TimeDelta FrameStageHistogram::BucketUpperBound(size_t bucket) {
+  return base::TimeDelta::FromMicroseconds((bucket + 1) *
+                                           kBucketSizeMicroseconds);
+}
+
+const size_t FrameTimingRecorder::kMaxFrames;
+
+FrameTimingRecorder::FrameTimingRecorder()
+    : next_index_(0),
+      frame_interval_(
+          base::TimeDelta::FromMicroseconds(kDefaultFrameIntervalMicroseconds)),
+      frame_count_(0),
+      deferred_frame_count_(0),
+      dropped_frame_count_(0) {
+  frames_.reserve(kMaxFrames);
+}
+
+FrameTimingRecorder::~FrameTimingRecorder() {
+}
+
+void FrameTimingRecorder::AddFrame(const FrameTiming& frame) {
+  FrameTiming timing = frame;
+  timing.dropped_vsync_count = CountDroppedVSyncs(timing);
+  last_presentation_time_ =
+      std::max(last_presentation_time_,
+               timing.vsync_time + timing.stages[kFrameStageTotal]);
+
+  if (frames_.size() < kMaxFrames) {
+    frames_.push_back(timing);
+  } else {
+    const FrameTiming& evicted = frames_[next_index_];
+    for (int i = 0; i < kFrameStageCount; ++i)
+      histograms_[i].Remove(evicted.stages[i]);
+    frames_[next_index_] = timing;
+  }
+  next_index_ = (next_index_ + 1) % kMaxFrames;
+
+  for (int i = 0; i < kFrameStageCount; ++i)
+    histograms_[i].Add(timing.stages[i]);
+
+  ++frame_count_;
+  if (timing.deferred)
+    ++deferred_frame_count_;
+  dropped_frame_count_ += timing.dropped_vsync_count;
+}
+
+int FrameTimingRecorder::CountDroppedVSyncs(const FrameTiming& timing) const {
+  // With pipelining a frame normally takes more than one interval from vsync
+  // to the end of raster, so its own latency says nothing about whether the
+  // display missed an update. What matters is the gap since the previous frame
+  // was presented. If this frame started before that, frames were being
+  // produced back to back and every extra interval in the gap is a missed
+  // vsync. Otherwise the UI was idle in between, and only the time since this
+  // frame's own vsync counts.
+  base::TimeTicks presentation_time =
+      timing.vsync_time + timing.stages[kFrameStageTotal];
+  base::TimeTicks start = timing.vsync_time;
+  if (!last_presentation_time_.is_null() &&
+      last_presentation_time_ >= timing.vsync_time)
+    start = last_presentation_time_;
+  int64_t intervals = (presentation_time - start) / frame_interval_;
+  return static_cast<int>(std::max<int64_t>(0, intervals - 1));
+}
+
+std::vector<FrameTiming> FrameTimingRecorder::GetRecentFrames() const {
+  if (frames_.size() < kMaxFrames)
+    return frames_;
+  std::vector<FrameTiming> result;
+  result.reserve(frames_.size());
+  result.insert(result.end(), frames_.begin() + next_index_, frames_.end());
+  result.insert(result.end(), frames_.begin(), frames_.begin() + next_index_);
+  return result;
+}
+
+scoped_ptr<base::DictionaryValue> FrameTimingRecorder::ToValue() const {
+  scoped_ptr<base::DictionaryValue> result(new base::DictionaryValue);
+  result->SetDouble("frame_interval_ms", ToMilliseconds(frame_interval_));
+  result->SetDouble("frame_count", frame_count_);
+  result->SetDouble("deferred_frame_count", deferred_frame_count_);
+  result->SetDouble("dropped_frame_count", dropped_frame_count_);
+
+  scoped_ptr<base::DictionaryValue> histograms(new base::DictionaryValue);
+  for (int i = 0; i < kFrameStageCount; ++i) {
+    FrameStage stage_id = static_cast<FrameStage>(i);
+    const FrameStageHistogram& histogram = histograms_[i];
+    scoped_ptr<base::DictionaryValue> stage(new base::DictionaryValue);
+    stage->SetDouble("p50_ms", ToMilliseconds(histogram.Percentile(50)));
+    stage->SetDouble("p90_ms", ToMilliseconds(histogram.Percentile(90)));
+    stage->SetDouble("p99_ms", ToMilliseconds(histogram.Percentile(99)));
+    stage->SetDouble("max_ms", ToMilliseconds(histogram.Max()));
+    histograms->Set(FrameStageName(stage_id), stage.Pass());
+  }
+  result->Set("histograms", histograms.Pass());
+
+  scoped_ptr<base::ListValue> frames(new base::ListValue);
+  for (const FrameTiming& timing : GetRecentFrames()) {
+    scoped_ptr<base::DictionaryValue> frame(new base::DictionaryValue);
+    frame->SetDouble("frame_number", timing.frame_number);
+    frame->SetBoolean("deferred", timing.deferred);
+    frame->SetInteger("dropped_vsync_count", timing.dropped_vsync_count);
+    frame->SetInteger("picture_count", timing.picture_count);
+    frame->SetInteger("cached_picture_count", timing.cached_picture_count);
+    frame->SetInteger("picture_op_count", timing.picture_op_count);
+    for (int i = 0; i < kFrameStageCount; ++i) {
+      std::string key = FrameStageName(static_cast<FrameStage>(i));
+      frame->SetDouble(key + "_ms", ToMilliseconds(timing.stages[i]));
+    }
+    frames->Append(frame.Pass());
+  }
+  result->Set("frames", frames.Pass());
+
+  return result.Pass();
+}
+
+std::string FrameTimingRecorder::ToJSON() const {
+  std::string json;
+  base::JSONWriter::WriteWithOptions(
+      *ToValue(), base::JSONWriter::OPTIONS_PRETTY_PRINT, &json);
+  return json;
+}
+
+// static
+bool FrameTimingRecorder::WriteJSONToFile(const base::FilePath& path,
+                                          const std::string& json) {
+  if (json.empty())
+    return false;
+  return base::WriteFile(path, json.data(), json.size()) ==
+         static_cast<int>(json.size());
+}
+
+}  // namespace shell
+}  // namespace sky
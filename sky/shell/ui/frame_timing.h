@@ -0,0 +1,136 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_SHELL_UI_FRAME_TIMING_H_
+#define SKY_SHELL_UI_FRAME_TIMING_H_
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
+
+namespace base {
+class DictionaryValue;
+}
+
+namespace sky {
+namespace shell {
+
+// The stages of the frame pipeline that FrameTimingRecorder tracks.
+enum FrameStage {
+  kFrameStageVSyncLatency,  // VSync (or frame request) to BeginFrame.
+  kFrameStageBuild,         // Engine::BeginFrame.
+  kFrameStagePaint,         // Engine::Paint.
+  kFrameStageRaster,        // GPUDelegate::Draw on the GPU thread.
+  kFrameStageTotal,         // VSync to the end of raster.
+  kFrameStageCount,
+};
+
+const char* FrameStageName(FrameStage stage);
+
+struct FrameTiming {
+  FrameTiming();
+
+  int64_t frame_number;
+  base::TimeTicks vsync_time;
+  base::TimeDelta stages[kFrameStageCount];
+  // True if the frame request was held back by pipeline depth throttling.
+  bool deferred;
+  // What raster drew.
+  int picture_count;
+  int cached_picture_count;
+  int picture_op_count;
+  // How many vsyncs went by without a new frame before this one was
+  // presented. Filled in by FrameTimingRecorder::AddFrame.
+  int dropped_vsync_count;
+};
+
+// A fixed-bucket histogram of stage durations that supports removing samples,
+// so that it can summarize a sliding window of frames.
+class FrameStageHistogram {
+ public:
+  FrameStageHistogram();
+  ~FrameStageHistogram();
+
+  void Add(base::TimeDelta sample);
+  void Remove(base::TimeDelta sample);
+
+  size_t count() const { return count_; }
+
+  // |percentile| is in the range [0, 100]. Returns the upper bound of the
+  // bucket containing the percentile.
+  base::TimeDelta Percentile(double percentile) const;
+  base::TimeDelta Max() const;
+
+ private:
+  static size_t BucketFor(base::TimeDelta sample);
+  static base::TimeDelta BucketUpperBound(size_t bucket);
+
+  std::vector<size_t> buckets_;
+  size_t count_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameStageHistogram);
+};
+
+// Records per-frame timings into a ring buffer and keeps rolling histograms
+// of each stage over the frames in the buffer. Lives on the UI thread.
+class FrameTimingRecorder {
+ public:
+  static const size_t kMaxFrames = 240;
+
+  FrameTimingRecorder();
+  ~FrameTimingRecorder();
+
+  base::TimeDelta frame_interval() const { return frame_interval_; }
+  void set_frame_interval(base::TimeDelta interval) {
+    frame_interval_ = interval;
+  }
+
+  void AddFrame(const FrameTiming& timing);
+
+  const FrameStageHistogram& histogram(FrameStage stage) const {
+    return histograms_[stage];
+  }
+
+  int64_t frame_count() const { return frame_count_; }
+  int64_t deferred_frame_count() const { return deferred_frame_count_; }
+  // The number of vsyncs that went by without a new frame while frames were
+  // being produced.
+  int64_t dropped_frame_count() const { return dropped_frame_count_; }
+
+  // Frames in the ring buffer, oldest first.
+  std::vector<FrameTiming> GetRecentFrames() const;
+
+  scoped_ptr<base::DictionaryValue> ToValue() const;
+  std::string ToJSON() const;
+
+  // Writes JSON from ToJSON() to |path|. Blocks, so call it on a thread that
+  // allows IO.
+  static bool WriteJSONToFile(const base::FilePath& path,
+                              const std::string& json);
+
+ private:
+  int CountDroppedVSyncs(const FrameTiming& timing) const;
+
+  std::vector<FrameTiming> frames_;
+  size_t next_index_;
+  FrameStageHistogram histograms_[kFrameStageCount];
+
+  base::TimeDelta frame_interval_;
+  // When the most recent frame finished raster. Null before the first frame.
+  base::TimeTicks last_presentation_time_;
+  int64_t frame_count_;
+  int64_t deferred_frame_count_;
+  int64_t dropped_frame_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameTimingRecorder);
+};
+
+}  // namespace shell
+}  // namespace sky
+
+#endif  // SKY_SHELL_UI_FRAME_TIMING_H_
@@ -0,0 +1,163 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/shell/ui/frame_timing.h"
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace sky {
+namespace shell {
+namespace {
+
+const int64_t kIntervalMicroseconds = 16000;
+
+base::TimeDelta Micros(int64_t micros) {
+  return base::TimeDelta::FromMicroseconds(micros);
+}
+
+// A frame whose vsync was |vsync_us| after some fixed origin and that took
+// |total_us| from vsync to the end of raster.
+FrameTiming MakeFrame(int64_t vsync_us, int64_t total_us) {
+  FrameTiming timing;
+  timing.vsync_time = base::TimeTicks() + Micros(1000000 + vsync_us);
+  timing.stages[kFrameStageTotal] = Micros(total_us);
+  timing.stages[kFrameStageBuild] = Micros(total_us / 2);
+  return timing;
+}
+
+class FrameTimingRecorderTest : public testing::Test {
+ protected:
+  FrameTimingRecorderTest() {
+    recorder_.set_frame_interval(Micros(kIntervalMicroseconds));
+  }
+
+  FrameTimingRecorder recorder_;
+};
+
+TEST(FrameStageHistogramTest, Percentiles) {
+  FrameStageHistogram histogram;
+  EXPECT_EQ(base::TimeDelta(), histogram.Percentile(50));
+  EXPECT_EQ(base::TimeDelta(), histogram.Max());
+
+  for (int i = 0; i < 9; ++i)
+    histogram.Add(Micros(100));
+  histogram.Add(Micros(5100));
+  EXPECT_EQ(10u, histogram.count());
+  EXPECT_EQ(Micros(250), histogram.Percentile(50));
+  EXPECT_EQ(Micros(250), histogram.Percentile(90));
+  EXPECT_EQ(Micros(5250), histogram.Percentile(99));
+  EXPECT_EQ(Micros(5250), histogram.Max());
+
+  histogram.Remove(Micros(5100));
+  EXPECT_EQ(9u, histogram.count());
+  EXPECT_EQ(Micros(250), histogram.Max());
+}
+
+TEST(FrameStageHistogramTest, ClampsOutOfRangeSamples) {
+  FrameStageHistogram histogram;
+  histogram.Add(Micros(-10));
+  histogram.Add(base::TimeDelta::FromSeconds(10));
+  EXPECT_EQ(Micros(250), histogram.Percentile(50));
+  EXPECT_EQ(Micros(100250), histogram.Max());
+}
+
+TEST_F(FrameTimingRecorderTest, EvictsOldestFrames) {
+  size_t frame_count = FrameTimingRecorder::kMaxFrames + 10;
+  for (size_t i = 0; i < frame_count; ++i) {
+    FrameTiming timing = MakeFrame(i * kIntervalMicroseconds, 10000);
+    timing.frame_number = i + 1;
+    recorder_.AddFrame(timing);
+  }
+
+  EXPECT_EQ(static_cast<int64_t>(frame_count), recorder_.frame_count());
+  EXPECT_EQ(FrameTimingRecorder::kMaxFrames,
+            recorder_.histogram(kFrameStageTotal).count());
+  std::vector<FrameTiming> frames = recorder_.GetRecentFrames();
+  ASSERT_EQ(FrameTimingRecorder::kMaxFrames, frames.size());
+  EXPECT_EQ(11, frames.front().frame_number);
+  EXPECT_EQ(static_cast<int64_t>(frame_count), frames.back().frame_number);
+}
+
+TEST_F(FrameTimingRecorderTest, PipelinedFramesAreNotDropped) {
+  // Each frame takes two intervals from vsync to the end of raster, but with
+  // two frames in flight one is still presented every vsync.
+  for (int i = 0; i < 10; ++i)
+    recorder_.AddFrame(MakeFrame(i * kIntervalMicroseconds, 30000));
+  EXPECT_EQ(0, recorder_.dropped_frame_count());
+}
+
+TEST_F(FrameTimingRecorderTest, CountsGapsBetweenBackToBackFrames) {
+  recorder_.AddFrame(MakeFrame(0, 10000));
+  // Presented at 36ms.
+  recorder_.AddFrame(MakeFrame(kIntervalMicroseconds, 20000));
+  // Started at 32ms, before the previous frame was presented, and presented
+  // at 86ms, so two vsyncs went by without a new frame.
+  recorder_.AddFrame(MakeFrame(2 * kIntervalMicroseconds, 54000));
+  EXPECT_EQ(2, recorder_.dropped_frame_count());
+
+  std::vector<FrameTiming> frames = recorder_.GetRecentFrames();
+  ASSERT_EQ(3u, frames.size());
+  EXPECT_EQ(0, frames[1].dropped_vsync_count);
+  EXPECT_EQ(2, frames[2].dropped_vsync_count);
+}
+
+TEST_F(FrameTimingRecorderTest, IdleTimeIsNotDropped) {
+  recorder_.AddFrame(MakeFrame(0, 10000));
+  // Nothing was requested for a second, then one quick frame.
+  recorder_.AddFrame(MakeFrame(1000000, 10000));
+  EXPECT_EQ(0, recorder_.dropped_frame_count());
+
+  // A slow frame after idle time is measured from its own vsync.
+  recorder_.AddFrame(MakeFrame(2000000, 40000));
+  EXPECT_EQ(1, recorder_.dropped_frame_count());
+}
+
+TEST_F(FrameTimingRecorderTest, WritesJSON) {
+  FrameTiming timing = MakeFrame(0, 10000);
+  timing.frame_number = 1;
+  timing.deferred = true;
+  timing.picture_count = 3;
+  recorder_.AddFrame(timing);
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath path = temp_dir.path().AppendASCII("timings.json");
+  ASSERT_TRUE(FrameTimingRecorder::WriteJSONToFile(path, recorder_.ToJSON()));
+
+  std::string json;
+  ASSERT_TRUE(base::ReadFileToString(path, &json));
+  scoped_ptr<base::Value> value(base::JSONReader::Read(json));
+  base::DictionaryValue* dictionary = nullptr;
+  ASSERT_TRUE(value && value->GetAsDictionary(&dictionary));
+
+  double frame_count = 0;
+  EXPECT_TRUE(dictionary->GetDouble("frame_count", &frame_count));
+  EXPECT_EQ(1, frame_count);
+  double deferred_frame_count = 0;
+  EXPECT_TRUE(
+      dictionary->GetDouble("deferred_frame_count", &deferred_frame_count));
+  EXPECT_EQ(1, deferred_frame_count);
+
+  base::ListValue* frames = nullptr;
+  ASSERT_TRUE(dictionary->GetList("frames", &frames));
+  ASSERT_EQ(1u, frames->GetSize());
+  base::DictionaryValue* frame = nullptr;
+  ASSERT_TRUE(frames->GetDictionary(0, &frame));
+  int picture_count = 0;
+  EXPECT_TRUE(frame->GetInteger("picture_count", &picture_count));
+  EXPECT_EQ(3, picture_count);
+  double total_ms = 0;
+  EXPECT_TRUE(frame->GetDouble("total_ms", &total_ms));
+  EXPECT_DOUBLE_EQ(10, total_ms);
+
+  EXPECT_FALSE(FrameTimingRecorder::WriteJSONToFile(path, std::string()));
+}
+
+}  // namespace
+}  // namespace shell
+}  // namespace sky
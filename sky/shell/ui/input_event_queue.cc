@@ -0,0 +1,79 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/shell/ui/input_event_queue.h"
+
+#include "sky/engine/public/platform/WebInputEvent.h"
+
+namespace sky {
+namespace shell {
+namespace {
+
+// Makes |pending| into |next|, remembering where |pending| was.
+void MergePointerMove(blink::WebPointerEvent* pending,
+                      const blink::WebPointerEvent& next) {
+  blink::WebPointerEvent merged = next;
+  int size = pending->historySize;
+  int first = 0;
+  if (size == blink::WebPointerEvent::kMaxHistorySize) {
+    // Drop the oldest sample to make room.
+    first = 1;
+    --size;
+  }
+  for (int i = 0; i < size; ++i) {
+    merged.historyX[i] = pending->historyX[first + i];
+    merged.historyY[i] = pending->historyY[first + i];
+    merged.historyTimeStampMS[i] = pending->historyTimeStampMS[first + i];
+  }
+  merged.historyX[size] = pending->x;
+  merged.historyY[size] = pending->y;
+  merged.historyTimeStampMS[size] = pending->timeStampMS;
+  merged.historySize = size + 1;
+  *pending = merged;
+}
+
+}  // namespace
+
+const size_t InputEventQueue::kMaxEvents;
+
+InputEventQueue::InputEventQueue() {
+}
+
+InputEventQueue::~InputEventQueue() {
+}
+
+void InputEventQueue::Push(scoped_ptr<blink::WebInputEvent> event) {
+  if (Coalesce(*event))
+    return;
+  events_.push_back(event.Pass());
+}
+
+ScopedVector<blink::WebInputEvent> InputEventQueue::Take() {
+  ScopedVector<blink::WebInputEvent> events;
+  events.swap(events_);
+  return events.Pass();
+}
+
+bool InputEventQueue::Coalesce(const blink::WebInputEvent& event) {
+  if (event.type != blink::WebInputEvent::PointerMove)
+    return false;
+  const blink::WebPointerEvent& move =
+      static_cast<const blink::WebPointerEvent&>(event);
+
+  for (size_t i = events_.size(); i > 0; --i) {
+    blink::WebInputEvent* pending = events_[i - 1];
+    if (pending->type != blink::WebInputEvent::PointerMove)
+      return false;
+    blink::WebPointerEvent* pending_move =
+        static_cast<blink::WebPointerEvent*>(pending);
+    if (pending_move->pointer == move.pointer) {
+      MergePointerMove(pending_move, move);
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace shell
+}  // namespace sky
@@ -0,0 +1,52 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_SHELL_UI_INPUT_EVENT_QUEUE_H_
+#define SKY_SHELL_UI_INPUT_EVENT_QUEUE_H_
+
+#include "base/macros.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+
+namespace blink {
+class WebInputEvent;
+}
+
+namespace sky {
+namespace shell {
+
+// Holds the input events that arrive between frames so that they can be
+// dispatched together right before the next frame. A pointer move replaces
+// the pending move of the same pointer, which it keeps as history, as long as
+// only moves of other pointers came in between.
+class InputEventQueue {
+ public:
+  // Once this many events are pending the owner should dispatch them without
+  // waiting for a frame, so that a stalled frame can't queue input forever.
+  static const size_t kMaxEvents = 128;
+
+  InputEventQueue();
+  ~InputEventQueue();
+
+  bool empty() const { return events_.empty(); }
+  size_t size() const { return events_.size(); }
+  bool full() const { return events_.size() >= kMaxEvents; }
+
+  void Push(scoped_ptr<blink::WebInputEvent> event);
+
+  // Returns the pending events in the order they should be dispatched.
+  ScopedVector<blink::WebInputEvent> Take();
+
+ private:
+  bool Coalesce(const blink::WebInputEvent& event);
+
+  ScopedVector<blink::WebInputEvent> events_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputEventQueue);
+};
+
+}  // namespace shell
+}  // namespace sky
+
+#endif  // SKY_SHELL_UI_INPUT_EVENT_QUEUE_H_
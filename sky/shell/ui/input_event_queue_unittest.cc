@@ -0,0 +1,142 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/shell/ui/input_event_queue.h"
+
+#include "sky/engine/public/platform/WebInputEvent.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace sky {
+namespace shell {
+namespace {
+
+scoped_ptr<blink::WebInputEvent> PointerEvent(blink::WebInputEvent::Type type,
+                                              int pointer,
+                                              float x,
+                                              float y,
+                                              double time_ms) {
+  scoped_ptr<blink::WebPointerEvent> event(new blink::WebPointerEvent);
+  event->type = type;
+  event->pointer = pointer;
+  event->x = x;
+  event->y = y;
+  event->timeStampMS = time_ms;
+  return event.Pass();
+}
+
+scoped_ptr<blink::WebInputEvent> Move(int pointer, float x, double time_ms) {
+  return PointerEvent(blink::WebInputEvent::PointerMove, pointer, x, 0,
+                      time_ms);
+}
+
+const blink::WebPointerEvent& AsPointer(const blink::WebInputEvent* event) {
+  return *static_cast<const blink::WebPointerEvent*>(event);
+}
+
+TEST(InputEventQueueTest, CoalescesMovesOfTheSamePointer) {
+  InputEventQueue queue;
+  queue.Push(Move(1, 10, 100));
+  queue.Push(Move(1, 20, 108));
+  queue.Push(Move(1, 30, 116));
+  ASSERT_EQ(1u, queue.size());
+
+  ScopedVector<blink::WebInputEvent> events = queue.Take();
+  EXPECT_TRUE(queue.empty());
+  ASSERT_EQ(1u, events.size());
+  const blink::WebPointerEvent& move = AsPointer(events[0]);
+  EXPECT_EQ(30, move.x);
+  EXPECT_EQ(116, move.timeStampMS);
+  ASSERT_EQ(2, move.historySize);
+  EXPECT_EQ(10, move.historyX[0]);
+  EXPECT_EQ(100, move.historyTimeStampMS[0]);
+  EXPECT_EQ(20, move.historyX[1]);
+  EXPECT_EQ(108, move.historyTimeStampMS[1]);
+}
+
+TEST(InputEventQueueTest, CoalescesAcrossMovesOfOtherPointers) {
+  InputEventQueue queue;
+  queue.Push(Move(1, 10, 100));
+  queue.Push(Move(2, 50, 101));
+  queue.Push(Move(1, 20, 108));
+  queue.Push(Move(2, 60, 109));
+
+  ScopedVector<blink::WebInputEvent> events = queue.Take();
+  ASSERT_EQ(2u, events.size());
+  EXPECT_EQ(1, AsPointer(events[0]).pointer);
+  EXPECT_EQ(20, AsPointer(events[0]).x);
+  EXPECT_EQ(1, AsPointer(events[0]).historySize);
+  EXPECT_EQ(2, AsPointer(events[1]).pointer);
+  EXPECT_EQ(60, AsPointer(events[1]).x);
+  EXPECT_EQ(1, AsPointer(events[1]).historySize);
+}
+
+TEST(InputEventQueueTest, KeepsTheMostRecentHistory) {
+  InputEventQueue queue;
+  const int kMoves = blink::WebPointerEvent::kMaxHistorySize + 5;
+  for (int i = 0; i < kMoves; ++i)
+    queue.Push(Move(1, i, i));
+
+  ScopedVector<blink::WebInputEvent> events = queue.Take();
+  ASSERT_EQ(1u, events.size());
+  const blink::WebPointerEvent& move = AsPointer(events[0]);
+  EXPECT_EQ(kMoves - 1, move.x);
+  ASSERT_EQ(blink::WebPointerEvent::kMaxHistorySize, move.historySize);
+  for (int i = 0; i < move.historySize; ++i)
+    EXPECT_EQ(kMoves - 1 - move.historySize + i, move.historyX[i]);
+}
+
+TEST(InputEventQueueTest, DownsAndUpsKeepTheirOrder) {
+  InputEventQueue queue;
+  queue.Push(PointerEvent(blink::WebInputEvent::PointerDown, 1, 0, 0, 100));
+  queue.Push(Move(1, 10, 104));
+  queue.Push(Move(1, 20, 108));
+  queue.Push(PointerEvent(blink::WebInputEvent::PointerUp, 1, 20, 0, 112));
+  queue.Push(PointerEvent(blink::WebInputEvent::PointerDown, 1, 0, 0, 116));
+  queue.Push(Move(1, 30, 120));
+
+  ScopedVector<blink::WebInputEvent> events = queue.Take();
+  ASSERT_EQ(4u, events.size());
+  EXPECT_EQ(blink::WebInputEvent::PointerDown, events[0]->type);
+  EXPECT_EQ(blink::WebInputEvent::PointerMove, events[1]->type);
+  EXPECT_EQ(20, AsPointer(events[1]).x);
+  EXPECT_EQ(1, AsPointer(events[1]).historySize);
+  EXPECT_EQ(blink::WebInputEvent::PointerUp, events[2]->type);
+  EXPECT_EQ(blink::WebInputEvent::PointerDown, events[3]->type);
+}
+
+TEST(InputEventQueueTest, MovesAfterADownAreNotMergedIntoMovesBeforeIt) {
+  InputEventQueue queue;
+  queue.Push(Move(1, 10, 100));
+  queue.Push(PointerEvent(blink::WebInputEvent::PointerDown, 2, 0, 0, 104));
+  queue.Push(Move(1, 20, 108));
+
+  ScopedVector<blink::WebInputEvent> events = queue.Take();
+  ASSERT_EQ(3u, events.size());
+  EXPECT_EQ(10, AsPointer(events[0]).x);
+  EXPECT_EQ(blink::WebInputEvent::PointerDown, events[1]->type);
+  EXPECT_EQ(20, AsPointer(events[2]).x);
+  EXPECT_EQ(0, AsPointer(events[2]).historySize);
+}
+
+TEST(InputEventQueueTest, FillsUpAtTheBound) {
+  InputEventQueue queue;
+  for (size_t i = 0; i + 1 < InputEventQueue::kMaxEvents; ++i) {
+    queue.Push(PointerEvent(i % 2 ? blink::WebInputEvent::PointerUp
+                                  : blink::WebInputEvent::PointerDown,
+                            1, 0, 0, i));
+    EXPECT_FALSE(queue.full());
+  }
+  // Coalesced moves don't take up room.
+  queue.Push(Move(1, 10, 1000));
+  queue.Push(Move(1, 20, 1001));
+  EXPECT_TRUE(queue.full());
+  EXPECT_EQ(InputEventQueue::kMaxEvents, queue.size());
+
+  EXPECT_EQ(InputEventQueue::kMaxEvents, queue.Take().size());
+  EXPECT_FALSE(queue.full());
+}
+
+}  // namespace
+}  // namespace shell
+}  // namespace sky
@@ -0,0 +1,203 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/shell/ui/input_event_recorder.h"
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/strings/string_split.h"
+#include "base/values.h"
+
+namespace sky {
+namespace shell {
+namespace {
+
+// Only the fields that the engine reads from an event are recorded.
+
+scoped_ptr<base::DictionaryValue> PointerDataToValue(const PointerData& data) {
+  scoped_ptr<base::DictionaryValue> value(new base::DictionaryValue);
+  value->SetInteger("pointer", data.pointer);
+  value->SetInteger("kind", data.kind);
+  value->SetDouble("x", data.x);
+  value->SetDouble("y", data.y);
+  value->SetInteger("buttons", data.buttons);
+  value->SetDouble("pressure", data.pressure);
+  value->SetDouble("pressure_min", data.pressure_min);
+  value->SetDouble("pressure_max", data.pressure_max);
+  return value.Pass();
+}
+
+scoped_ptr<base::DictionaryValue> GestureDataToValue(const GestureData& data) {
+  scoped_ptr<base::DictionaryValue> value(new base::DictionaryValue);
+  value->SetInteger("primary_pointer", data.primary_pointer);
+  value->SetDouble("x", data.x);
+  value->SetDouble("y", data.y);
+  value->SetDouble("dx", data.dx);
+  value->SetDouble("dy", data.dy);
+  value->SetDouble("velocity_x", data.velocityX);
+  value->SetDouble("velocity_y", data.velocityY);
+  return value.Pass();
+}
+
+bool GetFloat(const base::DictionaryValue& value,
+              const std::string& key,
+              float* out) {
+  double result;
+  if (!value.GetDouble(key, &result))
+    return false;
+  *out = static_cast<float>(result);
+  return true;
+}
+
+PointerDataPtr PointerDataFromValue(const base::DictionaryValue& value) {
+  PointerDataPtr data = PointerData::New();
+  int kind;
+  if (!value.GetInteger("pointer", &data->pointer) ||
+      !value.GetInteger("kind", &kind) ||
+      !GetFloat(value, "x", &data->x) ||
+      !GetFloat(value, "y", &data->y) ||
+      !value.GetInteger("buttons", &data->buttons) ||
+      !GetFloat(value, "pressure", &data->pressure) ||
+      !GetFloat(value, "pressure_min", &data->pressure_min) ||
+      !GetFloat(value, "pressure_max", &data->pressure_max))
+    return PointerDataPtr();
+  data->kind = static_cast<PointerKind>(kind);
+  return data.Pass();
+}
+
+GestureDataPtr GestureDataFromValue(const base::DictionaryValue& value) {
+  GestureDataPtr data = GestureData::New();
+  if (!value.GetInteger("primary_pointer", &data->primary_pointer) ||
+      !GetFloat(value, "x", &data->x) ||
+      !GetFloat(value, "y", &data->y) ||
+      !GetFloat(value, "dx", &data->dx) ||
+      !GetFloat(value, "dy", &data->dy) ||
+      !GetFloat(value, "velocity_x", &data->velocityX) ||
+      !GetFloat(value, "velocity_y", &data->velocityY))
+    return GestureDataPtr();
+  return data.Pass();
+}
+
+void OpenFile(base::File* file, const base::FilePath& path) {
+  file->Initialize(path,
+                   base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  LOG_IF(ERROR, !file->IsValid()) << "Failed to open " << path.value()
+                                  << " to record input.";
+}
+
+void WriteLine(base::File* file, const std::string& line) {
+  if (!file->IsValid())
+    return;
+  if (file->WriteAtCurrentPos(line.data(), line.size()) !=
+      static_cast<int>(line.size()))
+    LOG(ERROR) << "Failed to record input event.";
+}
+
+scoped_ptr<RecordedInputEvent> RecordedInputEventFromValue(
+    const base::DictionaryValue& value) {
+  scoped_ptr<RecordedInputEvent> recorded(new RecordedInputEvent);
+  recorded->event = InputEvent::New();
+
+  double offset_us;
+  int type;
+  double time_stamp;
+  if (!value.GetDouble("offset_us", &offset_us) ||
+      !value.GetInteger("type", &type) ||
+      !value.GetDouble("time_stamp", &time_stamp))
+    return scoped_ptr<RecordedInputEvent>();
+  recorded->offset =
+      base::TimeDelta::FromMicroseconds(static_cast<int64_t>(offset_us));
+  recorded->event->type = static_cast<EventType>(type);
+  recorded->event->time_stamp = time_stamp;
+
+  const base::DictionaryValue* data;
+  if (value.GetDictionary("pointer_data", &data)) {
+    recorded->event->pointer_data = PointerDataFromValue(*data);
+    if (!recorded->event->pointer_data)
+      return scoped_ptr<RecordedInputEvent>();
+  }
+  if (value.GetDictionary("gesture_data", &data)) {
+    recorded->event->gesture_data = GestureDataFromValue(*data);
+    if (!recorded->event->gesture_data)
+      return scoped_ptr<RecordedInputEvent>();
+  }
+  return recorded.Pass();
+}
+
+}  // namespace
+
+InputEventRecorder::InputEventRecorder(const base::FilePath& path)
+    : file_thread_("input_event_recorder"), file_(new base::File) {
+  CHECK(file_thread_.Start());
+  file_thread_.task_runner()->PostTask(
+      FROM_HERE, base::Bind(&OpenFile, base::Unretained(file_.get()), path));
+}
+
+InputEventRecorder::~InputEventRecorder() {
+  // Closing the file is I/O too, so it happens on the file thread, after the
+  // writes still queued there. Stop() waits for all of them.
+  file_thread_.task_runner()->DeleteSoon(FROM_HERE, file_.release());
+  file_thread_.Stop();
+}
+
+void InputEventRecorder::Record(const InputEvent& event) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (start_time_.is_null())
+    start_time_ = now;
+
+  base::DictionaryValue value;
+  value.SetDouble("offset_us", (now - start_time_).InMicroseconds());
+  value.SetInteger("type", event.type);
+  value.SetDouble("time_stamp", event.time_stamp);
+  if (event.pointer_data)
+    value.Set("pointer_data", PointerDataToValue(*event.pointer_data));
+  if (event.gesture_data)
+    value.Set("gesture_data", GestureDataToValue(*event.gesture_data));
+
+  std::string line;
+  base::JSONWriter::Write(value, &line);
+  line += "\n";
+  file_thread_.task_runner()->PostTask(
+      FROM_HERE,
+      base::Bind(&WriteLine, base::Unretained(file_.get()), line));
+}
+
+RecordedInputEvent::RecordedInputEvent() {
+}
+
+RecordedInputEvent::~RecordedInputEvent() {
+}
+
+bool ReadInputEventRecording(const base::FilePath& path,
+                             ScopedVector<RecordedInputEvent>* events) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return false;
+
+  std::vector<std::string> lines;
+  base::SplitString(contents, '\n', &lines);
+  for (const std::string& line : lines) {
+    if (line.empty())
+      continue;
+    scoped_ptr<base::Value> value = base::JSONReader::Read(line);
+    const base::DictionaryValue* dictionary;
+    if (!value || !value->GetAsDictionary(&dictionary))
+      return false;
+    scoped_ptr<RecordedInputEvent> event =
+        RecordedInputEventFromValue(*dictionary);
+    if (!event)
+      return false;
+    events->push_back(event.Pass());
+  }
+  return true;
+}
+
+}  // namespace shell
+}  // namespace sky
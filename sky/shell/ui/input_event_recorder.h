@@ -0,0 +1,57 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SKY_SHELL_UI_INPUT_EVENT_RECORDER_H_
+#define SKY_SHELL_UI_INPUT_EVENT_RECORDER_H_
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "sky/services/engine/input_event.mojom.h"
+
+namespace sky {
+namespace shell {
+
+// Writes the input events the engine receives to a file, one JSON object per
+// line, so that the same input can be replayed later. The file is written on
+// a thread of its own so that recording doesn't block the UI thread on disk.
+class InputEventRecorder {
+ public:
+  explicit InputEventRecorder(const base::FilePath& path);
+  // Finishes writing every event recorded so far.
+  ~InputEventRecorder();
+
+  void Record(const InputEvent& event);
+
+ private:
+  base::Thread file_thread_;
+  // Only used on |file_thread_|.
+  scoped_ptr<base::File> file_;
+  base::TimeTicks start_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputEventRecorder);
+};
+
+struct RecordedInputEvent {
+  RecordedInputEvent();
+  ~RecordedInputEvent();
+
+  // When the event arrived, relative to the first recorded event.
+  base::TimeDelta offset;
+  InputEventPtr event;
+};
+
+// Reads a file written by InputEventRecorder. Returns false if the file can't
+// be read or is malformed.
+bool ReadInputEventRecording(const base::FilePath& path,
+                             ScopedVector<RecordedInputEvent>* events);
+
+}  // namespace shell
+}  // namespace sky
+
+#endif  // SKY_SHELL_UI_INPUT_EVENT_RECORDER_H_
@@ -0,0 +1,58 @@
+// Copyright 2015 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sky/shell/ui/input_event_recorder.h"
+
+#include "base/files/scoped_temp_dir.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace sky {
+namespace shell {
+namespace {
+
+InputEventPtr PointerEvent(EventType type, float x, float y) {
+  InputEventPtr event = InputEvent::New();
+  event->type = type;
+  event->time_stamp = 1000;
+  event->pointer_data = PointerData::New();
+  event->pointer_data->pointer = 3;
+  event->pointer_data->kind = POINTER_KIND_TOUCH;
+  event->pointer_data->x = x;
+  event->pointer_data->y = y;
+  event->pointer_data->pressure = 1.0f;
+  return event.Pass();
+}
+
+TEST(InputEventRecorderTest, WritesEveryEventBeforeItIsDestroyed) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath path = temp_dir.path().Append("input.json");
+
+  const int kEventCount = 100;
+  {
+    InputEventRecorder recorder(path);
+    recorder.Record(*PointerEvent(EVENT_TYPE_POINTER_DOWN, 0, 0));
+    for (int i = 1; i + 1 < kEventCount; ++i)
+      recorder.Record(*PointerEvent(EVENT_TYPE_POINTER_MOVE, i, 2 * i));
+    recorder.Record(*PointerEvent(EVENT_TYPE_POINTER_UP, 0, 0));
+  }
+
+  ScopedVector<RecordedInputEvent> events;
+  ASSERT_TRUE(ReadInputEventRecording(path, &events));
+  ASSERT_EQ(static_cast<size_t>(kEventCount), events.size());
+  EXPECT_EQ(EVENT_TYPE_POINTER_DOWN, events[0]->event->type);
+  EXPECT_EQ(EVENT_TYPE_POINTER_UP, events[kEventCount - 1]->event->type);
+  for (int i = 1; i + 1 < kEventCount; ++i) {
+    const InputEvent& event = *events[i]->event;
+    EXPECT_EQ(EVENT_TYPE_POINTER_MOVE, event.type);
+    EXPECT_EQ(3, event.pointer_data->pointer);
+    EXPECT_EQ(i, event.pointer_data->x);
+    EXPECT_EQ(2 * i, event.pointer_data->y);
+    EXPECT_LE(events[i - 1]->offset, events[i]->offset);
+  }
+}
+
+}  // namespace
+}  // namespace shell
+}  // namespace sky
@@ -3,6 +3,7 @@ import "../resources/third_party/unittest/unittest.dart";
 import "../resources/unit.dart";
 
 import "dart:sky";
+import "dart:typed_data";
 import 'package:vector_math/vector_math.dart';
 
 void main() {
@@ -23,4 +24,28 @@ void main() {
     expect(canvas.getTotalMatrix(), equals(matrix.storage));
   });
 
+  test("drawRawAtlas should convert every argument", () {
+    Paint paint = new Paint();
+    Float32List transforms = new Float32List.fromList([1.0, 0.0, 10.0, 10.0]);
+    Float32List rects = new Float32List.fromList([0.0, 0.0, 8.0, 8.0]);
+    Int32List colors = new Int32List.fromList([0xFF00FF00]);
+    Rect cullRect = new Rect.fromLTRB(0.0, 0.0, 50.0, 50.0);
+    canvas.drawRawAtlas(new Image(), TransferMode.modulate, cullRect, paint,
+                        transforms, rects, colors);
+    canvas.drawRawAtlas(new Image(), TransferMode.srcOver, null, paint,
+                        transforms, rects, null);
+    expect(() {
+      canvas.drawRawAtlas(new Image(), TransferMode.modulate, cullRect, paint,
+                          transforms, new Float32List(8), colors);
+    }, throws);
+  });
+
+  test("drawPoints should convert every argument", () {
+    Paint paint = new Paint()..strokeWidth = 2.0;
+    canvas.drawPoints(PointMode.lines, paint,
+                      new Float32List.fromList([0.0, 0.0, 10.0, 10.0]));
+    expect(() {
+      canvas.drawPoints(PointMode.points, paint, new Float32List(3));
+    }, throws);
+  });
 }